@@ -0,0 +1,99 @@
+/*
+ * Offline throughput: renders the same set of jobs with one ReverbEngine
+ * per job in turn, then with the BatchRenderer at 4, 8 and 16 lanes, all on
+ * one thread. Reports seconds of audio printed per second of wall time.
+ *
+ * Usage: Aura_BatchBenchmark [jobs=64] [seconds per job=10]
+ */
+
+#include "../Source/DSP/BatchRenderer.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+
+    std::vector<Aura::RenderJob> makeJobs(int numJobs, int numSamples)
+    {
+        std::vector<Aura::RenderJob> jobs(static_cast<size_t>(numJobs));
+        juce::Random random(2024);
+
+        for (auto& job : jobs)
+        {
+            job.input.setSize(2, numSamples);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < numSamples; ++i)
+                    job.input.setSample(ch, i, random.nextFloat() * 0.5f - 0.25f);
+
+            job.settings.size = random.nextFloat() * 100.0f;
+            job.settings.decay = 0.5f + random.nextFloat() * 6.0f;
+            job.settings.damping = random.nextFloat() * 100.0f;
+            job.settings.preDelay = random.nextFloat() * 100.0f;
+            job.tailSamples = static_cast<int>(sampleRate * 2.0);
+        }
+
+        return jobs;
+    }
+
+    template <typename Function>
+    double secondsFor(Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int numJobs = argc > 1 ? std::atoi(argv[1]) : 64;
+    const double secondsPerJob = argc > 2 ? std::atof(argv[2]) : 10.0;
+    const int numSamples = static_cast<int>(secondsPerJob * sampleRate);
+
+    auto jobs = makeJobs(numJobs, numSamples);
+
+    double audioSeconds = 0.0;
+    for (const auto& job : jobs)
+        audioSeconds += (job.input.getNumSamples() + job.tailSamples) / sampleRate;
+
+    std::printf("%d jobs, %.0f s of audio, kernels: %s\n", numJobs, audioSeconds, Aura::Kernels::get().name);
+
+    const double serial = secondsFor([&]
+    {
+        for (auto& job : jobs)
+        {
+            const int length = job.input.getNumSamples() + job.tailSamples;
+            job.output.setSize(2, length);
+            job.output.clear();
+            for (int ch = 0; ch < 2; ++ch)
+                job.output.copyFrom(ch, 0, job.input, ch, 0, job.input.getNumSamples());
+
+            Aura::ReverbEngine engine;
+            engine.prepare(sampleRate, Aura::BatchRenderer::blockSize);
+            engine.apply(job.settings);
+
+            for (int start = 0; start < length; start += Aura::BatchRenderer::blockSize)
+            {
+                juce::AudioBuffer<float> block(job.output.getArrayOfWritePointers(), 2, start,
+                                               juce::jmin(Aura::BatchRenderer::blockSize, length - start));
+                engine.process(block);
+            }
+        }
+    });
+
+    std::printf("serial     %8.1fx realtime\n", audioSeconds / serial);
+
+    for (int lanes : { 4, 8, 16 })
+    {
+        Aura::BatchRenderer renderer(sampleRate, lanes);
+        const double batched = secondsFor([&] { renderer.render(jobs); });
+        std::printf("%2d lanes   %8.1fx realtime   %5.2fx serial\n",
+                    lanes, audioSeconds / batched, serial / batched);
+    }
+
+    return 0;
+}
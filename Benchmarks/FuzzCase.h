@@ -0,0 +1,276 @@
+/*
+ * One processBlock fuzz case: a sample rate, a full parameter set and a run
+ * of host callbacks with their block sizes, input signals and automation,
+ * decoded from raw bytes. Shared by the fuzzer, which searches for the
+ * slowest and least stable cases, and the reproducer benchmark, which
+ * replays the ones it found.
+ *
+ * Byte layout (every byte sequence decodes to some case):
+ *
+ *   [0]      sample rate, index into sampleRates
+ *   [1]      flags: bit 0 mono input into a stereo output
+ *   [2..]    one byte for each of the first numParameters ParamIDs::stateOrder
+ *            entries, the normalised value * 255. The count is fixed, so old
+ *            reproducers keep their meaning as parameters are appended.
+ *   then blocks of 4 or 5 bytes until the data or the audio budget runs out:
+ *            size code   0-127: 1-128 samples, 128-255: one of the large sizes
+ *            signal      bits 0-2 kind, bits 3-7 attenuation in 6 dB steps
+ *            repeats     the block is sent repeats + 1 times
+ *            automation  bit 7 set: processor parameter (low bits) moves to the next byte / 255
+ */
+
+#pragma once
+
+#include "../Source/PluginProcessor.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace Aura
+{
+namespace Fuzz
+{
+
+inline constexpr double sampleRates[] = { 44100.0, 48000.0, 88200.0, 96000.0, 176400.0, 192000.0 };
+inline constexpr int largeBlockSizes[] = { 256, 441, 480, 512, 513, 1024, 2048, 4096 };
+inline constexpr int maxBlockSize = 4096;
+inline constexpr int announcedBlockSize = 512;
+
+// stateOrder up to adaptiveQuality; later parameters such as bypass keep
+// their defaults unless a block automates them
+inline constexpr int numParameters = 25;
+
+// Keeps a case short enough for many runs per second
+inline constexpr double maxCaseSeconds = 0.5;
+
+enum class Signal
+{
+    Silence = 0,
+    Impulse,        // at the start of the block
+    Noise,
+    DC,
+    Nyquist,        // alternating +/- full scale
+    Subnormal,      // noise around 1e-39, as some hosts send after a fade
+    Hot,            // noise at +12 dBFS
+    Sine,           // 997 Hz, continuous across blocks
+    NumSignals
+};
+
+struct Block
+{
+    uint8_t sizeCode = 0;
+    uint8_t signal = 0;
+    uint8_t repeats = 0;
+    bool automate = false;
+    uint8_t parameter = 0;
+    uint8_t value = 0;
+
+    int getNumSamples() const
+    {
+        return sizeCode < 128 ? sizeCode + 1 : largeBlockSizes[(sizeCode - 128) % std::size(largeBlockSizes)];
+    }
+};
+
+struct Case
+{
+    uint8_t sampleRateIndex = 0;
+    uint8_t flags = 0;
+    std::vector<uint8_t> parameters;
+    std::vector<Block> blocks;
+
+    double getSampleRate() const { return sampleRates[sampleRateIndex % std::size(sampleRates)]; }
+    bool isMonoInput() const { return (flags & 1) != 0; }
+
+    static Case decode(const uint8_t* data, size_t size)
+    {
+        Case c;
+        size_t pos = 0;
+        auto next = [&]() -> uint8_t { return pos < size ? data[pos++] : 0; };
+
+        c.sampleRateIndex = next();
+        c.flags = next();
+
+        for (int i = 0; i < numParameters; ++i)
+            c.parameters.push_back(next());
+
+        while (pos < size)
+        {
+            Block block;
+            block.sizeCode = next();
+            block.signal = next();
+            block.repeats = next();
+
+            const uint8_t automation = next();
+            block.automate = (automation & 0x80) != 0;
+            if (block.automate)
+            {
+                block.parameter = automation & 0x7f;
+                block.value = next();
+            }
+
+            c.blocks.push_back(block);
+        }
+
+        return c;
+    }
+
+    std::vector<uint8_t> encode() const
+    {
+        std::vector<uint8_t> data { sampleRateIndex, flags };
+        data.insert(data.end(), parameters.begin(), parameters.end());
+
+        for (const auto& block : blocks)
+        {
+            data.push_back(block.sizeCode);
+            data.push_back(block.signal);
+            data.push_back(block.repeats);
+            data.push_back(block.automate ? static_cast<uint8_t>(0x80 | (block.parameter & 0x7f)) : 0);
+            if (block.automate)
+                data.push_back(block.value);
+        }
+
+        return data;
+    }
+};
+
+struct Result
+{
+    double processSeconds = 0.0;    // inside processBlock, summed
+    double audioSeconds = 0.0;
+    double worstCallbackLoad = 0.0; // slowest callback against its deadline
+    int numCallbacks = 0;
+    int nonFiniteSamples = 0;
+    int subnormalSamples = 0;
+
+    // Average share of real time spent processing; the fuzzer's objective
+    double getLoad() const { return audioSeconds > 0.0 ? processSeconds / audioSeconds : 0.0; }
+    bool isUnstable() const { return nonFiniteSamples > 0 || subnormalSamples > 0; }
+};
+
+//==============================================================================
+inline void fillSignal(juce::AudioBuffer<float>& buffer, int numSamples, uint8_t code,
+                       juce::Random& random, double& sinePhase, double sampleRate)
+{
+    const auto kind = static_cast<Signal>((code & 7) % static_cast<int>(Signal::NumSignals));
+    const float gain = std::pow(0.5f, static_cast<float>(code >> 3));
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        auto* data = buffer.getWritePointer(ch);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            switch (kind)
+            {
+                case Signal::Impulse:   data[i] = i == 0 ? gain : 0.0f; break;
+                case Signal::Noise:     data[i] = (random.nextFloat() * 2.0f - 1.0f) * gain; break;
+                case Signal::DC:        data[i] = gain; break;
+                case Signal::Nyquist:   data[i] = (i % 2 == 0 ? 1.0f : -1.0f) * gain; break;
+                case Signal::Subnormal: data[i] = (random.nextFloat() * 2.0f - 1.0f) * 1.0e-39f; break;
+                case Signal::Hot:       data[i] = (random.nextFloat() * 2.0f - 1.0f) * 4.0f; break;
+                case Signal::Sine:
+                    data[i] = static_cast<float>(std::sin(sinePhase + juce::MathConstants<double>::twoPi * 997.0 * i / sampleRate)) * gain;
+                    break;
+                case Signal::Silence:
+                case Signal::NumSignals:
+                default:                data[i] = 0.0f; break;
+            }
+        }
+    }
+
+    sinePhase += juce::MathConstants<double>::twoPi * 997.0 * numSamples / sampleRate;
+}
+
+// Renders a case on a fresh processor. The processor runs as an offline
+// render, so the CPU governor never hides the cost being measured.
+inline Result run(const Case& c)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const double sampleRate = c.getSampleRate();
+    const int numInputs = c.isMonoInput() ? 1 : 2;
+
+    AuraProcessor processor;
+    processor.setNonRealtime(true);
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(numInputs == 1 ? juce::AudioChannelSet::mono() : juce::AudioChannelSet::stereo());
+    layout.outputBuses.add(juce::AudioChannelSet::stereo());
+    processor.setBusesLayout(layout);
+
+    for (size_t i = 0; i < c.parameters.size() && i < static_cast<size_t>(numParameters); ++i)
+        if (auto* param = processor.getAPVTS().getParameter(ParamIDs::stateOrder[static_cast<int>(i)]))
+            param->setValueNotifyingHost(static_cast<float>(c.parameters[i]) / 255.0f);
+
+    processor.setPlayConfigDetails(numInputs, 2, sampleRate, announcedBlockSize);
+    processor.prepareToPlay(sampleRate, announcedBlockSize);
+
+    juce::AudioBuffer<float> buffer(2, maxBlockSize);
+    juce::MidiBuffer midi;
+    juce::Random random(0x46555a5a);
+    double sinePhase = 0.0;
+
+    Result result;
+    const auto budget = static_cast<int64_t>(maxCaseSeconds * sampleRate);
+    int64_t rendered = 0;
+
+    for (const auto& block : c.blocks)
+    {
+        if (block.automate)
+        {
+            // On the audio thread, as host automation arrives
+            auto& params = processor.getParameters();
+            params[block.parameter % params.size()]->setValue(static_cast<float>(block.value) / 255.0f);
+        }
+
+        const int numSamples = block.getNumSamples();
+
+        for (int r = 0; r <= block.repeats && rendered < budget; ++r)
+        {
+            juce::AudioBuffer<float> io(buffer.getArrayOfWritePointers(), 2, 0, numSamples);
+            fillSignal(io, numSamples, block.signal, random, sinePhase, sampleRate);
+
+            const auto start = Clock::now();
+            processor.processBlock(io, midi);
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+            const double deadline = numSamples / sampleRate;
+            result.processSeconds += seconds;
+            result.audioSeconds += deadline;
+            result.worstCallbackLoad = juce::jmax(result.worstCallbackLoad, seconds / deadline);
+            ++result.numCallbacks;
+            rendered += numSamples;
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    const auto kind = std::fpclassify(io.getSample(ch, i));
+                    result.nonFiniteSamples += (kind == FP_NAN || kind == FP_INFINITE) ? 1 : 0;
+                    result.subnormalSamples += kind == FP_SUBNORMAL ? 1 : 0;
+                }
+            }
+        }
+
+        if (rendered >= budget)
+            break;
+    }
+
+    return result;
+}
+
+// One line per case, for reports
+inline juce::String describe(const Case& c, const Result& result)
+{
+    return juce::String(c.getSampleRate() / 1000.0, 1) + " kHz" + (c.isMonoInput() ? " mono" : "")
+         + ", " + juce::String(result.numCallbacks) + " callbacks"
+         + ", load " + juce::String(result.getLoad() * 100.0, 1) + "%"
+         + ", worst callback " + juce::String(result.worstCallbackLoad * 100.0, 1) + "%"
+         + (result.nonFiniteSamples > 0 ? ", " + juce::String(result.nonFiniteSamples) + " NaN/Inf" : juce::String())
+         + (result.subnormalSamples > 0 ? ", " + juce::String(result.subnormalSamples) + " subnormal" : juce::String());
+}
+
+} // namespace Fuzz
+} // namespace Aura
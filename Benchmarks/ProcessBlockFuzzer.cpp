@@ -0,0 +1,321 @@
+/*
+ * Searches for the processBlock inputs that cost the most CPU or break the
+ * output (NaN, Inf or subnormal samples). See FuzzCase.h for what a case is.
+ *
+ * Built with -DAURA_LIBFUZZER=ON (Clang) this is a libFuzzer target:
+ *
+ *   Aura_Fuzzer -max_len=4096 corpus/ Benchmarks/Reproducers/
+ *
+ * Unstable output aborts, so libFuzzer saves the input (minimise it with
+ * -minimize_crash=1). libFuzzer has no notion of slow, so every doubling of
+ * the load gets its own extra coverage counter, which makes a slower input
+ * look like new coverage and keeps it in the corpus. With
+ * AURA_FUZZ_REPRODUCERS set to a directory, each new slowest input is
+ * written there too.
+ *
+ * Built without libFuzzer it runs its own search, a seeded mutation hill
+ * climb, and writes minimised reproducers to the output directory:
+ *
+ *   Aura_Fuzzer [iterations=2000] [output=fuzz-findings] [seed=1]
+ *   Aura_Fuzzer --minimise <case.bin> [output=fuzz-findings]
+ *
+ * Copy the reproducers worth keeping to Benchmarks/Reproducers, where
+ * Aura_ReproducerBenchmark replays them.
+ */
+
+#include "FuzzCase.h"
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    using namespace Aura::Fuzz;
+
+    bool writeCase(const Case& c, const juce::File& file)
+    {
+        const auto data = c.encode();
+        file.getParentDirectory().createDirectory();
+        return file.replaceWithData(data.data(), data.size());
+    }
+
+#if AURA_LIBFUZZER
+#if defined(__linux__)
+    // Extra feedback for libFuzzer, one counter per load bucket
+    __attribute__((section("__libfuzzer_extra_counters"))) uint8_t loadCounters[24];
+
+    void markLoad(double load)
+    {
+        const int bucket = juce::jlimit(0, static_cast<int>(std::size(loadCounters)) - 1,
+                                        static_cast<int>(std::log2(juce::jmax(load, 1.0e-6) * 1.0e4)));
+        loadCounters[bucket] = 1;
+    }
+#else
+    void markLoad(double) {}
+#endif
+
+    double slowestLoad = 0.0;
+#else
+    //==========================================================================
+    // Cheap timing noise can look like a slower case, so a candidate is
+    // judged by the faster of two runs
+    Result measure(const Case& c)
+    {
+        auto first = run(c);
+        auto second = run(c);
+        return first.processSeconds <= second.processSeconds ? first : second;
+    }
+
+    std::vector<uint8_t> getDefaultParameters()
+    {
+        Aura::AuraProcessor processor;
+        std::vector<uint8_t> bytes;
+
+        for (int i = 0; i < numParameters; ++i)
+        {
+            auto* param = processor.getAPVTS().getParameter(Aura::ParamIDs::stateOrder[i]);
+            bytes.push_back(static_cast<uint8_t>(juce::roundToInt(param->getDefaultValue() * 255.0f)));
+        }
+
+        return bytes;
+    }
+
+    // Greedily drops everything the finding doesn't need: whole blocks,
+    // repeats, automation, and parameters that can go back to their defaults
+    template <typename StillFails>
+    Case minimise(Case c, StillFails&& stillFails)
+    {
+        for (size_t i = c.blocks.size(); i-- > 0;)
+        {
+            auto candidate = c;
+            candidate.blocks.erase(candidate.blocks.begin() + static_cast<std::ptrdiff_t>(i));
+            if (!candidate.blocks.empty() && stillFails(candidate))
+                c = candidate;
+        }
+
+        for (size_t i = 0; i < c.blocks.size(); ++i)
+        {
+            for (auto edit : { 0, 1 })
+            {
+                auto candidate = c;
+                auto& block = candidate.blocks[i];
+                if (edit == 0 && block.automate)
+                    block.automate = false;
+                else if (edit == 1 && block.repeats > 0)
+                    block.repeats = static_cast<uint8_t>(block.repeats / 2);
+                else
+                    continue;
+
+                if (stillFails(candidate))
+                    c = candidate;
+            }
+        }
+
+        const auto defaults = getDefaultParameters();
+
+        for (size_t i = 0; i < c.parameters.size() && i < defaults.size(); ++i)
+        {
+            auto candidate = c;
+            candidate.parameters[i] = defaults[i];
+            if (candidate.parameters[i] != c.parameters[i] && stillFails(candidate))
+                c = candidate;
+        }
+
+        return c;
+    }
+
+    Case minimiseFinding(const Case& c, const Result& result)
+    {
+        if (result.isUnstable())
+            return minimise(c, [](const Case& candidate) { return run(candidate).isUnstable(); });
+
+        const double target = 0.9 * result.getLoad();
+        return minimise(c, [target](const Case& candidate) { return measure(candidate).getLoad() >= target; });
+    }
+
+    //==========================================================================
+    Case randomCase(juce::Random& random)
+    {
+        Case c;
+        c.sampleRateIndex = static_cast<uint8_t>(random.nextInt(256));
+        c.flags = static_cast<uint8_t>(random.nextInt(256));
+
+        for (int i = 0; i < numParameters; ++i)
+            c.parameters.push_back(static_cast<uint8_t>(random.nextInt(256)));
+
+        for (int i = 1 + random.nextInt(8); i > 0; --i)
+        {
+            Block block;
+            block.sizeCode = static_cast<uint8_t>(random.nextInt(256));
+            block.signal = static_cast<uint8_t>(random.nextInt(256));
+            block.repeats = static_cast<uint8_t>(random.nextInt(256));
+            c.blocks.push_back(block);
+        }
+
+        return c;
+    }
+
+    // Pathological settings sit at the ends of the ranges, so mutations
+    // favour extremes over arbitrary values
+    uint8_t mutateByte(juce::Random& random, uint8_t value)
+    {
+        switch (random.nextInt(4))
+        {
+            case 0:  return 0;
+            case 1:  return 255;
+            case 2:  return static_cast<uint8_t>(value + random.nextInt(17) - 8);
+            default: return static_cast<uint8_t>(random.nextInt(256));
+        }
+    }
+
+    Case mutate(Case c, juce::Random& random)
+    {
+        for (int edits = 1 + random.nextInt(3); edits > 0; --edits)
+        {
+            switch (random.nextInt(6))
+            {
+                case 0:
+                    c.sampleRateIndex = static_cast<uint8_t>(random.nextInt(256));
+                    break;
+                case 1:
+                    c.flags ^= 1;
+                    break;
+                case 2:
+                {
+                    auto& value = c.parameters[static_cast<size_t>(random.nextInt(static_cast<int>(c.parameters.size())))];
+                    value = mutateByte(random, value);
+                    break;
+                }
+                case 3:
+                {
+                    Block block = c.blocks[static_cast<size_t>(random.nextInt(static_cast<int>(c.blocks.size())))];
+                    block.automate = random.nextBool();
+                    block.parameter = static_cast<uint8_t>(random.nextInt(128));
+                    block.value = mutateByte(random, block.value);
+                    c.blocks.push_back(block);
+                    break;
+                }
+                case 4:
+                    if (c.blocks.size() > 1)
+                        c.blocks.erase(c.blocks.begin() + random.nextInt(static_cast<int>(c.blocks.size())));
+                    break;
+                default:
+                {
+                    auto& block = c.blocks[static_cast<size_t>(random.nextInt(static_cast<int>(c.blocks.size())))];
+                    block.sizeCode = random.nextBool() ? mutateByte(random, block.sizeCode) : block.sizeCode;
+                    block.signal = random.nextBool() ? static_cast<uint8_t>(random.nextInt(256)) : block.signal;
+                    block.repeats = mutateByte(random, block.repeats);
+                    break;
+                }
+            }
+        }
+
+        return c;
+    }
+
+    int search(int iterations, const juce::File& output, juce::int64 seed)
+    {
+        juce::Random random(seed);
+        auto best = randomCase(random);
+        auto bestResult = measure(best);
+        int numUnstable = 0;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto candidate = mutate(best, random);
+            auto result = measure(candidate);
+
+            if (result.isUnstable())
+            {
+                const auto minimised = minimiseFinding(candidate, result);
+                const auto file = output.getChildFile("unstable-" + juce::String(++numUnstable) + ".bin");
+                writeCase(minimised, file);
+                std::printf("unstable: %s -> %s\n", describe(minimised, run(minimised)).toRawUTF8(),
+                            file.getFullPathName().toRawUTF8());
+                continue;
+            }
+
+            if (result.getLoad() > bestResult.getLoad())
+            {
+                best = candidate;
+                bestResult = result;
+                std::printf("%6d  %s\n", i, describe(best, bestResult).toRawUTF8());
+                std::fflush(stdout);
+            }
+        }
+
+        const auto minimised = minimiseFinding(best, bestResult);
+        const auto file = output.getChildFile("slowest.bin");
+        writeCase(minimised, file);
+        std::printf("slowest: %s -> %s\n", describe(minimised, measure(minimised)).toRawUTF8(),
+                    file.getFullPathName().toRawUTF8());
+
+        return numUnstable > 0 ? 1 : 0;
+    }
+#endif
+}
+
+#if AURA_LIBFUZZER
+extern "C" int LLVMFuzzerInitialize(int*, char***)
+{
+    static juce::ScopedJuceInitialiser_GUI juceInit;
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    const auto c = Case::decode(data, size);
+    if (c.blocks.empty())
+        return 0;
+
+    const auto result = run(c);
+
+    if (result.isUnstable())
+    {
+        std::fprintf(stderr, "unstable output: %s\n", describe(c, result).toRawUTF8());
+        std::abort();
+    }
+
+    markLoad(result.getLoad());
+
+    if (result.getLoad() > slowestLoad * 1.1)
+    {
+        slowestLoad = result.getLoad();
+
+        if (const char* directory = std::getenv("AURA_FUZZ_REPRODUCERS"))
+            writeCase(c, juce::File(directory).getChildFile("slow-" + juce::String(juce::roundToInt(slowestLoad * 1000.0)) + ".bin"));
+    }
+
+    return 0;
+}
+#else
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    if (argc > 2 && juce::String(argv[1]) == "--minimise")
+    {
+        const auto input = juce::File::getCurrentWorkingDirectory().getChildFile(argv[2]);
+        juce::MemoryBlock data;
+        if (!input.loadFileAsData(data))
+        {
+            std::fprintf(stderr, "can't read %s\n", argv[2]);
+            return 2;
+        }
+
+        const auto c = Case::decode(static_cast<const uint8_t*>(data.getData()), data.getSize());
+        const auto minimised = minimiseFinding(c, measure(c));
+        const auto output = juce::File::getCurrentWorkingDirectory().getChildFile(argc > 3 ? argv[3] : "fuzz-findings");
+        const auto file = output.getChildFile(input.getFileNameWithoutExtension() + "-min.bin");
+
+        writeCase(minimised, file);
+        std::printf("%s -> %s\n", describe(minimised, measure(minimised)).toRawUTF8(), file.getFullPathName().toRawUTF8());
+        return 0;
+    }
+
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const auto output = juce::File::getCurrentWorkingDirectory().getChildFile(argc > 2 ? argv[2] : "fuzz-findings");
+    const juce::int64 seed = argc > 3 ? std::atoll(argv[3]) : 1;
+
+    return search(iterations, output, seed);
+}
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Replays the fuzz reproducers (see ProcessBlockFuzzer.cpp) as regression
+ * benchmarks. Each case is rendered a few times and the fastest run is
+ * reported, so a slower build shows up as a higher load on the same case.
+ *
+ * Usage: Aura_ReproducerBenchmark [case.bin | directory ...]
+ *
+ * Defaults to Benchmarks/Reproducers. Exits non-zero if any case produces
+ * NaN, Inf or subnormal output.
+ */
+
+#include "FuzzCase.h"
+#include <cstdio>
+
+namespace
+{
+    constexpr int runsPerCase = 3;
+
+    juce::Array<juce::File> findCases(int argc, char* argv[])
+    {
+        juce::StringArray paths;
+        for (int i = 1; i < argc; ++i)
+            paths.add(argv[i]);
+
+        if (paths.isEmpty())
+            paths.add(AURA_REPRODUCER_DIR);
+
+        juce::Array<juce::File> cases;
+
+        for (const auto& path : paths)
+        {
+            const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(path);
+
+            if (file.isDirectory())
+                cases.addArray(file.findChildFiles(juce::File::findFiles, false, "*.bin"));
+            else if (file.existsAsFile())
+                cases.add(file);
+        }
+
+        cases.sort();
+        return cases;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    using namespace Aura::Fuzz;
+
+    const auto cases = findCases(argc, argv);
+    if (cases.isEmpty())
+    {
+        std::fprintf(stderr, "no reproducers found\n");
+        return 2;
+    }
+
+    std::printf("%-40s %10s %10s %14s %10s\n", "case", "callbacks", "load", "worst callback", "unstable");
+
+    int numUnstable = 0;
+
+    for (const auto& file : cases)
+    {
+        juce::MemoryBlock data;
+        file.loadFileAsData(data);
+        const auto c = Case::decode(static_cast<const uint8_t*>(data.getData()), data.getSize());
+
+        Result best;
+        for (int run = 0; run < runsPerCase; ++run)
+        {
+            const auto result = Aura::Fuzz::run(c);
+            if (run == 0 || result.processSeconds < best.processSeconds)
+                best = result;
+        }
+
+        numUnstable += best.isUnstable() ? 1 : 0;
+
+        std::printf("%-40s %10d %9.1f%% %13.1f%% %10d\n",
+                    file.getFileNameWithoutExtension().toRawUTF8(), best.numCallbacks,
+                    best.getLoad() * 100.0, best.worstCallbackLoad * 100.0,
+                    best.nonFiniteSamples + best.subnormalSamples);
+    }
+
+    return numUnstable > 0 ? 1 : 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * Times creating a processor: construction alone, construction plus
+ * prepareToPlay, and a session load that also restores a saved state.
+ * Plugin scans and large sessions create hundreds of instances, so every
+ * microsecond here is paid many times over before any audio plays.
+ */
+
+#include "../Source/PluginProcessor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    constexpr int iterations = 200;
+    constexpr int sessionSize = 100;    // instances alive at once, like a large session
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+
+    struct Timing
+    {
+        double mean = 0.0;
+        double worst = 0.0;
+    };
+
+    // Times each call on its own, so one slow instance shows up as the worst case
+    template <typename Function>
+    Timing microsecondsPerInstance(Function&& function)
+    {
+        Timing timing;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            function();
+            const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+            timing.mean += elapsed.count() / iterations;
+            timing.worst = std::max(timing.worst, elapsed.count());
+        }
+
+        return timing;
+    }
+
+    void report(const char* name, Timing timing)
+    {
+        std::printf("%-20s mean %9.1f us   worst %9.1f us\n", name, timing.mean, timing.worst);
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    // A saved state away from the defaults, as a session would restore
+    juce::MemoryBlock state;
+    {
+        Aura::AuraProcessor source;
+        source.getPresetManager().loadFactoryPreset(source.getPresetManager().getNumFactoryPresets() - 1);
+        source.getStateInformation(state);
+    }
+
+    report("construct", microsecondsPerInstance([] { Aura::AuraProcessor processor; }));
+
+    report("construct+prepare", microsecondsPerInstance([]
+    {
+        Aura::AuraProcessor processor;
+        processor.prepareToPlay(sampleRate, blockSize);
+    }));
+
+    report("session load", microsecondsPerInstance([&state]
+    {
+        Aura::AuraProcessor processor;
+        processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        processor.prepareToPlay(sampleRate, blockSize);
+    }));
+
+    // Instances that stay alive, so allocator growth is part of the cost
+    std::vector<std::unique_ptr<Aura::AuraProcessor>> session;
+    session.reserve(sessionSize);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < sessionSize; ++i)
+    {
+        session.push_back(std::make_unique<Aura::AuraProcessor>());
+        session.back()->setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        session.back()->prepareToPlay(sampleRate, blockSize);
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf("%d-instance session  %9.1f ms\n", sessionSize, elapsed.count());
+
+    return 0;
+}
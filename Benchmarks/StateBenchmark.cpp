@@ -0,0 +1,69 @@
+/*
+ * Times getStateInformation/setStateInformation against the XML path it
+ * replaced. Hosts call these for every instance on autosave, so both the
+ * per-call time and the size of the blob matter.
+ */
+
+#include "../Source/PluginProcessor.h"
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+    constexpr int iterations = 20000;
+
+    template <typename Function>
+    double microsecondsPerCall(Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i)
+            function();
+
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count() / iterations;
+    }
+
+    void report(const char* name, double xml, double binary)
+    {
+        std::printf("%-8s xml %8.2f us   binary %8.2f us   %6.1fx\n", name, xml, binary, xml / binary);
+    }
+}
+
+int main()
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    Aura::AuraProcessor processor;
+    auto& apvts = processor.getAPVTS();
+
+    // The legacy format, as written by earlier versions
+    juce::MemoryBlock xmlState;
+    auto saveXml = [&]
+    {
+        xmlState.reset();
+        std::unique_ptr<juce::XmlElement> xml(apvts.copyState().createXml());
+        juce::AudioProcessor::copyXmlToBinary(*xml, xmlState);
+    };
+    auto loadXml = [&]
+    {
+        std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(xmlState.getData(),
+                                                                                    static_cast<int>(xmlState.getSize())));
+        apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    };
+
+    juce::MemoryBlock binaryState;
+    auto saveBinary = [&] { processor.getStateInformation(binaryState); };
+    auto loadBinary = [&]
+    {
+        processor.setStateInformation(binaryState.getData(), static_cast<int>(binaryState.getSize()));
+    };
+
+    saveXml();
+    saveBinary();
+
+    std::printf("size     xml %8d B    binary %8d B\n",
+                static_cast<int>(xmlState.getSize()), static_cast<int>(binaryState.getSize()));
+    report("save", microsecondsPerCall(saveXml), microsecondsPerCall(saveBinary));
+    report("load", microsecondsPerCall(loadXml), microsecondsPerCall(loadBinary));
+
+    return 0;
+}
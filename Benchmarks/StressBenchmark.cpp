@@ -0,0 +1,252 @@
+/*
+ * Simulates a heavy session: many AuraProcessor instances with random
+ * settings and random automation, driven like a host drives its graph.
+ *
+ * For every thread count and block size, each callback processes all
+ * instances, split statically across the worker threads, and the time from
+ * the start of the callback until the last instance finishes is recorded.
+ * Dropouts come from the worst callbacks, not the average, so the report
+ * shows percentiles, the maximum and the number of callbacks that overran
+ * their deadline (the block duration).
+ *
+ * Usage: Aura_StressBenchmark [instances=256] [seconds per configuration=10]
+ *
+ * Everything is seeded, so runs are repeatable on the same machine.
+ */
+
+#include "../Source/PluginProcessor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr float automationChance = 0.05f;   // per instance and callback
+
+    struct Instance
+    {
+        std::unique_ptr<Aura::AuraProcessor> processor;
+        juce::AudioBuffer<float> input;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+        juce::Random random;
+        std::vector<juce::AudioProcessorParameter*> soundParameters;   // randomised and automated
+    };
+
+    // Held fixed so every instance does the full work on every run: bypass
+    // would put instances to sleep, adaptive quality and Eco shed load and
+    // send mode skips the dry path. The gains stay at their defaults to keep
+    // the output audible but not absurd.
+    const std::vector<std::pair<juce::String, float>> pinnedValues {
+        { Aura::ParamIDs::bypass, 0.0f },
+        { Aura::ParamIDs::adaptiveQuality, 0.0f },
+        { Aura::ParamIDs::quality, 0.0f },      // High
+        { Aura::ParamIDs::sendMode, 0.0f },     // insert
+        { Aura::ParamIDs::inputGain, Aura::Defaults::inputGain },
+        { Aura::ParamIDs::outputGain, Aura::Defaults::outputGain }
+    };
+
+    bool isPinned(const juce::String& paramId)
+    {
+        return std::any_of(pinnedValues.begin(), pinnedValues.end(),
+                           [&paramId](const auto& pinned) { return pinned.first == paramId; });
+    }
+
+    void randomiseParameters(Instance& instance)
+    {
+        auto& apvts = instance.processor->getAPVTS();
+
+        for (const auto& [paramId, value] : pinnedValues)
+        {
+            auto* param = apvts.getParameter(paramId);
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+        }
+
+        for (auto* param : instance.processor->getParameters())
+        {
+            if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(param);
+                withId != nullptr && !isPinned(withId->paramID))
+                instance.soundParameters.push_back(param);
+        }
+
+        for (auto* param : instance.soundParameters)
+            param->setValueNotifyingHost(instance.random.nextFloat());
+    }
+
+    void processInstance(Instance& instance)
+    {
+        // Automation arrives on the audio thread, as it does from a host
+        if (instance.random.nextFloat() < automationChance)
+        {
+            const auto& params = instance.soundParameters;
+            params[static_cast<size_t>(instance.random.nextInt(static_cast<int>(params.size())))]
+                ->setValue(instance.random.nextFloat());
+        }
+
+        instance.buffer.makeCopyOf(instance.input, true);
+        instance.processor->processBlock(instance.buffer, instance.midi);
+    }
+
+    //==========================================================================
+    // Worker threads spin between callbacks, like a host's audio graph threads
+    class CallbackRunner
+    {
+    public:
+        CallbackRunner(std::vector<Instance>& instancesToRun, int threads)
+            : instances(instancesToRun), numThreads(threads)
+        {
+            for (int i = 1; i < numThreads; ++i)
+                workers.emplace_back([this, i]() { workerLoop(i); });
+        }
+
+        ~CallbackRunner()
+        {
+            quit.store(true);
+            for (auto& worker : workers)
+                worker.join();
+        }
+
+        // Returns the wall time of one callback in microseconds
+        double runCallback()
+        {
+            const auto start = Clock::now();
+
+            remaining.store(numThreads - 1, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+
+            processShare(0, numThreads);
+
+            while (remaining.load(std::memory_order_acquire) > 0)
+                std::this_thread::yield();
+
+            return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        }
+
+    private:
+        void workerLoop(int index)
+        {
+            // Workers start before the first callback, so nothing can be missed
+            juce::uint64 seen = 0;
+
+            while (!quit.load(std::memory_order_relaxed))
+            {
+                auto current = generation.load(std::memory_order_acquire);
+                if (current == seen)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                seen = current;
+                processShare(index, numThreads);
+                remaining.fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        void processShare(int index, int threads)
+        {
+            for (size_t i = static_cast<size_t>(index); i < instances.size(); i += static_cast<size_t>(threads))
+                processInstance(instances[i]);
+        }
+
+        std::vector<Instance>& instances;
+        const int numThreads;
+        std::atomic<juce::uint64> generation { 0 };
+        std::atomic<int> remaining { 0 };
+        std::atomic<bool> quit { false };
+        std::vector<std::thread> workers;
+    };
+
+    double percentile(std::vector<double>& sorted, double fraction)
+    {
+        auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1));
+        return sorted[index];
+    }
+
+    void runConfiguration(std::vector<Instance>& instances, int numThreads, int blockSize, double seconds)
+    {
+        for (auto& instance : instances)
+        {
+            instance.processor->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+            instance.processor->prepareToPlay(sampleRate, blockSize);
+
+            instance.input.setSize(2, blockSize);
+            instance.buffer.setSize(2, blockSize);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    instance.input.setSample(ch, i, (instance.random.nextFloat() * 2.0f - 1.0f) * 0.25f);
+        }
+
+        const double deadlineUs = 1.0e6 * blockSize / sampleRate;
+        const int numCallbacks = juce::jmax(1, static_cast<int>(seconds * sampleRate / blockSize));
+
+        std::vector<double> times;
+        times.reserve(static_cast<size_t>(numCallbacks));
+
+        {
+            CallbackRunner runner(instances, numThreads);
+
+            // Warm up caches and let the smoothers settle before measuring
+            for (int i = 0; i < 16; ++i)
+                runner.runCallback();
+
+            for (int i = 0; i < numCallbacks; ++i)
+                times.push_back(runner.runCallback());
+        }
+
+        auto misses = std::count_if(times.begin(), times.end(), [deadlineUs](double t) { return t > deadlineUs; });
+        std::sort(times.begin(), times.end());
+
+        std::printf("%7d %6d %9.0f %9.0f %9.0f %9.0f %9.0f %9.0f %8d\n",
+                    numThreads, blockSize, deadlineUs,
+                    percentile(times, 0.5), percentile(times, 0.99), percentile(times, 0.999),
+                    times.back(), 100.0 * times.back() / deadlineUs, static_cast<int>(misses));
+        std::fflush(stdout);
+
+        for (auto& instance : instances)
+            instance.processor->releaseResources();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int numInstances = argc > 1 ? std::atoi(argv[1]) : 256;
+    const double secondsPerConfiguration = argc > 2 ? std::atof(argv[2]) : 10.0;
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    std::vector<Instance> instances(static_cast<size_t>(juce::jmax(1, numInstances)));
+
+    for (size_t i = 0; i < instances.size(); ++i)
+    {
+        auto& instance = instances[i];
+        instance.random.setSeed(static_cast<juce::int64>(0x41555241 + i));
+        instance.processor = std::make_unique<Aura::AuraProcessor>();
+        randomiseParameters(instance);
+    }
+
+    const int hardwareThreads = juce::jmax(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts { 1 };
+    for (int threads = 2; threads <= hardwareThreads; threads *= 2)
+        threadCounts.push_back(threads);
+
+    std::printf("%d instances, %.0f s of audio per configuration, times in microseconds\n\n",
+                static_cast<int>(instances.size()), secondsPerConfiguration);
+    std::printf("%7s %6s %9s %9s %9s %9s %9s %9s %8s\n",
+                "threads", "block", "deadline", "p50", "p99", "p99.9", "max", "max %", "misses");
+
+    for (int threads : threadCounts)
+        for (int blockSize : { 32, 64, 128, 256, 512, 1024 })
+            runConfiguration(instances, threads, blockSize, secondsPerConfiguration);
+
+    return 0;
+}
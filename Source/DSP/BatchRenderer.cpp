@@ -0,0 +1,123 @@
+#include "BatchRenderer.h"
+#include "BatchReverb.h"
+#include <array>
+
+namespace Aura
+{
+
+BatchRenderer::BatchRenderer(double sr, int lanes)
+    : sampleRate(sr), numLanes(lanes)
+{
+    jassert(numLanes == 4 || numLanes == 8 || numLanes == 16);
+}
+
+void BatchRenderer::render(std::vector<RenderJob>& jobs)
+{
+    switch (numLanes)
+    {
+        case 4:  renderWith<4>(jobs); break;
+        case 16: renderWith<16>(jobs); break;
+        default: renderWith<8>(jobs); break;
+    }
+}
+
+template <int Lanes>
+void BatchRenderer::renderWith(std::vector<RenderJob>& jobs)
+{
+    BatchReverb<Lanes> batch;
+    batch.prepare(sampleRate, blockSize);
+
+    std::array<EarlyReflections, Lanes> earlyReflections;
+    std::array<juce::AudioBuffer<float>, Lanes> laneBuffers;
+    std::array<RenderJob*, Lanes> active = {};
+    std::array<int, Lanes> position = {};
+    std::array<juce::AudioBuffer<float>*, Lanes> io = {};
+
+    for (int lane = 0; lane < Lanes; ++lane)
+    {
+        earlyReflections[static_cast<size_t>(lane)].prepare(sampleRate, blockSize);
+        laneBuffers[static_cast<size_t>(lane)].setSize(2, blockSize);
+    }
+
+    size_t nextJob = 0;
+
+    for (;;)
+    {
+        // Free lanes take the next jobs
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            while (active[lane] == nullptr && nextJob < jobs.size())
+            {
+                auto& job = jobs[nextJob++];
+                job.output.setSize(2, job.input.getNumSamples() + juce::jmax(0, job.tailSamples));
+                job.output.clear();
+
+                if (job.output.getNumSamples() == 0 || job.input.getNumChannels() == 0)
+                    continue;
+
+                batch.resetLane(static_cast<int>(lane));
+                earlyReflections[lane].reset();
+
+                auto settings = batch.getLane(static_cast<int>(lane));
+                ReverbEngine::applyTo(settings, earlyReflections[lane], job.settings);
+
+                active[lane] = &job;
+                position[lane] = 0;
+            }
+        }
+
+        // Run up to the next job boundary
+        int numSamples = blockSize;
+        bool anyActive = false;
+
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (active[lane] != nullptr)
+            {
+                numSamples = juce::jmin(numSamples, active[lane]->output.getNumSamples() - position[lane]);
+                anyActive = true;
+            }
+        }
+
+        if (!anyActive)
+            break;
+
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            io[lane] = nullptr;
+
+            if (active[lane] == nullptr)
+                continue;
+
+            const auto& input = active[lane]->input;
+            auto& buffer = laneBuffers[lane];
+            buffer.setSize(2, numSamples, false, false, true);
+            buffer.clear();
+
+            const int numInput = juce::jlimit(0, numSamples, input.getNumSamples() - position[lane]);
+            for (int ch = 0; ch < 2; ++ch)
+                if (numInput > 0)
+                    buffer.copyFrom(ch, 0, input, juce::jmin(ch, input.getNumChannels() - 1), position[lane], numInput);
+
+            earlyReflections[lane].process(buffer);
+            io[lane] = &buffer;
+        }
+
+        batch.process(io.data(), numSamples);
+
+        for (size_t lane = 0; lane < Lanes; ++lane)
+        {
+            if (active[lane] == nullptr)
+                continue;
+
+            for (int ch = 0; ch < 2; ++ch)
+                active[lane]->output.copyFrom(ch, position[lane], laneBuffers[lane], ch, 0, numSamples);
+
+            position[lane] += numSamples;
+            if (position[lane] == active[lane]->output.getNumSamples())
+                active[lane] = nullptr;
+        }
+    }
+}
+
+} // namespace Aura
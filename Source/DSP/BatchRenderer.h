@@ -0,0 +1,63 @@
+#pragma once
+
+#include "ReverbEngine.h"
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Render Job
+ *
+ * One offline render: an input file's audio and the settings to print it
+ * with. The output is the engine's stereo wet signal, the input's length
+ * plus the requested tail.
+ */
+struct RenderJob
+{
+    juce::AudioBuffer<float> input;   // mono or stereo
+    EngineSettings settings;
+    int tailSamples = 0;
+
+    juce::AudioBuffer<float> output;
+};
+
+//==============================================================================
+/**
+ * Batch Renderer
+ *
+ * Prints many independent jobs on one core by running them in the lanes of
+ * a BatchReverb. Each lane takes the next job as soon as its current one
+ * (tail included) is done, so jobs of different lengths keep every lane
+ * busy. Blocks are cut at job boundaries, which keeps each job's output
+ * identical to a ReverbEngine render of it.
+ *
+ * Early reflections stay per lane; they already run block-wise on the
+ * vector kernels. A mono input is rendered as dual mono, which is what the
+ * engine's shared mono path produces.
+ */
+class BatchRenderer
+{
+public:
+    static constexpr int blockSize = 512;
+
+    // lanes is 4, 8 or 16
+    BatchRenderer(double sampleRate, int lanes = 8);
+
+    // Fills in every job's output
+    void render(std::vector<RenderJob>& jobs);
+
+    int getNumLanes() const { return numLanes; }
+
+private:
+    template <int Lanes>
+    void renderWith(std::vector<RenderJob>& jobs);
+
+    double sampleRate;
+    int numLanes;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BatchRenderer)
+};
+
+} // namespace Aura
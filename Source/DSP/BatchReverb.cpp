@@ -0,0 +1,10 @@
+#include "BatchReverb.h"
+
+namespace Aura
+{
+
+template class BatchReverb<4>;
+template class BatchReverb<8>;
+template class BatchReverb<16>;
+
+} // namespace Aura
@@ -0,0 +1,530 @@
+#pragma once
+
+#include "RoomReverb.h"
+#include <array>
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Batch Reverb
+ *
+ * Lanes independent RoomReverb tails run side by side, for offline renders
+ * where many jobs share the same topology. Every delay line and filter state
+ * is a structure of arrays over the lanes, so each step of the per-sample
+ * recursion - combs, damping, the serial allpass chain - is one Lanes-wide
+ * loop over contiguous memory instead of Lanes scalar steps. The chain that
+ * can't be vectorised within one reverb is vectorised across reverbs.
+ *
+ * The lanes share the sample rate, and with it the line lengths and write
+ * positions. Only the per-lane delays differ, so the pre-delay and comb reads
+ * are gathers while all writes and the diffuser and allpass reads are plain
+ * vector loads. Each lane follows RoomReverb's arithmetic step for step.
+ *
+ * Lanes are configured through getLane(), which has RoomReverb's setters so
+ * ReverbEngine::applyTo can drive it.
+ */
+template <int Lanes>
+class BatchReverb
+{
+public:
+    static_assert(Lanes > 0, "BatchReverb needs at least one lane");
+
+    static constexpr int NumComb = RoomReverb::NumComb;
+    static constexpr int NumAllpass = RoomReverb::NumAllpass;
+    static constexpr int NumStages = InputDiffuser::NumStages;
+
+    //==============================================================================
+    // The settings of one lane, with the ranges and units of RoomReverb
+    class Lane
+    {
+    public:
+        Lane(BatchReverb& owner, int laneIndex) : batch(owner), lane(static_cast<size_t>(laneIndex)) {}
+
+        void setSize(float s)
+        {
+            batch.size[lane] = juce::jlimit(0.0f, 1.0f, s);
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < NumComb; ++i)
+                {
+                    const int maxDelay = batch.combs[ch][i].length - RoomReverb::maxModulationSamples - 2;
+                    batch.combs[ch][i].delays[lane] = juce::jlimit(1, juce::jmax(1, maxDelay),
+                        RoomReverb::getCombDelay(ch, i, batch.size[lane], batch.sampleRate));
+                }
+            }
+        }
+
+        void setDecay(float decaySeconds)
+        {
+            batch.decay[lane] = juce::jlimit(0.1f, 10.0f, decaySeconds);
+            batch.updateFeedback(lane);
+        }
+
+        void setDamping(float d)
+        {
+            batch.damping[lane] = juce::jlimit(0.0f, 0.99f, juce::jlimit(0.0f, 1.0f, d) * 0.7f);
+        }
+
+        void setPreDelay(float ms)
+        {
+            batch.preDelaySamples[lane] = juce::jlimit(0, batch.preDelayLength - 1,
+                                                       static_cast<int>(ms * batch.sampleRate / 1000.0));
+        }
+
+        void setWidth(float w)
+        {
+            batch.width[lane] = juce::jlimit(0.0f, 1.0f, w);
+        }
+
+        void setHighCut(float freq)
+        {
+            *batch.highCutFilters[lane].state = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
+                batch.sampleRate, juce::jlimit(1000.0f, 20000.0f, freq), 0.707f);
+        }
+
+        void setLowCut(float freq)
+        {
+            *batch.lowCutFilters[lane].state = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
+                batch.sampleRate, juce::jlimit(20.0f, 500.0f, freq), 0.707f);
+        }
+
+        void setModulationDepth(float depth)
+        {
+            batch.modDepth[lane] = juce::jlimit(0.0f, 1.0f, depth);
+        }
+
+        void setModulationRate(float rate)
+        {
+            const float modRate = juce::jlimit(0.1f, 2.0f, rate);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < NumComb; ++i)
+                    batch.combs[ch][i].lfoIncrement[lane] = RoomReverb::lfoRates[static_cast<size_t>(i)] * modRate
+                                                            / static_cast<float>(batch.sampleRate);
+        }
+
+        // RoomReverb stores the multi-band decay and crossover settings but its
+        // tail doesn't use them, so a lane doesn't need them either
+        void setLowDecayMultiplier(float) {}
+        void setMidDecayMultiplier(float) {}
+        void setHighDecayMultiplier(float) {}
+        void setCrossoverLow(float) {}
+        void setCrossoverHigh(float) {}
+
+    private:
+        BatchReverb& batch;
+        size_t lane;
+    };
+
+    BatchReverb() = default;
+
+    Lane getLane(int lane)
+    {
+        jassert(lane >= 0 && lane < Lanes);
+        return { *this, lane };
+    }
+
+    //==============================================================================
+    void prepare(double sr, int maxBlockSize)
+    {
+        sampleRate = sr;
+        blockSize = juce::jmax(1, maxBlockSize);
+
+        auto allocate = [](std::vector<float>& line, int length)
+        {
+            line.assign(static_cast<size_t>(length) * Lanes, 0.0f);
+            line.shrink_to_fit();
+        };
+
+        preDelayLength = RoomReverb::getPreDelayCapacity(sampleRate);
+        for (auto& line : preDelayLines)
+            allocate(line, preDelayLength);
+        preDelayWriteIndex = 0;
+
+        for (int i = 0; i < NumStages; ++i)
+        {
+            auto& stage = stages[static_cast<size_t>(i)];
+            stage.length = InputDiffuser::getStageLength(i, sampleRate);
+            stage.gain = InputDiffuser::gains[static_cast<size_t>(i)];
+            allocate(stage.frames, stage.length * 2);
+            stage.index = 0;
+        }
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < NumComb; ++i)
+            {
+                auto& comb = combs[ch][i];
+                comb.length = RoomReverb::getCombCapacity(ch, i, sampleRate);
+                allocate(comb.line, comb.length);
+                comb.writeIndex = 0;
+            }
+
+            for (int i = 0; i < NumAllpass; ++i)
+            {
+                auto& allpass = allpasses[ch][i];
+                allpass.length = RoomReverb::getAllpassCapacity(ch, i, sampleRate);
+                allpass.delay = RoomReverb::getAllpassDelay(ch, i, sampleRate);
+                allocate(allpass.line, allpass.length);
+                allpass.writeIndex = 0;
+            }
+        }
+
+        juce::dsp::ProcessSpec spec;
+        spec.sampleRate = sampleRate;
+        spec.maximumBlockSize = static_cast<juce::uint32>(blockSize);
+        spec.numChannels = 2;
+
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            highCutFilters[static_cast<size_t>(lane)].prepare(spec);
+            lowCutFilters[static_cast<size_t>(lane)].prepare(spec);
+        }
+
+        for (auto& channel : io)
+            channel.assign(static_cast<size_t>(blockSize) * Lanes, 0.0f);
+
+        // Every lane starts as a freshly prepared RoomReverb
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            const auto l = static_cast<size_t>(lane);
+            size[l] = 0.5f;
+            decay[l] = 2.0f;
+            damping[l] = 0.5f;
+            width[l] = 1.0f;
+            modDepth[l] = 0.3f;
+            preDelaySamples[l] = 0;
+
+            auto settings = getLane(lane);
+            settings.setSize(0.5f);
+            settings.setModulationRate(1.0f);
+            settings.setHighCut(12000.0f);
+            settings.setLowCut(80.0f);
+            updateFeedback(l);
+
+            resetLane(lane);
+        }
+    }
+
+    // Clears one lane's state, as if it had just been prepared, for its next job
+    void resetLane(int lane)
+    {
+        const auto l = static_cast<size_t>(lane);
+
+        auto clear = [l](std::vector<float>& line)
+        {
+            for (size_t i = l; i < line.size(); i += Lanes)
+                line[i] = 0.0f;
+        };
+
+        for (auto& line : preDelayLines)
+            clear(line);
+
+        for (auto& stage : stages)
+            clear(stage.frames);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < NumComb; ++i)
+            {
+                clear(combs[ch][i].line);
+                combs[ch][i].dampingState[l] = 0.0f;
+                combs[ch][i].lfoPhase[l] = RoomReverb::getLFOPhase(ch, i);
+            }
+
+            for (auto& allpass : allpasses[ch])
+                clear(allpass.line);
+        }
+
+        highCutFilters[l].reset();
+        lowCutFilters[l].reset();
+    }
+
+    // Bytes of delay memory held across all lanes
+    size_t getMemoryFootprint() const
+    {
+        size_t numFloats = 0;
+
+        for (const auto& line : preDelayLines) numFloats += line.capacity();
+        for (const auto& stage : stages) numFloats += stage.frames.capacity();
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (const auto& comb : combs[ch]) numFloats += comb.line.capacity();
+            for (const auto& allpass : allpasses[ch]) numFloats += allpass.line.capacity();
+        }
+
+        return numFloats * sizeof(float);
+    }
+
+    // Replaces each lane's stereo buffer with its wet tail, like RoomReverb::process.
+    // A null buffer is an idle lane: it is fed silence and its output dropped.
+    void process(juce::AudioBuffer<float>* const* buffers, int numSamples)
+    {
+        jassert(numSamples <= blockSize);
+
+        // Lanes innermost, one frame of Lanes samples per channel and sample
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            float* frames = io[static_cast<size_t>(ch)].data();
+
+            for (int lane = 0; lane < Lanes; ++lane)
+            {
+                const auto* buffer = buffers[lane];
+                jassert(buffer == nullptr || (buffer->getNumChannels() >= 2 && buffer->getNumSamples() >= numSamples));
+                const float* in = buffer != nullptr ? buffer->getReadPointer(ch) : nullptr;
+
+                for (int i = 0; i < numSamples; ++i)
+                    frames[i * Lanes + lane] = in != nullptr ? in[i] : 0.0f;
+            }
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+            processFrame(io[0].data() + i * Lanes, io[1].data() + i * Lanes);
+
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            auto* buffer = buffers[lane];
+            if (buffer == nullptr)
+                continue;
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const float* frames = io[static_cast<size_t>(ch)].data();
+                float* out = buffer->getWritePointer(ch);
+
+                for (int i = 0; i < numSamples; ++i)
+                    out[i] = frames[i * Lanes + lane];
+            }
+
+            // The output filters are cheap next to the tail and stay per lane
+            auto block = juce::dsp::AudioBlock<float>(*buffer).getSubsetChannelBlock(0, 2)
+                                                              .getSubBlock(0, static_cast<size_t>(numSamples));
+            juce::dsp::ProcessContextReplacing<float> context(block);
+            highCutFilters[static_cast<size_t>(lane)].process(context);
+            lowCutFilters[static_cast<size_t>(lane)].process(context);
+        }
+
+        for (auto& channelCombs : combs)
+            for (auto& comb : channelCombs)
+                for (auto& state : comb.dampingState)
+                    Denormals::flush(state);
+    }
+
+private:
+    // One sample of every lane; left and right are Lanes wide, in and out
+    void processFrame(float* left, float* right)
+    {
+        constexpr float maxModulation = static_cast<float>(RoomReverb::maxModulationSamples);
+        std::array<float*, 2> channels = { left, right };
+
+        // Pre-delay
+        const int preDelayWrite = preDelayWriteIndex * Lanes;
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            float* line = preDelayLines[static_cast<size_t>(ch)].data();
+            float* x = channels[static_cast<size_t>(ch)];
+
+            for (int lane = 0; lane < Lanes; ++lane)
+                line[preDelayWrite + lane] = x[lane];
+
+            for (int lane = 0; lane < Lanes; ++lane)
+            {
+                int readIndex = preDelayWriteIndex - preDelaySamples[static_cast<size_t>(lane)];
+                if (readIndex < 0) readIndex += preDelayLength;
+
+                x[lane] = line[readIndex * Lanes + lane] + Denormals::offset;
+            }
+        }
+
+        if (++preDelayWriteIndex == preDelayLength)
+            preDelayWriteIndex = 0;
+
+        // Input diffuser
+        for (auto& stage : stages)
+        {
+            float* frame = stage.frames.data() + stage.index * 2 * Lanes;
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                float* x = channels[static_cast<size_t>(ch)];
+                float* state = frame + ch * Lanes;
+
+                for (int lane = 0; lane < Lanes; ++lane)
+                {
+                    const float delayed = state[lane];
+                    const float v = x[lane] + stage.gain * delayed;
+                    x[lane] = delayed - stage.gain * v;
+                    state[lane] = v;
+                }
+            }
+
+            if (++stage.index == stage.length)
+                stage.index = 0;
+        }
+
+        // Combs in parallel, with modulation
+        std::array<std::array<float, Lanes>, 2> combSum = {};
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            const float* x = channels[static_cast<size_t>(ch)];
+            auto& sum = combSum[static_cast<size_t>(ch)];
+
+            for (auto& comb : combs[ch])
+            {
+                float* line = comb.line.data();
+                const int length = comb.length;
+                const int writeIndex = comb.writeIndex;
+
+                for (int lane = 0; lane < Lanes; ++lane)
+                {
+                    const auto l = static_cast<size_t>(lane);
+
+                    // Triangle LFO, as ReverbLFO
+                    const float lfoValue = 2.0f * std::abs(2.0f * comb.lfoPhase[l] - 1.0f) - 1.0f;
+                    comb.lfoPhase[l] += comb.lfoIncrement[l];
+                    if (comb.lfoPhase[l] >= 1.0f) comb.lfoPhase[l] -= 1.0f;
+
+                    const float modOffset = lfoValue * modDepth[l] * maxModulation;
+                    const float exactDelay = static_cast<float>(comb.delays[l]) + modOffset;
+                    int delay1 = static_cast<int>(exactDelay);
+                    int delay2 = delay1 + 1;
+                    const float frac = exactDelay - static_cast<float>(delay1);
+
+                    delay1 = juce::jlimit(1, length - 2, delay1);
+                    delay2 = juce::jlimit(1, length - 1, delay2);
+
+                    int readIndex1 = writeIndex - delay1;
+                    int readIndex2 = writeIndex - delay2;
+                    if (readIndex1 < 0) readIndex1 += length;
+                    if (readIndex2 < 0) readIndex2 += length;
+
+                    const float delayed = line[readIndex1 * Lanes + lane] * (1.0f - frac)
+                                        + line[readIndex2 * Lanes + lane] * frac;
+
+                    comb.dampingState[l] = delayed * (1.0f - damping[l]) + comb.dampingState[l] * damping[l];
+                    line[writeIndex * Lanes + lane] = x[lane] + comb.dampingState[l] * feedback[l];
+
+                    sum[l] += delayed;
+                }
+
+                comb.writeIndex = (writeIndex + 1) % length;
+            }
+        }
+
+        // Allpasses in series: the same delay in every lane, so contiguous loads
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            auto& x = combSum[static_cast<size_t>(ch)];
+
+            for (auto& value : x)
+                value /= NumComb;
+
+            for (auto& allpass : allpasses[ch])
+            {
+                int readIndex = allpass.writeIndex - allpass.delay;
+                if (readIndex < 0) readIndex += allpass.length;
+
+                const float* read = allpass.line.data() + readIndex * Lanes;
+                float* write = allpass.line.data() + allpass.writeIndex * Lanes;
+
+                for (int lane = 0; lane < Lanes; ++lane)
+                {
+                    const auto l = static_cast<size_t>(lane);
+                    const float delayed = read[lane];
+                    const float output = -RoomReverb::allpassFeedback * x[l] + delayed;
+                    write[lane] = x[l] + RoomReverb::allpassFeedback * delayed;
+                    x[l] = output;
+                }
+
+                allpass.writeIndex = (allpass.writeIndex + 1) % allpass.length;
+            }
+        }
+
+        // Width
+        for (int lane = 0; lane < Lanes; ++lane)
+        {
+            const auto l = static_cast<size_t>(lane);
+            const float mid = (combSum[0][l] + combSum[1][l]) * 0.5f;
+            const float side = (combSum[0][l] - combSum[1][l]) * 0.5f * width[l];
+            left[lane] = mid + side;
+            right[lane] = mid - side;
+        }
+    }
+
+    void updateFeedback(size_t lane)
+    {
+        // As RoomReverb: the size at the time the decay was set
+        const float avgDelaySec = 0.030f * (0.5f + size[lane]);
+        feedback[lane] = juce::jlimit(0.0f, 0.98f, std::pow(10.0f, -3.0f * avgDelaySec / decay[lane]));
+    }
+
+    using LaneValues = std::array<float, Lanes>;
+
+    struct Comb
+    {
+        std::vector<float> line;   // length frames of Lanes samples
+        int length = 1;
+        int writeIndex = 0;
+        std::array<int, Lanes> delays = {};
+        LaneValues dampingState = {};
+        LaneValues lfoPhase = {};
+        LaneValues lfoIncrement = {};
+    };
+
+    struct Allpass
+    {
+        std::vector<float> line;
+        int length = 1;
+        int delay = 1;
+        int writeIndex = 0;
+    };
+
+    struct Stage
+    {
+        std::vector<float> frames;   // left then right frame per position
+        int length = 1;
+        int index = 0;
+        float gain = 0.0f;
+    };
+
+    using Filter = juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>,
+                                                  juce::dsp::IIR::Coefficients<float>>;
+
+    double sampleRate = 44100.0;
+    int blockSize = 1;
+
+    // Per-lane settings
+    LaneValues size = {};
+    LaneValues decay = {};
+    LaneValues damping = {};
+    LaneValues width = {};
+    LaneValues modDepth = {};
+    LaneValues feedback = {};
+    std::array<int, Lanes> preDelaySamples = {};
+
+    std::array<std::vector<float>, 2> preDelayLines;
+    int preDelayLength = 1;
+    int preDelayWriteIndex = 0;
+
+    std::array<Stage, NumStages> stages;
+    std::array<std::array<Comb, NumComb>, 2> combs;
+    std::array<std::array<Allpass, NumAllpass>, 2> allpasses;
+
+    std::array<Filter, Lanes> highCutFilters;
+    std::array<Filter, Lanes> lowCutFilters;
+
+    // Interleaved block, one vector per channel
+    std::array<std::vector<float>, 2> io;
+};
+
+extern template class BatchReverb<4>;
+extern template class BatchReverb<8>;
+extern template class BatchReverb<16>;
+
+} // namespace Aura
@@ -0,0 +1,75 @@
+#include "CpuGovernor.h"
+
+namespace Aura
+{
+
+CpuGovernor::CpuGovernor(int levels)
+    : numLevels(juce::jmax(1, levels))
+{
+}
+
+void CpuGovernor::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    reset();
+}
+
+void CpuGovernor::reset()
+{
+    level.store(0, std::memory_order_relaxed);
+    overrunBlocks = 0;
+    overrunSamples = 0;
+    headroomSamples = 0;
+    samplesSinceStep = 0;
+}
+
+int CpuGovernor::update(double elapsedSeconds, int numSamples)
+{
+    if (numSamples <= 0)
+        return getLevel();
+
+    const double load = elapsedSeconds * sampleRate / static_cast<double>(numSamples);
+    samplesSinceStep += numSamples;
+
+    if (load > overloadLoad)
+    {
+        ++overrunBlocks;
+        overrunSamples += numSamples;
+    }
+    else
+    {
+        overrunBlocks = 0;
+        overrunSamples = 0;
+    }
+
+    // Anything short of real headroom restarts the wait to step back up
+    headroomSamples = load < headroomLoad ? headroomSamples + numSamples : 0;
+
+    const bool held = static_cast<double>(samplesSinceStep) < holdSeconds * sampleRate;
+
+    if (!held && overrunBlocks >= overloadBlocks
+        && static_cast<double>(overrunSamples) >= overloadMinSeconds * sampleRate)
+        step(1);
+    else if (!held && static_cast<double>(headroomSamples) >= recoverySeconds * sampleRate)
+        step(-1);
+
+    return getLevel();
+}
+
+void CpuGovernor::step(int direction)
+{
+    const int current = getLevel();
+    const int next = juce::jlimit(0, numLevels - 1, current + direction);
+
+    overrunBlocks = 0;
+    overrunSamples = 0;
+    headroomSamples = 0;
+
+    if (next == current)
+        return;
+
+    level.store(next, std::memory_order_relaxed);
+    samplesSinceStep = 0;
+}
+
+} // namespace Aura
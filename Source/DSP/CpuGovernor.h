@@ -0,0 +1,70 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * CPU Governor
+ *
+ * Times each audio callback against its deadline (block size / sample rate)
+ * and picks a processing level, 0 being full quality. A run of overrunning
+ * blocks steps one level down; seconds of comfortable headroom step one level
+ * back up. Every step is held for a while before the next one, so the
+ * engine's ramp completes and a single slow block can't cascade.
+ *
+ * update() runs on the audio thread and never allocates; getLevel() may be
+ * read from any thread.
+ */
+class CpuGovernor
+{
+public:
+    explicit CpuGovernor(int numLevels);
+
+    void prepare(double sampleRate);
+
+    // Back to full quality, e.g. while the governor is switched off
+    void reset();
+
+    // Feeds the time a block of numSamples took; returns the level for the next block
+    int update(double elapsedSeconds, int numSamples);
+
+    int getLevel() const { return level.load(std::memory_order_relaxed); }
+    int getNumLevels() const { return numLevels; }
+
+    // Share of the deadline above which a block counts as overrun, and below
+    // which it counts as headroom. The gap between them is the hysteresis.
+    static constexpr double overloadLoad = 0.8;
+    static constexpr double headroomLoad = 0.4;
+
+    // Consecutive overrun blocks before stepping down; they must also add up
+    // to overloadMinSeconds, so tiny host blocks don't react to timer jitter
+    static constexpr int overloadBlocks = 4;
+    static constexpr double overloadMinSeconds = 0.005;
+
+    // Uninterrupted headroom before stepping back up
+    static constexpr double recoverySeconds = 3.0;
+
+    // Minimum time between two steps, and after prepare() or reset(), when
+    // the first callbacks run on cold caches
+    static constexpr double holdSeconds = 0.25;
+
+private:
+    void step(int direction);
+
+    const int numLevels;
+    std::atomic<int> level { 0 };
+
+    double sampleRate = 44100.0;
+    int overrunBlocks = 0;
+    int64_t overrunSamples = 0;
+    int64_t headroomSamples = 0;
+    int64_t samplesSinceStep = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(CpuGovernor)
+};
+
+} // namespace Aura
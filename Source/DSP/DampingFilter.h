@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Denormals.h"
 #include <juce_dsp/juce_dsp.h>
 
 namespace Aura
@@ -38,6 +39,14 @@ public:
         return state;
     }
 
+    bool isFinite() const { return std::isfinite(state); }
+
+    // Called once per block; keeps a decaying state out of the subnormal range
+    void snapToZero()
+    {
+        Denormals::flush(state);
+    }
+
 private:
     double sampleRate = 44100.0;
     float damping = 0.5f;
@@ -0,0 +1,260 @@
+#include "DecayAnalyser.h"
+#include <cmath>
+
+namespace Aura
+{
+
+namespace
+{
+    float energyToDecibels(double energy)
+    {
+        return static_cast<float>(10.0 * std::log10(juce::jmax(energy, 1.0e-20)));
+    }
+}
+
+void DecayAnalyser::prepare(double sampleRate)
+{
+    const juce::ScopedLock lock(analysisLock);
+
+    const int capacity = juce::jmax(1024, static_cast<int>(sampleRate * fifoSeconds));
+    fifo = std::make_unique<juce::AbstractFifo>(capacity);
+    fifoBuffer.setSize(2, capacity);
+    fifoBuffer.clear();
+
+    // Fixed measurement bands, independent of the engine's crossovers
+    juce::dsp::ProcessSpec spec { sampleRate, 512, 1 };
+
+    auto setUp = [&spec](juce::dsp::LinkwitzRileyFilter<float>& filter,
+                         juce::dsp::LinkwitzRileyFilterType type, float cutoff)
+    {
+        filter.setType(type);
+        filter.setCutoffFrequency(cutoff);
+        filter.prepare(spec);
+    };
+
+    setUp(lowPass, juce::dsp::LinkwitzRileyFilterType::lowpass, lowBandEdge);
+    setUp(midHighPass, juce::dsp::LinkwitzRileyFilterType::highpass, lowBandEdge);
+    setUp(midLowPass, juce::dsp::LinkwitzRileyFilterType::lowpass, highBandEdge);
+    setUp(highPass, juce::dsp::LinkwitzRileyFilterType::highpass, highBandEdge);
+
+    frameLength = juce::jmax(1, juce::roundToInt(sampleRate * frameLengthSeconds));
+    frameFill = 0;
+    frameEnergy.fill(0.0f);
+
+    maxSegmentFrames = static_cast<size_t>(maxSegmentSeconds / frameLengthSeconds);
+    segment.clear();
+    segment.reserve(maxSegmentFrames);
+    segmentPeakDb = -200.0f;
+    segmentFloorDb = -200.0f;
+    awaitingExcitation = false;
+
+    latest = DecayAnalysis();
+    latest.frameSeconds = static_cast<float>(frameLength / sampleRate);
+}
+
+void DecayAnalyser::push(const juce::AudioBuffer<float>& wet)
+{
+    const int numSamples = wet.getNumSamples();
+    const int numChannels = wet.getNumChannels();
+
+    if (!enabled.load(std::memory_order_relaxed) || fifo == nullptr || numChannels == 0)
+        return;
+
+    // Losing a block only delays the next measurement; waiting is never an option here
+    if (fifo->getFreeSpace() < numSamples)
+        return;
+
+    const auto scope = fifo->write(numSamples);
+
+    for (int ch = 0; ch < fifoBuffer.getNumChannels(); ++ch)
+    {
+        const int source = juce::jmin(ch, numChannels - 1);
+
+        if (scope.blockSize1 > 0)
+            fifoBuffer.copyFrom(ch, scope.startIndex1, wet, source, 0, scope.blockSize1);
+        if (scope.blockSize2 > 0)
+            fifoBuffer.copyFrom(ch, scope.startIndex2, wet, source, scope.blockSize1, scope.blockSize2);
+    }
+}
+
+size_t DecayAnalyser::getMemoryFootprint() const
+{
+    const juce::ScopedLock lock(analysisLock);
+
+    return static_cast<size_t>(fifoBuffer.getNumChannels() * fifoBuffer.getNumSamples()) * sizeof(float)
+         + segment.capacity() * sizeof(segment[0])
+         + latest.energyDecayCurve.capacity() * sizeof(float);
+}
+
+bool DecayAnalyser::process()
+{
+    const juce::ScopedLock lock(analysisLock);
+
+    if (fifo == nullptr)
+        return false;
+
+    const int generationBefore = latest.generation;
+    const auto scope = fifo->read(fifo->getNumReady());
+
+    auto consume = [this](int start, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        const float* left = fifoBuffer.getReadPointer(0, start);
+        const float* right = fifoBuffer.getReadPointer(1, start);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float x = 0.5f * (left[i] + right[i]);
+            const float low = lowPass.processSample(0, x);
+            const float mid = midLowPass.processSample(0, midHighPass.processSample(0, x));
+            const float high = highPass.processSample(0, x);
+
+            frameEnergy[DecayAnalysis::Broadband] += x * x;
+            frameEnergy[DecayAnalysis::Low] += low * low;
+            frameEnergy[DecayAnalysis::Mid] += mid * mid;
+            frameEnergy[DecayAnalysis::High] += high * high;
+
+            if (++frameFill == frameLength)
+                analyseFrame();
+        }
+    };
+
+    consume(scope.startIndex1, scope.blockSize1);
+    consume(scope.startIndex2, scope.blockSize2);
+
+    return latest.generation != generationBefore;
+}
+
+void DecayAnalyser::analyseFrame()
+{
+    std::array<float, DecayAnalysis::NumBands> energies;
+    for (size_t band = 0; band < energies.size(); ++band)
+        energies[band] = frameEnergy[band] / static_cast<float>(frameLength);
+
+    frameEnergy.fill(0.0f);
+    frameFill = 0;
+
+    const float frameDb = energyToDecibels(energies[DecayAnalysis::Broadband]);
+
+    // After a measurement nothing is tracked until the signal rises again,
+    // so the quiet end of the same tail isn't measured a second time
+    if (awaitingExcitation)
+    {
+        if (frameDb <= segmentFloorDb + restartThresholdDb)
+        {
+            segmentFloorDb = juce::jmin(segmentFloorDb, frameDb);
+            return;
+        }
+
+        awaitingExcitation = false;
+        segmentPeakDb = frameDb;
+    }
+
+    // Near the peak, or rising again, means the room is still being excited:
+    // the free decay can only start after this frame
+    const bool nearPeak = frameDb > segmentPeakDb - restartThresholdDb;
+    const bool rising = frameDb > segmentFloorDb + restartThresholdDb;
+
+    if (nearPeak || rising || segment.size() >= maxSegmentFrames)
+    {
+        segment.clear();
+        segmentPeakDb = nearPeak ? juce::jmax(segmentPeakDb, frameDb) : frameDb;
+        segmentFloorDb = frameDb;
+    }
+
+    segment.push_back(energies);
+    segmentFloorDb = juce::jmin(segmentFloorDb, frameDb);
+
+    if (segmentPeakDb >= minimumPeakDb && frameDb <= segmentPeakDb - measureRangeDb)
+    {
+        measureSegment();
+
+        segment.clear();
+        segmentFloorDb = frameDb;
+        awaitingExcitation = true;
+    }
+}
+
+void DecayAnalyser::measureSegment()
+{
+    std::vector<float> bandEnergies(segment.size());
+
+    for (size_t band = 0; band < DecayAnalysis::NumBands; ++band)
+    {
+        for (size_t i = 0; i < segment.size(); ++i)
+            bandEnergies[i] = segment[i][band];
+
+        auto curve = schroederIntegral(bandEnergies);
+        latest.rt60[band] = estimateRT60(curve, latest.frameSeconds);
+
+        if (band == DecayAnalysis::Broadband)
+            latest.energyDecayCurve = std::move(curve);
+    }
+
+    ++latest.generation;
+}
+
+//==============================================================================
+std::vector<float> DecayAnalyser::schroederIntegral(const std::vector<float>& frameEnergies)
+{
+    std::vector<float> curve(frameEnergies.size());
+
+    double total = 0.0;
+    for (auto energy : frameEnergies)
+        total += energy;
+
+    if (total <= 0.0)
+    {
+        std::fill(curve.begin(), curve.end(), -200.0f);
+        return curve;
+    }
+
+    // Energy remaining from each frame to the end, relative to the whole
+    double remaining = 0.0;
+    for (size_t i = frameEnergies.size(); i-- > 0;)
+    {
+        remaining += frameEnergies[i];
+        curve[i] = energyToDecibels(remaining / total);
+    }
+
+    return curve;
+}
+
+float DecayAnalyser::estimateRT60(const std::vector<float>& decayCurveDb, float frameSeconds)
+{
+    constexpr float fitStartDb = -5.0f;
+    constexpr float fitEndDb = -25.0f;
+
+    double sumT = 0.0, sumD = 0.0, sumTT = 0.0, sumTD = 0.0;
+    int count = 0;
+
+    for (size_t i = 0; i < decayCurveDb.size(); ++i)
+    {
+        const float level = decayCurveDb[i];
+        if (level > fitStartDb)
+            continue;
+        if (level < fitEndDb)
+            break;
+
+        const double t = static_cast<double>(i) * frameSeconds;
+        sumT += t;
+        sumD += level;
+        sumTT += t * t;
+        sumTD += t * level;
+        ++count;
+    }
+
+    const double denominator = count * sumTT - sumT * sumT;
+    if (count < 3 || denominator <= 0.0)
+        return std::numeric_limits<float>::quiet_NaN();
+
+    const double slope = (count * sumTD - sumT * sumD) / denominator;   // dB per second
+    if (slope >= 0.0)
+        return std::numeric_limits<float>::quiet_NaN();
+
+    return static_cast<float>(-60.0 / slope);
+}
+
+} // namespace Aura
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Decay Analysis
+ *
+ * Result of the last measured free decay of the wet signal.
+ */
+struct DecayAnalysis
+{
+    enum Band { Broadband = 0, Low, Mid, High, NumBands };
+
+    // RT60 per band in seconds, NaN until a decay has been measured
+    std::array<float, NumBands> rt60;
+
+    // Broadband energy decay curve in dB (0 dB at the start), one point per frame
+    std::vector<float> energyDecayCurve;
+    float frameSeconds = 0.0f;
+
+    int generation = 0;
+
+    DecayAnalysis() { rt60.fill(std::numeric_limits<float>::quiet_NaN()); }
+};
+
+//==============================================================================
+/**
+ * Decay Analyser
+ *
+ * Measures the real decay of the wet output instead of drawing one from the
+ * decay parameter. The audio thread only copies each block into a lock-free
+ * FIFO; process() drains it elsewhere (the editor calls it from its vblank
+ * callback), splits the signal into bands and tracks the energy per frame.
+ *
+ * A decay is taken from the last point where the signal was within a few dB
+ * of its peak, until it has fallen measureRangeDb below it. The energy decay
+ * curve of that segment is computed by Schroeder backward integration, and
+ * RT60 is extrapolated from a line fitted between -5 and -25 dB (T20).
+ */
+class DecayAnalyser
+{
+public:
+    DecayAnalyser() = default;
+
+    // Not concurrent with push(); process() may run on another thread
+    void prepare(double sampleRate);
+
+    // The audio thread does nothing while disabled, e.g. with no editor open
+    void setEnabled(bool shouldBeEnabled) { enabled.store(shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Audio thread: copies the block, or drops it if the FIFO is full
+    void push(const juce::AudioBuffer<float>& wet);
+
+    // Analysis thread: returns true if a new decay was measured
+    bool process();
+
+    // Analysis thread
+    const DecayAnalysis& getLatest() const { return latest; }
+
+    // Bytes held by the FIFO and the segment being measured
+    size_t getMemoryFootprint() const;
+
+    //==========================================================================
+    // Normalised Schroeder integral of per-frame energies, in dB
+    static std::vector<float> schroederIntegral(const std::vector<float>& frameEnergies);
+
+    // RT60 from a decay curve in dB via a least-squares fit over [-5, -25] dB
+    static float estimateRT60(const std::vector<float>& decayCurveDb, float frameSeconds);
+
+    static constexpr float lowBandEdge = 250.0f;     // Hz
+    static constexpr float highBandEdge = 4000.0f;   // Hz
+
+private:
+    void analyseFrame();
+    void measureSegment();
+
+    static constexpr double fifoSeconds = 0.5;
+    static constexpr double frameLengthSeconds = 0.01;
+    static constexpr double maxSegmentSeconds = 20.0;
+    static constexpr float restartThresholdDb = 3.0f;
+    static constexpr float measureRangeDb = 40.0f;
+    static constexpr float minimumPeakDb = -60.0f;
+
+    // Audio thread -> analysis thread
+    std::atomic<bool> enabled { false };
+    std::unique_ptr<juce::AbstractFifo> fifo;
+    juce::AudioBuffer<float> fifoBuffer;
+
+    // Analysis thread only
+    juce::CriticalSection analysisLock;
+    juce::dsp::LinkwitzRileyFilter<float> lowPass, midHighPass, midLowPass, highPass;
+    int frameLength = 0;
+    int frameFill = 0;
+    std::array<float, DecayAnalysis::NumBands> frameEnergy {};
+
+    std::vector<std::array<float, DecayAnalysis::NumBands>> segment;
+    size_t maxSegmentFrames = 0;
+    float segmentPeakDb = -200.0f;
+    float segmentFloorDb = -200.0f;
+    bool awaitingExcitation = false;
+
+    DecayAnalysis latest;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(DecayAnalyser)
+};
+
+} // namespace Aura
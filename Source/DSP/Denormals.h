@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cmath>
+
+namespace Aura
+{
+
+//==============================================================================
+// Denormal protection built into the DSP, so tails stay cheap even where the
+// FTZ/DAZ flags set by ScopedNoDenormals don't apply (offline renders, hosts
+// that reset the FPU state, non-x86 builds)
+//==============================================================================
+namespace Denormals
+{
+    // Added to the reverb input. About -360 dB, so inaudible, but it keeps every
+    // recursive state it flows through far above the subnormal range.
+    constexpr float offset = 1.0e-18f;
+
+    // Scalar states below this are flushed once per block
+    constexpr float flushThreshold = 1.0e-30f;
+
+    inline void flush(float& state)
+    {
+        if (std::abs(state) < flushThreshold)
+            state = 0.0f;
+    }
+}
+
+} // namespace Aura
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
+#include "DelayBuffer.h"
+#include "Kernels.h"
 #include <array>
 #include <vector>
 
@@ -13,39 +15,84 @@ namespace Aura
  *
  * Simulates discrete early reflections from room surfaces
  * using a multi-tap delay line with configurable timing.
+ *
+ * Works a block at a time: the block is written to the line first and
+ * each tap is then summed over the whole block with the dispatched
+ * kernels, so the line holds one block beyond the longest tap.
  */
 class EarlyReflections
 {
 public:
     static constexpr int NumTaps = 12;
 
+    // Base tap times in ms (simulating room reflections)
+    static constexpr std::array<float, NumTaps> tapTimesMs = {
+        5.0f, 8.0f, 12.0f, 17.0f, 23.0f, 31.0f,
+        41.0f, 53.0f, 67.0f, 83.0f, 101.0f, 121.0f
+    };
+
+    // Tap spacing scale at size 0 and 1
+    static constexpr float minSizeScale = 0.3f;
+    static constexpr float maxSizeScale = 1.7f;
+
     EarlyReflections() = default;
 
+    // Tap delay in samples for a size of 0-1
+    static int getTapDelay(int tap, float size, double sr)
+    {
+        const float sizeScale = minSizeScale + size * (maxSizeScale - minSizeScale);
+        return static_cast<int>(tapTimesMs[static_cast<size_t>(tap)] * sizeScale * sr / 1000.0);
+    }
+
+    // Delay line length that holds the last tap at the largest size, plus
+    // the block written ahead of the taps
+    static int getDelayCapacity(double sr, int maxBlockSize)
+    {
+        return getTapDelay(NumTaps - 1, 1.0f, sr) + juce::jmax(1, maxBlockSize);
+    }
+
     void prepare(double sr, int maxBlockSize)
     {
         sampleRate = sr;
+        blockSize = juce::jmax(1, maxBlockSize);
+        kernels = &Kernels::get();
 
-        // Max 200ms of delay for ER
-        int maxSamples = static_cast<int>(0.2 * sampleRate);
         for (int ch = 0; ch < 2; ++ch)
         {
-            delayBuffer[ch].resize(static_cast<size_t>(maxSamples));
-            std::fill(delayBuffer[ch].begin(), delayBuffer[ch].end(), 0.0f);
+            delayBuffer[ch].allocate(getDelayCapacity(sampleRate, blockSize), delayPrecision);
+            scratch[ch].assign(static_cast<size_t>(blockSize), 0.0f);
+            scratch[ch].shrink_to_fit();
         }
         writeIndex = 0;
 
         updateTapTimes();
     }
 
+    // Bytes of delay and scratch memory held
+    size_t getMemoryFootprint() const
+    {
+        return delayBuffer[0].getMemoryFootprint() + delayBuffer[1].getMemoryFootprint()
+             + (scratch[0].capacity() + scratch[1].capacity()) * sizeof(float);
+    }
+
+    // Storage of the delay line; takes effect at the next prepare()
+    void setDelayPrecision(DelayPrecision newPrecision) { delayPrecision = newPrecision; }
+    DelayPrecision getDelayPrecision() const { return delayPrecision; }
+
     void reset()
     {
         for (int ch = 0; ch < 2; ++ch)
         {
-            std::fill(delayBuffer[ch].begin(), delayBuffer[ch].end(), 0.0f);
+            delayBuffer[ch].clear();
         }
         writeIndex = 0;
     }
 
+    bool isFinite() const
+    {
+        return delayBuffer[0].isFinite() && delayBuffer[1].isFinite();
+    }
+
     // Set room size (0-1) affects tap spacing
     void setSize(float s)
     {
@@ -61,67 +108,127 @@ public:
 
     void process(juce::AudioBuffer<float>& buffer)
     {
+        process(buffer, buffer);
+    }
+
+    // Writes input plus reflections to output, which may share the input's
+    // channels. Output must have at least as many channels and samples as the
+    // input; a mono input is tapped once and copied to the other channels.
+    void process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output)
+    {
+        int numSamples = input.getNumSamples();
+        int numChannels = juce::jmin(input.getNumChannels(), 2);
+        int numOutputChannels = juce::jmin(output.getNumChannels(), 2);
+
         if (level < 0.001f)
+        {
+            for (int ch = 0; ch < numOutputChannels; ++ch)
+            {
+                const int source = juce::jmin(ch, numChannels - 1);
+                if (output.getReadPointer(ch) != input.getReadPointer(source))
+                    output.copyFrom(ch, 0, input, source, 0, numSamples);
+            }
             return;
+        }
+
+        if (delayBuffer[0].getPrecision() == DelayPrecision::Half)
+            processBlocks<uint16_t>(input, output, numSamples, numChannels, numOutputChannels);
+        else
+            processBlocks<float>(input, output, numSamples, numChannels, numOutputChannels);
+    }
 
-        int numSamples = buffer.getNumSamples();
-        int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+private:
+    template <typename Sample>
+    void processBlocks(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output,
+                       int numSamples, int numChannels, int numOutputChannels)
+    {
+        const int length = delayBuffer[0].size();
 
-        for (int sample = 0; sample < numSamples; ++sample)
+        for (int offset = 0; offset < numSamples; offset += blockSize)
         {
-            // Write to delay buffer
+            const int n = juce::jmin(blockSize, numSamples - offset);
+
+            // Write the block to the delay line
             for (int ch = 0; ch < numChannels; ++ch)
             {
-                delayBuffer[ch][static_cast<size_t>(writeIndex)] = buffer.getSample(ch, sample);
+                const float* in = input.getReadPointer(ch, offset);
+                const int first = juce::jmin(n, length - writeIndex);
+                Sample* line = delayBuffer[ch].getData<Sample>();
+                writeSamples(line + writeIndex, in, first);
+                writeSamples(line, in + first, n - first);
             }
 
-            // Sum taps
+            // Sum taps over the block
             for (int ch = 0; ch < numChannels; ++ch)
             {
-                float erSum = 0.0f;
+                float* erSum = scratch[ch].data();
+                std::fill(erSum, erSum + n, 0.0f);
 
                 for (int tap = 0; tap < NumTaps; ++tap)
                 {
                     int readIndex = writeIndex - tapDelays[tap];
                     if (readIndex < 0)
-                        readIndex += static_cast<int>(delayBuffer[ch].size());
+                        readIndex += length;
 
                     // Alternate between channels for stereo spread
-                    int srcChannel = (tap + ch) % numChannels;
-                    erSum += delayBuffer[srcChannel][static_cast<size_t>(readIndex)] * tapGains[tap];
+                    const Sample* line = delayBuffer[(tap + ch) % numChannels].getData<Sample>();
+                    const int first = juce::jmin(n, length - readIndex);
+                    addTap(erSum, line + readIndex, tapGains[tap], first);
+                    addTap(erSum + first, line, tapGains[tap], n - first);
                 }
+            }
 
-                // Add ER to signal
-                float dry = buffer.getSample(ch, sample);
-                buffer.setSample(ch, sample, dry + erSum * level);
+            // Add ER to signal
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* out = output.getWritePointer(ch, offset);
+                const float* in = input.getReadPointer(ch, offset);
+                if (out != in)
+                    std::copy(in, in + n, out);
+
+                kernels->addWithMultiply(out, scratch[ch].data(), level, n);
             }
 
-            writeIndex = (writeIndex + 1) % static_cast<int>(delayBuffer[0].size());
+            for (int ch = numChannels; ch < numOutputChannels; ++ch)
+                output.copyFrom(ch, offset, output, 0, offset, n);
+
+            writeIndex = (writeIndex + n) % length;
         }
     }
 
-private:
-    void updateTapTimes()
+    void writeSamples(float* dest, const float* source, int numSamples)
     {
-        // Base tap times in ms (simulating room reflections)
-        const std::array<float, NumTaps> baseTimes = {
-            5.0f, 8.0f, 12.0f, 17.0f, 23.0f, 31.0f,
-            41.0f, 53.0f, 67.0f, 83.0f, 101.0f, 121.0f
-        };
+        std::copy(source, source + numSamples, dest);
+    }
 
+    void writeSamples(uint16_t* dest, const float* source, int numSamples)
+    {
+        kernels->floatToHalf(dest, source, numSamples);
+    }
+
+    void addTap(float* dest, const float* source, float gain, int numSamples)
+    {
+        kernels->addWithMultiply(dest, source, gain, numSamples);
+    }
+
+    void addTap(float* dest, const uint16_t* source, float gain, int numSamples)
+    {
+        kernels->addHalfWithMultiply(dest, source, gain, numSamples);
+    }
+
+    void updateTapTimes()
+    {
         // Base gains (decreasing with distance)
         const std::array<float, NumTaps> baseGains = {
             0.8f, 0.7f, 0.6f, 0.55f, 0.5f, 0.45f,
             0.4f, 0.35f, 0.3f, 0.25f, 0.2f, 0.15f
         };
 
-        float sizeScale = 0.3f + size * 1.4f; // 0.3x to 1.7x scaling
-
         for (int i = 0; i < NumTaps; ++i)
         {
-            float timeMs = baseTimes[i] * sizeScale;
-            tapDelays[i] = static_cast<int>(timeMs * sampleRate / 1000.0);
-            tapDelays[i] = juce::jlimit(1, static_cast<int>(delayBuffer[0].size()) - 1, tapDelays[i]);
+            // Never clamped at the top: the line is sized for the largest size
+            tapDelays[i] = juce::jlimit(1, juce::jmax(1, delayBuffer[0].size() - blockSize),
+                                        getTapDelay(i, size, sampleRate));
             tapGains[i] = baseGains[i];
         }
     }
@@ -130,8 +237,12 @@ private:
     float size = 0.5f;
     float level = 0.5f;
 
-    std::array<std::vector<float>, 2> delayBuffer;
+    DelayPrecision delayPrecision = DelayPrecision::Full;
+    std::array<DelayBuffer, 2> delayBuffer;
+    std::array<std::vector<float>, 2> scratch;
     int writeIndex = 0;
+    int blockSize = 1;
+    const KernelTable* kernels = &Kernels::getScalar();
 
     std::array<int, NumTaps> tapDelays = {};
     std::array<float, NumTaps> tapGains = {};
@@ -0,0 +1 @@
+#include "InputDiffuser.h"
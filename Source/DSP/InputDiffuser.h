@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Kernels.h"
+#include <juce_core/juce_core.h>
+#include <array>
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Input Diffuser
+ *
+ * Four short allpass stages in series between the pre-delay and the combs.
+ * Each stage multiplies the number of echoes the combs are fed, so the tail
+ * is dense from the start instead of building up from a few discrete repeats.
+ *
+ * Both channels share the stage lengths and are stored interleaved, so a
+ * stereo sample is one two-wide operation per stage. A mono input runs the
+ * stages once for both sides.
+ */
+class InputDiffuser
+{
+public:
+    static constexpr int NumStages = 4;
+
+    // Stage lengths and gains after Dattorro's plate input diffusers
+    static constexpr std::array<float, NumStages> timesMs = { 4.77f, 3.60f, 12.73f, 9.31f };
+    static constexpr std::array<float, NumStages> gains = { 0.75f, 0.75f, 0.625f, 0.625f };
+
+    InputDiffuser() = default;
+
+    static int getStageLength(int stage, double sampleRate)
+    {
+        return juce::jmax(1, static_cast<int>(timesMs[static_cast<size_t>(stage)] * sampleRate / 1000.0));
+    }
+
+    void prepare(double sampleRate)
+    {
+        for (int i = 0; i < NumStages; ++i)
+        {
+            auto& stage = stages[static_cast<size_t>(i)];
+            stage.length = getStageLength(i, sampleRate);
+            stage.gain = gains[static_cast<size_t>(i)];
+            stage.frames.assign(static_cast<size_t>(stage.length) * 2, 0.0f);
+            stage.frames.shrink_to_fit();
+            stage.index = 0;
+        }
+    }
+
+    // Bytes of delay memory held
+    size_t getMemoryFootprint() const
+    {
+        size_t numFloats = 0;
+        for (const auto& stage : stages)
+            numFloats += stage.frames.capacity();
+
+        return numFloats * sizeof(float);
+    }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+        {
+            std::fill(stage.frames.begin(), stage.frames.end(), 0.0f);
+            stage.index = 0;
+        }
+    }
+
+    bool isFinite() const
+    {
+        for (const auto& stage : stages)
+            if (!Kernels::get().isFinite(stage.frames.data(), static_cast<int>(stage.frames.size())))
+                return false;
+
+        return true;
+    }
+
+    void process(float& left, float& right)
+    {
+        float io[2] = { left, right };
+
+        for (auto& stage : stages)
+        {
+            float* frame = stage.frames.data() + stage.index * 2;
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                const float delayed = frame[ch];
+                const float v = io[ch] + stage.gain * delayed;
+                io[ch] = delayed - stage.gain * v;
+                frame[ch] = v;
+            }
+
+            if (++stage.index == stage.length)
+                stage.index = 0;
+        }
+
+        left = io[0];
+        right = io[1];
+    }
+
+    // Mono input: only the first channel of each stage is used
+    float process(float input)
+    {
+        for (auto& stage : stages)
+        {
+            float* frame = stage.frames.data() + stage.index * 2;
+
+            const float delayed = frame[0];
+            const float v = input + stage.gain * delayed;
+            input = delayed - stage.gain * v;
+            frame[0] = v;
+
+            if (++stage.index == stage.length)
+                stage.index = 0;
+        }
+
+        return input;
+    }
+
+private:
+    struct Stage
+    {
+        std::vector<float> frames;   // interleaved left/right
+        int length = 1;
+        int index = 0;
+        float gain = 0.0f;
+    };
+
+    std::array<Stage, NumStages> stages;
+};
+
+} // namespace Aura
@@ -0,0 +1,122 @@
+#include "Kernels.h"
+#include "DelayBuffer.h"
+#include <juce_core/juce_core.h>
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <cpuid.h>
+ #endif
+#endif
+
+namespace Aura
+{
+
+namespace
+{
+    // The AVX2 table converts half floats with F16C. Every AVX2 CPU has it,
+    // but a hypervisor can mask it, and juce::SystemStats doesn't report it.
+    bool hasF16C()
+    {
+       #if JUCE_INTEL
+        constexpr unsigned int f16cBit = 1u << 29;     // CPUID leaf 1, ECX
+
+       #if JUCE_MSVC
+        int info[4] = {};
+        __cpuid(info, 1);
+        return (static_cast<unsigned int>(info[2]) & f16cBit) != 0;
+       #else
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        return __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 && (ecx & f16cBit) != 0;
+       #endif
+       #else
+        return false;
+       #endif
+    }
+
+    void addWithMultiplyScalar(float* dest, const float* source, float gain, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] += source[i] * gain;
+    }
+
+    void mixRampScalar(float* io, const float* wet, int numSamples,
+                       float dryStart, float dryStep, float wetStart, float wetStep)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float t = static_cast<float>(i);
+            io[i] = io[i] * (dryStart + dryStep * t) + wet[i] * (wetStart + wetStep * t);
+        }
+    }
+
+    const KernelTable scalarTable { "Scalar", addWithMultiplyScalar, mixRampScalar,
+                                    Kernels::floatToHalfScalar, Kernels::addHalfWithMultiplyScalar,
+                                    Kernels::isFiniteScalar };
+
+    // Widest first
+    std::vector<const KernelTable*> getSupported()
+    {
+        std::vector<const KernelTable*> tables;
+
+        if (auto* table = Kernels::getAVX512(); table != nullptr && juce::SystemStats::hasAVX512F())
+            tables.push_back(table);
+        if (auto* table = Kernels::getAVX2(); table != nullptr && juce::SystemStats::hasAVX2() && hasF16C())
+            tables.push_back(table);
+        if (auto* table = Kernels::getSSE2(); table != nullptr && juce::SystemStats::hasSSE2())
+            tables.push_back(table);
+        if (auto* table = Kernels::getNEON(); table != nullptr && juce::SystemStats::hasNeon())
+            tables.push_back(table);
+
+        return tables;
+    }
+}
+
+void Kernels::floatToHalfScalar(uint16_t* dest, const float* source, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] = HalfFloat::fromFloat(source[i]);
+}
+
+void Kernels::addHalfWithMultiplyScalar(float* dest, const uint16_t* source, float gain, int numSamples)
+{
+    for (int i = 0; i < numSamples; ++i)
+        dest[i] += HalfFloat::toFloat(source[i]) * gain;
+}
+
+bool Kernels::isFiniteScalar(const float* data, int numSamples)
+{
+    constexpr uint32_t exponentMask = 0x7f800000u;
+    uint32_t nonFinite = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+        nonFinite |= (HalfFloat::toBits(data[i]) & exponentMask) == exponentMask ? 1u : 0u;
+
+    return nonFinite == 0;
+}
+
+const KernelTable& Kernels::getScalar()
+{
+    return scalarTable;
+}
+
+const KernelTable& Kernels::get()
+{
+    static const KernelTable& selected = []() -> const KernelTable&
+    {
+        auto supported = getSupported();
+        return supported.empty() ? scalarTable : *supported.front();
+    }();
+
+    return selected;
+}
+
+std::vector<const KernelTable*> Kernels::getAvailable()
+{
+    auto tables = getSupported();
+    tables.insert(tables.begin(), &scalarTable);
+    return tables;
+}
+
+} // namespace Aura
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * DSP Kernels
+ *
+ * The block loops of the engine, compiled once per instruction set and
+ * picked at runtime, so one binary uses AVX-512 on the render nodes and
+ * still runs on any x86-64 or ARM machine.
+ *
+ * Each variant lives in its own translation unit built with that ISA's
+ * compiler flags (see CMakeLists.txt). Those files include nothing but this
+ * header and the intrinsics headers, so no inline code compiled for a newer
+ * ISA can be shared with the rest of the program. The variants use separate
+ * multiplies and adds, never FMA, so they produce the same results as the
+ * scalar reference.
+ */
+struct KernelTable
+{
+    const char* name;
+
+    // dest[i] += source[i] * gain
+    void (*addWithMultiply)(float* dest, const float* source, float gain, int numSamples);
+
+    // io[i] = io[i] * (dryStart + dryStep * i) + wet[i] * (wetStart + wetStep * i)
+    void (*mixRamp)(float* io, const float* wet, int numSamples,
+                    float dryStart, float dryStep, float wetStart, float wetStep);
+
+    // dest[i] = source[i] in half precision, rounded to nearest even
+    void (*floatToHalf)(uint16_t* dest, const float* source, int numSamples);
+
+    // dest[i] += source[i] * gain, with the source in half precision
+    void (*addHalfWithMultiply)(float* dest, const uint16_t* source, float gain, int numSamples);
+
+    // false if any of data[i] is NaN or infinite. Tests the exponent bits, so
+    // it holds under any floating point flags.
+    bool (*isFinite)(const float* data, int numSamples);
+};
+
+namespace Kernels
+{
+    // The fastest table this CPU supports, chosen on first use
+    const KernelTable& get();
+
+    // Every table this CPU can run, scalar first
+    std::vector<const KernelTable*> getAvailable();
+
+    const KernelTable& getScalar();
+
+    // nullptr where this build has no such variant
+    const KernelTable* getSSE2();
+    const KernelTable* getAVX2();
+    const KernelTable* getAVX512();
+    const KernelTable* getNEON();
+
+    // Portable half precision conversion, for the tails of the vector loops
+    // and for variants without conversion instructions
+    void floatToHalfScalar(uint16_t* dest, const float* source, int numSamples);
+    void addHalfWithMultiplyScalar(float* dest, const uint16_t* source, float gain, int numSamples);
+
+    bool isFiniteScalar(const float* data, int numSamples);
+}
+
+} // namespace Aura
@@ -0,0 +1,107 @@
+#include "Kernels.h"
+
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+namespace Aura
+{
+
+namespace
+{
+    void addWithMultiply(float* dest, const float* source, float gain, int numSamples)
+    {
+        const __m256 g = _mm256_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256 product = _mm256_mul_ps(_mm256_loadu_ps(source + i), g);
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), product));
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] += source[i] * gain;
+    }
+
+    void mixRamp(float* io, const float* wet, int numSamples,
+                 float dryStart, float dryStep, float wetStart, float wetStep)
+    {
+        const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        const __m256 d0 = _mm256_set1_ps(dryStart), dStep = _mm256_set1_ps(dryStep);
+        const __m256 w0 = _mm256_set1_ps(wetStart), wStep = _mm256_set1_ps(wetStep);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256 t = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lane);
+            const __m256 dryGain = _mm256_add_ps(d0, _mm256_mul_ps(dStep, t));
+            const __m256 wetGain = _mm256_add_ps(w0, _mm256_mul_ps(wStep, t));
+            const __m256 mixed = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(io + i), dryGain),
+                                               _mm256_mul_ps(_mm256_loadu_ps(wet + i), wetGain));
+            _mm256_storeu_ps(io + i, mixed);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const float t = static_cast<float>(i);
+            io[i] = io[i] * (dryStart + dryStep * t) + wet[i] * (wetStart + wetStep * t);
+        }
+    }
+
+    // F16C; Kernels.cpp only picks this table where CPUID reports it
+    void floatToHalf(uint16_t* dest, const float* source, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                             _mm256_cvtps_ph(_mm256_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT));
+
+        Kernels::floatToHalfScalar(dest + i, source + i, numSamples - i);
+    }
+
+    void addHalfWithMultiply(float* dest, const uint16_t* source, float gain, int numSamples)
+    {
+        const __m256 g = _mm256_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256 samples = _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+            _mm256_storeu_ps(dest + i, _mm256_add_ps(_mm256_loadu_ps(dest + i), _mm256_mul_ps(samples, g)));
+        }
+
+        Kernels::addHalfWithMultiplyScalar(dest + i, source + i, gain, numSamples - i);
+    }
+
+    bool isFinite(const float* data, int numSamples)
+    {
+        const __m256i exponentMask = _mm256_set1_epi32(0x7f800000);
+        __m256i nonFinite = _mm256_setzero_si256();
+        int i = 0;
+
+        for (; i + 8 <= numSamples; i += 8)
+        {
+            const __m256i exponent = _mm256_and_si256(_mm256_castps_si256(_mm256_loadu_ps(data + i)), exponentMask);
+            nonFinite = _mm256_or_si256(nonFinite, _mm256_cmpeq_epi32(exponent, exponentMask));
+        }
+
+        return _mm256_movemask_epi8(nonFinite) == 0 && Kernels::isFiniteScalar(data + i, numSamples - i);
+    }
+
+    const KernelTable table { "AVX2", addWithMultiply, mixRamp, floatToHalf, addHalfWithMultiply, isFinite };
+}
+
+const KernelTable* Kernels::getAVX2() { return &table; }
+
+} // namespace Aura
+
+#else
+
+namespace Aura
+{
+const KernelTable* Kernels::getAVX2() { return nullptr; }
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "Kernels.h"
+
+#if defined(__AVX512F__)
+
+#include <immintrin.h>
+
+namespace Aura
+{
+
+namespace
+{
+    void addWithMultiply(float* dest, const float* source, float gain, int numSamples)
+    {
+        const __m512 g = _mm512_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const __m512 product = _mm512_mul_ps(_mm512_loadu_ps(source + i), g);
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(_mm512_loadu_ps(dest + i), product));
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] += source[i] * gain;
+    }
+
+    void mixRamp(float* io, const float* wet, int numSamples,
+                 float dryStart, float dryStep, float wetStart, float wetStep)
+    {
+        const __m512 lane = _mm512_set_ps(15.0f, 14.0f, 13.0f, 12.0f, 11.0f, 10.0f, 9.0f, 8.0f,
+                                         7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+        const __m512 d0 = _mm512_set1_ps(dryStart), dStep = _mm512_set1_ps(dryStep);
+        const __m512 w0 = _mm512_set1_ps(wetStart), wStep = _mm512_set1_ps(wetStep);
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const __m512 t = _mm512_add_ps(_mm512_set1_ps(static_cast<float>(i)), lane);
+            const __m512 dryGain = _mm512_add_ps(d0, _mm512_mul_ps(dStep, t));
+            const __m512 wetGain = _mm512_add_ps(w0, _mm512_mul_ps(wStep, t));
+            const __m512 mixed = _mm512_add_ps(_mm512_mul_ps(_mm512_loadu_ps(io + i), dryGain),
+                                               _mm512_mul_ps(_mm512_loadu_ps(wet + i), wetGain));
+            _mm512_storeu_ps(io + i, mixed);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const float t = static_cast<float>(i);
+            io[i] = io[i] * (dryStart + dryStep * t) + wet[i] * (wetStart + wetStep * t);
+        }
+    }
+
+    void floatToHalf(uint16_t* dest, const float* source, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                                _mm512_cvtps_ph(_mm512_loadu_ps(source + i), _MM_FROUND_TO_NEAREST_INT));
+
+        Kernels::floatToHalfScalar(dest + i, source + i, numSamples - i);
+    }
+
+    void addHalfWithMultiply(float* dest, const uint16_t* source, float gain, int numSamples)
+    {
+        const __m512 g = _mm512_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const __m512 samples = _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)));
+            _mm512_storeu_ps(dest + i, _mm512_add_ps(_mm512_loadu_ps(dest + i), _mm512_mul_ps(samples, g)));
+        }
+
+        Kernels::addHalfWithMultiplyScalar(dest + i, source + i, gain, numSamples - i);
+    }
+
+    bool isFinite(const float* data, int numSamples)
+    {
+        const __m512i exponentMask = _mm512_set1_epi32(0x7f800000);
+        __mmask16 nonFinite = 0;
+        int i = 0;
+
+        for (; i + 16 <= numSamples; i += 16)
+        {
+            const __m512i exponent = _mm512_and_si512(_mm512_castps_si512(_mm512_loadu_ps(data + i)), exponentMask);
+            nonFinite = static_cast<__mmask16>(nonFinite | _mm512_cmpeq_epi32_mask(exponent, exponentMask));
+        }
+
+        return nonFinite == 0 && Kernels::isFiniteScalar(data + i, numSamples - i);
+    }
+
+    const KernelTable table { "AVX-512", addWithMultiply, mixRamp, floatToHalf, addHalfWithMultiply, isFinite };
+}
+
+const KernelTable* Kernels::getAVX512() { return &table; }
+
+} // namespace Aura
+
+#else
+
+namespace Aura
+{
+const KernelTable* Kernels::getAVX512() { return nullptr; }
+}
+
+#endif
@@ -0,0 +1,114 @@
+#include "Kernels.h"
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+namespace Aura
+{
+
+namespace
+{
+    void addWithMultiply(float* dest, const float* source, float gain, int numSamples)
+    {
+        const float32x4_t g = vdupq_n_f32(gain);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const float32x4_t product = vmulq_f32(vld1q_f32(source + i), g);
+            vst1q_f32(dest + i, vaddq_f32(vld1q_f32(dest + i), product));
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] += source[i] * gain;
+    }
+
+    void mixRamp(float* io, const float* wet, int numSamples,
+                 float dryStart, float dryStep, float wetStart, float wetStep)
+    {
+        const float laneOffsets[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+        const float32x4_t lane = vld1q_f32(laneOffsets);
+        const float32x4_t d0 = vdupq_n_f32(dryStart), dStep = vdupq_n_f32(dryStep);
+        const float32x4_t w0 = vdupq_n_f32(wetStart), wStep = vdupq_n_f32(wetStep);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const float32x4_t t = vaddq_f32(vdupq_n_f32(static_cast<float>(i)), lane);
+            const float32x4_t dryGain = vaddq_f32(d0, vmulq_f32(dStep, t));
+            const float32x4_t wetGain = vaddq_f32(w0, vmulq_f32(wStep, t));
+            const float32x4_t mixed = vaddq_f32(vmulq_f32(vld1q_f32(io + i), dryGain),
+                                                vmulq_f32(vld1q_f32(wet + i), wetGain));
+            vst1q_f32(io + i, mixed);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const float t = static_cast<float>(i);
+            io[i] = io[i] * (dryStart + dryStep * t) + wet[i] * (wetStart + wetStep * t);
+        }
+    }
+
+    bool isFinite(const float* data, int numSamples)
+    {
+        const uint32x4_t exponentMask = vdupq_n_u32(0x7f800000u);
+        uint32x4_t nonFinite = vdupq_n_u32(0);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const uint32x4_t exponent = vandq_u32(vreinterpretq_u32_f32(vld1q_f32(data + i)), exponentMask);
+            nonFinite = vorrq_u32(nonFinite, vceqq_u32(exponent, exponentMask));
+        }
+
+        const uint32x2_t halves = vorr_u32(vget_low_u32(nonFinite), vget_high_u32(nonFinite));
+        return (vget_lane_u32(halves, 0) | vget_lane_u32(halves, 1)) == 0
+            && Kernels::isFiniteScalar(data + i, numSamples - i);
+    }
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+    void floatToHalf(uint16_t* dest, const float* source, int numSamples)
+    {
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+            vst1_u16(dest + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(source + i))));
+
+        Kernels::floatToHalfScalar(dest + i, source + i, numSamples - i);
+    }
+
+    void addHalfWithMultiply(float* dest, const uint16_t* source, float gain, int numSamples)
+    {
+        const float32x4_t g = vdupq_n_f32(gain);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const float32x4_t samples = vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(source + i)));
+            vst1q_f32(dest + i, vaddq_f32(vld1q_f32(dest + i), vmulq_f32(samples, g)));
+        }
+
+        Kernels::addHalfWithMultiplyScalar(dest + i, source + i, gain, numSamples - i);
+    }
+
+    const KernelTable table { "NEON", addWithMultiply, mixRamp, floatToHalf, addHalfWithMultiply, isFinite };
+#else
+    // 32-bit NEON has no guaranteed half precision conversion
+    const KernelTable table { "NEON", addWithMultiply, mixRamp,
+                              Kernels::floatToHalfScalar, Kernels::addHalfWithMultiplyScalar, isFinite };
+#endif
+}
+
+const KernelTable* Kernels::getNEON() { return &table; }
+
+} // namespace Aura
+
+#else
+
+namespace Aura
+{
+const KernelTable* Kernels::getNEON() { return nullptr; }
+}
+
+#endif
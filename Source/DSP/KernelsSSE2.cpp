@@ -0,0 +1,83 @@
+#include "Kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>
+
+namespace Aura
+{
+
+namespace
+{
+    void addWithMultiply(float* dest, const float* source, float gain, int numSamples)
+    {
+        const __m128 g = _mm_set1_ps(gain);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const __m128 product = _mm_mul_ps(_mm_loadu_ps(source + i), g);
+            _mm_storeu_ps(dest + i, _mm_add_ps(_mm_loadu_ps(dest + i), product));
+        }
+
+        for (; i < numSamples; ++i)
+            dest[i] += source[i] * gain;
+    }
+
+    void mixRamp(float* io, const float* wet, int numSamples,
+                 float dryStart, float dryStep, float wetStart, float wetStep)
+    {
+        const __m128 lane = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        const __m128 d0 = _mm_set1_ps(dryStart), dStep = _mm_set1_ps(dryStep);
+        const __m128 w0 = _mm_set1_ps(wetStart), wStep = _mm_set1_ps(wetStep);
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const __m128 t = _mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lane);
+            const __m128 dryGain = _mm_add_ps(d0, _mm_mul_ps(dStep, t));
+            const __m128 wetGain = _mm_add_ps(w0, _mm_mul_ps(wStep, t));
+            const __m128 mixed = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(io + i), dryGain),
+                                            _mm_mul_ps(_mm_loadu_ps(wet + i), wetGain));
+            _mm_storeu_ps(io + i, mixed);
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            const float t = static_cast<float>(i);
+            io[i] = io[i] * (dryStart + dryStep * t) + wet[i] * (wetStart + wetStep * t);
+        }
+    }
+
+    bool isFinite(const float* data, int numSamples)
+    {
+        const __m128i exponentMask = _mm_set1_epi32(0x7f800000);
+        __m128i nonFinite = _mm_setzero_si128();
+        int i = 0;
+
+        for (; i + 4 <= numSamples; i += 4)
+        {
+            const __m128i exponent = _mm_and_si128(_mm_castps_si128(_mm_loadu_ps(data + i)), exponentMask);
+            nonFinite = _mm_or_si128(nonFinite, _mm_cmpeq_epi32(exponent, exponentMask));
+        }
+
+        return _mm_movemask_epi8(nonFinite) == 0 && Kernels::isFiniteScalar(data + i, numSamples - i);
+    }
+
+    // SSE2 has no half precision conversion
+    const KernelTable table { "SSE2", addWithMultiply, mixRamp,
+                              Kernels::floatToHalfScalar, Kernels::addHalfWithMultiplyScalar, isFinite };
+}
+
+const KernelTable* Kernels::getSSE2() { return &table; }
+
+} // namespace Aura
+
+#else
+
+namespace Aura
+{
+const KernelTable* Kernels::getSSE2() { return nullptr; }
+}
+
+#endif
@@ -0,0 +1,127 @@
+#include "OutputStage.h"
+#include <cmath>
+
+namespace Aura
+{
+
+void OutputStage::prepare(double sampleRate, int maxDryDelaySamples)
+{
+    mix.reset(sampleRate, smoothingSeconds);
+    gain.reset(sampleRate, smoothingSeconds);
+    kernels = &Kernels::get();
+
+    dryDelayBuffer.setSize(2, juce::jmax(1, maxDryDelaySamples + 1));
+    dryDelay = juce::jlimit(0, maxDryDelaySamples, dryDelay);
+
+    reset();
+}
+
+void OutputStage::reset()
+{
+    snapToTarget = true;
+    dryDelayBuffer.clear();
+    dryDelayWriteIndex = 0;
+}
+
+void OutputStage::setDryDelay(int samples)
+{
+    dryDelay = juce::jlimit(0, dryDelayBuffer.getNumSamples() - 1, samples);
+}
+
+void OutputStage::getGains(float mixValue, float gainValue, float& dryGain, float& wetGain) const
+{
+    if (mixLaw == MixLaw::EqualPower)
+    {
+        dryGain = std::cos(mixValue * juce::MathConstants<float>::halfPi) * gainValue;
+        wetGain = std::sin(mixValue * juce::MathConstants<float>::halfPi) * gainValue;
+    }
+    else
+    {
+        dryGain = (1.0f - mixValue) * gainValue;
+        wetGain = mixValue * gainValue;
+    }
+}
+
+void OutputStage::delayDry(float* dry, int channel, int numSamples)
+{
+    float* line = dryDelayBuffer.getWritePointer(channel);
+    const int length = dryDelayBuffer.getNumSamples();
+    int writeIndex = dryDelayWriteIndex;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        line[writeIndex] = dry[i];
+
+        int readIndex = writeIndex - dryDelay;
+        if (readIndex < 0) readIndex += length;
+
+        dry[i] = line[readIndex];
+        writeIndex = (writeIndex + 1) % length;
+    }
+}
+
+void OutputStage::process(juce::AudioBuffer<float>& io, const juce::AudioBuffer<float>& wet,
+                          float targetMix, float targetGain)
+{
+    const int numSamples = io.getNumSamples();
+    const int numChannels = juce::jmin(io.getNumChannels(), wet.getNumChannels());
+
+    if (snapToTarget)
+    {
+        mix.setCurrentAndTargetValue(targetMix);
+        gain.setCurrentAndTargetValue(targetGain);
+        snapToTarget = false;
+    }
+    else
+    {
+        mix.setTargetValue(targetMix);
+        gain.setTargetValue(targetGain);
+    }
+
+    float dryStart, wetStart, dryEnd, wetEnd;
+    getGains(mix.getCurrentValue(), gain.getCurrentValue(), dryStart, wetStart);
+    getGains(mix.skip(numSamples), gain.skip(numSamples), dryEnd, wetEnd);
+
+    const float dryStep = (dryEnd - dryStart) / static_cast<float>(juce::jmax(1, numSamples));
+    const float wetStep = (wetEnd - wetStart) / static_cast<float>(juce::jmax(1, numSamples));
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float* out = io.getWritePointer(ch);
+        const float* in = wet.getReadPointer(ch);
+
+        if (dryDelay > 0 && ch < dryDelayBuffer.getNumChannels())
+            delayDry(out, ch, numSamples);
+
+        kernels->mixRamp(out, in, numSamples, dryStart, dryStep, wetStart, wetStep);
+    }
+
+    if (dryDelay > 0)
+        dryDelayWriteIndex = (dryDelayWriteIndex + numSamples) % dryDelayBuffer.getNumSamples();
+}
+
+void OutputStage::processWetOnly(juce::AudioBuffer<float>& io, float targetGain)
+{
+    const int numSamples = io.getNumSamples();
+
+    if (snapToTarget)
+    {
+        gain.setCurrentAndTargetValue(targetGain);
+        snapToTarget = false;
+    }
+    else
+    {
+        gain.setTargetValue(targetGain);
+    }
+
+    mix.setCurrentAndTargetValue(1.0f);
+
+    const float gainStart = gain.getCurrentValue();
+    const float gainEnd = gain.skip(numSamples);
+
+    // The common case of a steady 0 dB output costs nothing
+    if (gainStart != 1.0f || gainEnd != 1.0f)
+        io.applyGainRamp(0, numSamples, gainStart, gainEnd);
+}
+
+} // namespace Aura
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "Kernels.h"
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Output Stage
+ *
+ * Dry/wet mix and output gain in a single pass over the block. Mix and gain
+ * are smoothed; within a block the combined dry and wet gains are ramped
+ * linearly between their values at the block edges, which keeps the inner
+ * loop a plain multiply-add run by the dispatched kernel. Blocks are at most
+ * the processor's internal sub-block, so the equal-power curve is followed
+ * closely enough.
+ *
+ * The dry path can be delayed to line up with a wet path that has latency.
+ */
+class OutputStage
+{
+public:
+    enum class MixLaw { Linear, EqualPower };
+
+    OutputStage() = default;
+
+    void prepare(double sampleRate, int maxDryDelaySamples);
+
+    // Snaps mix and gain to their targets on the next block and clears the dry delay
+    void reset();
+
+    void setMixLaw(MixLaw newLaw) { mixLaw = newLaw; }
+    MixLaw getMixLaw() const { return mixLaw; }
+
+    // Clamped to the maximum given to prepare()
+    void setDryDelay(int samples);
+    int getDryDelay() const { return dryDelay; }
+
+    // Bytes held by the dry delay line
+    size_t getMemoryFootprint() const
+    {
+        return static_cast<size_t>(dryDelayBuffer.getNumChannels() * dryDelayBuffer.getNumSamples()) * sizeof(float);
+    }
+
+    // Replaces the dry signal in io with the mix; mix is 0-1, gain is linear
+    void process(juce::AudioBuffer<float>& io, const juce::AudioBuffer<float>& wet,
+                 float targetMix, float targetGain);
+
+    // Send mode: io already holds the wet signal and only the gain is applied.
+    // The mix is held fully wet, so returning to process() ramps from there.
+    void processWetOnly(juce::AudioBuffer<float>& io, float targetGain);
+
+    static constexpr double smoothingSeconds = 0.02;
+
+private:
+    void getGains(float mixValue, float gainValue, float& dryGain, float& wetGain) const;
+    void delayDry(float* dry, int channel, int numSamples);
+
+    MixLaw mixLaw = MixLaw::Linear;
+    const KernelTable* kernels = &Kernels::getScalar();
+
+    juce::SmoothedValue<float> mix;
+    juce::SmoothedValue<float> gain;
+    bool snapToTarget = true;
+
+    juce::AudioBuffer<float> dryDelayBuffer;
+    int dryDelay = 0;
+    int dryDelayWriteIndex = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OutputStage)
+};
+
+} // namespace Aura
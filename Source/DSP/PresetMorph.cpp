@@ -0,0 +1 @@
+#include "PresetMorph.h"
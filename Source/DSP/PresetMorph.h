@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ReverbEngine.h"
+#include <array>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Preset Morph
+ *
+ * Interpolates the engine settings of two presets (A and B). The targets are
+ * resolved on the message thread and stored as a start value and a delta per
+ * continuous parameter. The feedback and filters both ends resolve to are
+ * designed there too, once per room engine, so the audio thread interpolates
+ * those as well instead of redesigning them. The room type can't be
+ * interpolated; when A and B differ the processor runs one engine per room
+ * and crossfades between them.
+ */
+class PresetMorph
+{
+public:
+    PresetMorph() = default;
+
+    // The designs are made for sampleRate; prepare() redoes them at another rate
+    void setTargets(const EngineSettings& a, float mixA, const EngineSettings& b, float mixB, double sampleRate)
+    {
+        for (size_t i = 0; i < continuousFields.size(); ++i)
+        {
+            start[i] = a.*continuousFields[i];
+            delta[i] = b.*continuousFields[i] - start[i];
+        }
+
+        mixStart = mixA;
+        mixDelta = mixB - mixA;
+        roomTypeA = a.roomType;
+        roomTypeB = b.roomType;
+        settingsA = a;
+        settingsB = b;
+        active = true;
+
+        prepare(sampleRate);
+    }
+
+    // Not for the audio thread: designs both ends for the engine of each room
+    void prepare(double sampleRate)
+    {
+        if (!active)
+            return;
+
+        auto inRoom = [](EngineSettings settings, int roomType)
+        {
+            settings.roomType = roomType;
+            return settings;
+        };
+
+        designsA = { ReverbEngine::makeDesign(inRoom(settingsA, roomTypeA), sampleRate),
+                     ReverbEngine::makeDesign(inRoom(settingsB, roomTypeA), sampleRate) };
+        designsB = { ReverbEngine::makeDesign(inRoom(settingsA, roomTypeB), sampleRate),
+                     ReverbEngine::makeDesign(inRoom(settingsB, roomTypeB), sampleRate) };
+    }
+
+    void clear() { active = false; }
+
+    bool isActive() const { return active; }
+    bool needsRoomCrossfade() const { return roomTypeA != roomTypeB; }
+
+    int getRoomTypeA() const { return roomTypeA; }
+    int getRoomTypeB() const { return roomTypeB; }
+
+    // position 0 = preset A, 1 = preset B
+    EngineSettings interpolate(float position, int roomType) const
+    {
+        EngineSettings settings;
+        settings.roomType = roomType;
+
+        for (size_t i = 0; i < continuousFields.size(); ++i)
+            settings.*continuousFields[i] = start[i] + delta[i] * position;
+
+        return settings;
+    }
+
+    // The design for the engine running roomType, which is room A's or room B's
+    RoomReverb::Design interpolateDesign(float position, int roomType) const
+    {
+        const auto& designs = roomType == roomTypeA ? designsA : designsB;
+        return RoomReverb::Design::interpolate(designs[0], designs[1], position);
+    }
+
+    float interpolateMix(float position) const { return mixStart + mixDelta * position; }
+
+private:
+    static constexpr size_t numContinuousFields = 16;
+
+    static constexpr std::array<float EngineSettings::*, numContinuousFields> continuousFields {
+        &EngineSettings::size, &EngineSettings::decay, &EngineSettings::damping,
+        &EngineSettings::preDelay, &EngineSettings::width,
+        &EngineSettings::erLevel, &EngineSettings::erSize,
+        &EngineSettings::highCut, &EngineSettings::lowCut,
+        &EngineSettings::modDepth, &EngineSettings::modRate,
+        &EngineSettings::lowDecay, &EngineSettings::midDecay, &EngineSettings::highDecay,
+        &EngineSettings::crossoverLow, &EngineSettings::crossoverHigh
+    };
+
+    std::array<float, numContinuousFields> start {};
+    std::array<float, numContinuousFields> delta {};
+    float mixStart = Defaults::mix;
+    float mixDelta = 0.0f;
+    int roomTypeA = Defaults::roomType;
+    int roomTypeB = Defaults::roomType;
+    bool active = false;
+
+    // Kept to redesign at a new sample rate
+    EngineSettings settingsA, settingsB;
+
+    // Preset A's and preset B's design, for the engine of each room
+    std::array<RoomReverb::Design, 2> designsA {}, designsB {};
+};
+
+} // namespace Aura
@@ -0,0 +1 @@
+#include "ReverbEngine.h"
@@ -0,0 +1,266 @@
+#pragma once
+
+#include "RoomReverb.h"
+#include "EarlyReflections.h"
+#include "../Utils/Parameters.h"
+#include "../Utils/Trace.h"
+#include <juce_dsp/juce_dsp.h>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Engine Settings
+ *
+ * Snapshot of every parameter that shapes the reverb engines, in the same
+ * units as the APVTS parameters. Plain values only, so a snapshot can be
+ * captured on one thread and applied on another.
+ */
+struct EngineSettings
+{
+    int roomType = Defaults::roomType;
+    float size = Defaults::size;
+    float decay = Defaults::decay;
+    float damping = Defaults::damping;
+    float preDelay = Defaults::preDelay;
+    float width = Defaults::width;
+    float erLevel = Defaults::erLevel;
+    float erSize = Defaults::erSize;
+    float highCut = Defaults::highCut;
+    float lowCut = Defaults::lowCut;
+
+    // Modulation
+    float modDepth = Defaults::modDepth;
+    float modRate = Defaults::modRate;
+
+    // Multi-band decay
+    float lowDecay = Defaults::lowDecay;
+    float midDecay = Defaults::midDecay;
+    float highDecay = Defaults::highDecay;
+    float crossoverLow = Defaults::crossoverLow;
+    float crossoverHigh = Defaults::crossoverHigh;
+
+    bool operator==(const EngineSettings& other) const
+    {
+        return roomType == other.roomType && size == other.size && decay == other.decay
+            && damping == other.damping && preDelay == other.preDelay && width == other.width
+            && erLevel == other.erLevel && erSize == other.erSize
+            && highCut == other.highCut && lowCut == other.lowCut
+            && modDepth == other.modDepth && modRate == other.modRate
+            && lowDecay == other.lowDecay && midDecay == other.midDecay && highDecay == other.highDecay
+            && crossoverLow == other.crossoverLow && crossoverHigh == other.crossoverHigh;
+    }
+
+    bool operator!=(const EngineSettings& other) const { return !(*this == other); }
+
+    // Builds a snapshot from parameter values keyed by ID; missing IDs keep their defaults
+    static EngineSettings fromValues(const juce::NamedValueSet& values)
+    {
+        EngineSettings settings;
+        auto get = [&values](const juce::String& id, float fallback)
+        {
+            return static_cast<float>(values.getWithDefault(id, fallback));
+        };
+
+        settings.roomType = juce::roundToInt(get(ParamIDs::roomType, static_cast<float>(settings.roomType)));
+        settings.size = get(ParamIDs::size, settings.size);
+        settings.decay = get(ParamIDs::decay, settings.decay);
+        settings.damping = get(ParamIDs::damping, settings.damping);
+        settings.preDelay = get(ParamIDs::preDelay, settings.preDelay);
+        settings.width = get(ParamIDs::width, settings.width);
+        settings.erLevel = get(ParamIDs::erLevel, settings.erLevel);
+        settings.erSize = get(ParamIDs::erSize, settings.erSize);
+        settings.highCut = get(ParamIDs::highCut, settings.highCut);
+        settings.lowCut = get(ParamIDs::lowCut, settings.lowCut);
+        settings.modDepth = get(ParamIDs::modDepth, settings.modDepth);
+        settings.modRate = get(ParamIDs::modRate, settings.modRate);
+        settings.lowDecay = get(ParamIDs::lowDecay, settings.lowDecay);
+        settings.midDecay = get(ParamIDs::midDecay, settings.midDecay);
+        settings.highDecay = get(ParamIDs::highDecay, settings.highDecay);
+        settings.crossoverLow = get(ParamIDs::crossoverLow, settings.crossoverLow);
+        settings.crossoverHigh = get(ParamIDs::crossoverHigh, settings.crossoverHigh);
+        return settings;
+    }
+};
+
+//==============================================================================
+/**
+ * Reverb Engine
+ *
+ * Early reflections followed by the room reverb tail. The processor keeps
+ * two of these so a preset change can be prepared on a spare engine and
+ * crossfaded in, instead of jumping the parameters of a ringing tail.
+ */
+class ReverbEngine
+{
+public:
+    ReverbEngine() = default;
+
+    void prepare(double sampleRate, int maxBlockSize)
+    {
+        reverb.prepare(sampleRate, maxBlockSize);
+        earlyReflections.prepare(sampleRate, maxBlockSize);
+
+        // Delay lengths and filter designs depend on the rate, so the next apply runs in full
+        hasApplied = false;
+    }
+
+    void reset()
+    {
+        reverb.reset();
+        earlyReflections.reset();
+    }
+
+    // Storage format of both stages' delay lines; takes effect at the next prepare
+    void setDelayPrecision(DelayPrecision precision)
+    {
+        reverb.setDelayPrecision(precision);
+        earlyReflections.setDelayPrecision(precision);
+    }
+
+    DelayPrecision getDelayPrecision() const { return reverb.getDelayPrecision(); }
+
+    // Load shedding for the CPU governor; only the tail has work worth shedding
+    void setProcessingLevel(RoomReverb::ProcessingLevel level) { reverb.setProcessingLevel(level); }
+
+    // Skipped when nothing changed: applying redesigns every filter, and the
+    // processor calls this once per sub-block
+    void apply(const EngineSettings& settings)
+    {
+        if (hasApplied && settings == applied)
+            return;
+
+        applyTo(reverb, earlyReflections, settings);
+        applied = settings;
+        hasApplied = true;
+    }
+
+    // Preset morph: takes the decay and cuts from a design interpolated by
+    // the caller and ignores those fields of the settings, so nothing is
+    // redesigned per sub-block. The multi-band fields are left as they were;
+    // the tail doesn't run the filters they design.
+    void applyMorph(const EngineSettings& settings, const RoomReverb::Design& design)
+    {
+        applyUndesignedTo(reverb, earlyReflections, settings);
+        reverb.setDesign(design);
+
+        // The design isn't what these settings would give, so the next apply runs in full
+        hasApplied = false;
+    }
+
+    // The feedback and filters the settings resolve to at a sample rate
+    static RoomReverb::Design makeDesign(const EngineSettings& settings, double sampleRate)
+    {
+        const auto room = static_cast<RoomType>(settings.roomType);
+
+        return RoomReverb::makeDesign(sampleRate,
+                                      settings.size / 100.0f * RoomPresets::getSizeMultiplier(room),
+                                      settings.decay * RoomPresets::getDecayMultiplier(room),
+                                      settings.highCut, settings.lowCut);
+    }
+
+    // Converts parameter units to DSP units and applies the room type multipliers.
+    // Templated on the tail so a BatchReverb lane is set up exactly like a RoomReverb.
+    template <typename Reverb>
+    static void applyTo(Reverb& reverb, EarlyReflections& earlyReflections, const EngineSettings& settings)
+    {
+        const auto room = static_cast<RoomType>(settings.roomType);
+
+        // Size first: the feedback setDecay designs depends on it
+        applyUndesignedTo(reverb, earlyReflections, settings);
+
+        reverb.setDecay(settings.decay * RoomPresets::getDecayMultiplier(room));
+        reverb.setHighCut(settings.highCut);
+        reverb.setLowCut(settings.lowCut);
+
+        // Multi-band decay
+        reverb.setLowDecayMultiplier(settings.lowDecay / 100.0f);   // 0.5-2.0 range
+        reverb.setMidDecayMultiplier(settings.midDecay / 100.0f);
+        reverb.setHighDecayMultiplier(settings.highDecay / 100.0f);
+        reverb.setCrossoverLow(settings.crossoverLow);
+        reverb.setCrossoverHigh(settings.crossoverHigh);
+    }
+
+    // Replaces the buffer contents with the wet signal
+    void process(juce::AudioBuffer<float>& buffer)
+    {
+        earlyReflections.process(buffer);
+        reverb.process(buffer);
+    }
+
+    // Leaves the input untouched and writes the wet signal to output, which
+    // is resized (without reallocating) to the input's channels and samples
+    void process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output)
+    {
+        process(input, output, input.getNumChannels());
+    }
+
+    // As above with numOutputChannels outputs. A mono input feeds every output:
+    // pre-delay and early reflections run once, and the tail decorrelates.
+    // Output may refer to the input's channel for in-place processing.
+    void process(const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output, int numOutputChannels)
+    {
+        output.setSize(numOutputChannels, input.getNumSamples(), false, false, true);
+
+        {
+            AURA_TRACE_SCOPE("EarlyReflections::process");
+            earlyReflections.process(input, output);
+        }
+
+        const int recoveriesBefore = reverb.getNumRecoveries();
+
+        {
+            AURA_TRACE_SCOPE("RoomReverb::process");
+            reverb.process(output, input.getNumChannels() == 1);
+        }
+
+        // The early reflections feed the tail, so a poisoned line there would
+        // trip the guard again on every block until it drained
+        if (reverb.getNumRecoveries() != recoveriesBefore && !earlyReflections.isFinite())
+            earlyReflections.reset();
+    }
+
+    float getDecayEnvelope() const { return reverb.getDecayEnvelope(); }
+
+    // Blocks the tail had to recover from a NaN or Inf
+    int getNumRecoveries() const { return reverb.getNumRecoveries(); }
+
+    // Bytes of delay memory held by both stages
+    size_t getMemoryFootprint() const
+    {
+        return reverb.getMemoryFootprint() + earlyReflections.getMemoryFootprint();
+    }
+
+    RoomReverb& getReverb() { return reverb; }
+    EarlyReflections& getEarlyReflections() { return earlyReflections; }
+
+private:
+    // Everything but the decay, cuts and multi-band decay: delay lengths,
+    // levels and rates, none of which needs a filter design
+    template <typename Reverb>
+    static void applyUndesignedTo(Reverb& reverb, EarlyReflections& earlyReflections, const EngineSettings& settings)
+    {
+        const float roomSizeMultiplier = RoomPresets::getSizeMultiplier(static_cast<RoomType>(settings.roomType));
+
+        reverb.setSize(settings.size / 100.0f * roomSizeMultiplier);
+        reverb.setDamping(settings.damping / 100.0f);
+        reverb.setPreDelay(settings.preDelay);
+        reverb.setWidth(settings.width / 100.0f);
+
+        // Modulation
+        reverb.setModulationDepth(settings.modDepth / 100.0f);
+        reverb.setModulationRate(settings.modRate / 50.0f);   // 0-2 range
+
+        earlyReflections.setSize(settings.erSize / 100.0f * roomSizeMultiplier);
+        earlyReflections.setLevel(settings.erLevel / 100.0f);
+    }
+
+    RoomReverb reverb;
+    EarlyReflections earlyReflections;
+
+    EngineSettings applied;
+    bool hasApplied = false;
+};
+
+} // namespace Aura
@@ -2,6 +2,9 @@
 
 #include "EarlyReflections.h"
 #include "DampingFilter.h"
+#include "DelayBuffer.h"
+#include "Denormals.h"
+#include "InputDiffuser.h"
 #include <juce_dsp/juce_dsp.h>
 #include <array>
 #include <vector>
@@ -66,51 +69,176 @@ public:
     static constexpr int NumAllpass = 4;
     static constexpr int NumComb = 8;
 
+    // Delay line layout. The right channel is offset slightly for decorrelation.
+    static constexpr std::array<float, NumComb> combTimesMs = {
+        25.3f, 26.9f, 28.9f, 30.7f, 32.7f, 34.4f, 36.1f, 38.6f
+    };
+    static constexpr std::array<float, NumAllpass> allpassTimesMs = { 5.0f, 1.7f, 0.6f, 0.2f };
+    static constexpr float combStereoOffsetMs = 0.5f;
+    static constexpr float allpassStereoOffsetMs = 0.1f;
+
+    // Comb length scale at size 0 and 1, and the LFO's reach either side of it
+    static constexpr float minSizeScale = 0.5f;
+    static constexpr float maxSizeScale = 1.5f;
+    static constexpr int maxModulationSamples = 10;
+
+    static constexpr float maxPreDelayMs = 200.0f;
+
+    static constexpr float allpassFeedback = 0.5f;
+
+    // Comb LFO rates at a modulation rate of 1 (different per comb for richness)
+    static constexpr std::array<float, NumComb> lfoRates = {
+        0.13f, 0.17f, 0.23f, 0.29f, 0.31f, 0.37f, 0.41f, 0.47f
+    };
+
+    // Starting LFO phase, offset between channels for stereo width
+    static float getLFOPhase(int channel, int index)
+    {
+        return static_cast<float>(channel) * 0.5f + static_cast<float>(index) * 0.125f;
+    }
+
     RoomReverb() = default;
 
-    void prepare(double sr, int maxBlockSize)
+    //==============================================================================
+    // Capacity planning: the longest delay each line can be asked for at a
+    // sample rate, so lines are allocated exactly and never clamp a setting
+
+    static int getCombDelay(int channel, int index, float size, double sr)
     {
-        sampleRate = sr;
+        const float offset = (channel == 0) ? 0.0f : combStereoOffsetMs;
+        const float sizeScale = minSizeScale + size * (maxSizeScale - minSizeScale);
+        return static_cast<int>((combTimesMs[static_cast<size_t>(index)] + offset) * sizeScale * sr / 1000.0);
+    }
+
+    // Largest size plus the full modulation swing and the interpolation tap
+    static int getCombCapacity(int channel, int index, double sr)
+    {
+        return getCombDelay(channel, index, 1.0f, sr) + maxModulationSamples + 2;
+    }
+
+    static int getAllpassDelay(int channel, int index, double sr)
+    {
+        const float offset = (channel == 0) ? 0.0f : allpassStereoOffsetMs;
+        return static_cast<int>((allpassTimesMs[static_cast<size_t>(index)] + offset) * sr / 1000.0);
+    }
+
+    static int getAllpassCapacity(int channel, int index, double sr)
+    {
+        return getAllpassDelay(channel, index, sr) + 1;
+    }
+
+    static int getPreDelayCapacity(double sr)
+    {
+        return static_cast<int>(maxPreDelayMs * sr / 1000.0) + 1;
+    }
+
+    // Bytes of delay memory held
+    size_t getMemoryFootprint() const
+    {
+        size_t bytes = inputDiffuser.getMemoryFootprint();
 
-        // Pre-delay: up to 200ms
-        int maxPreDelay = static_cast<int>(0.2 * sampleRate);
         for (int ch = 0; ch < 2; ++ch)
         {
-            preDelayBuffer[ch].resize(static_cast<size_t>(maxPreDelay));
-            std::fill(preDelayBuffer[ch].begin(), preDelayBuffer[ch].end(), 0.0f);
+            bytes += preDelayBuffer[ch].getMemoryFootprint();
+            for (const auto& line : combBuffers[ch]) bytes += line.getMemoryFootprint();
+            for (const auto& line : allpassBuffers[ch]) bytes += line.capacity() * sizeof(float);
         }
-        preDelayWriteIndex = 0;
 
-        // Initialize comb filters
-        const std::array<float, NumComb> combTimesMs = {
-            25.3f, 26.9f, 28.9f, 30.7f, 32.7f, 34.4f, 36.1f, 38.6f
+        return bytes;
+    }
+
+    // Storage of the pre-delay and comb lines, the long ones; the short
+    // allpasses stay full precision. Takes effect at the next prepare().
+    void setDelayPrecision(DelayPrecision newPrecision) { delayPrecision = newPrecision; }
+    DelayPrecision getDelayPrecision() const { return delayPrecision; }
+
+    int getCurrentCombDelay(int channel, int index) const { return combDelays[static_cast<size_t>(channel)][static_cast<size_t>(index)]; }
+
+    //==============================================================================
+    // Cheaper ways to run the tail, for the CPU governor. Each level sheds a
+    // little more work than the one before; a change is ramped over
+    // levelRampSeconds, so it never clicks.
+    enum class ProcessingLevel
+    {
+        Full = 0,
+        NoModulation,   // fixed comb delays: no LFOs, no interpolation
+        FewerLines,     // half the combs
+        MinimalLines    // a quarter of the combs
+    };
+
+    static constexpr int numProcessingLevels = 4;
+    static constexpr float levelRampSeconds = 0.05f;
+
+    // Whether a comb keeps running at a level; the survivors are spread
+    // across the range of delay times
+    static bool isCombActive(ProcessingLevel level, int index)
+    {
+        switch (level)
+        {
+            case ProcessingLevel::FewerLines:   return index % 2 == 0;
+            case ProcessingLevel::MinimalLines: return index == 0 || index == 5;
+            default:                            return true;
+        }
+    }
+
+    void setProcessingLevel(ProcessingLevel newLevel)
+    {
+        if (newLevel == processingLevel)
+            return;
+
+        processingLevel = newLevel;
+        modulationTarget = newLevel == ProcessingLevel::Full ? 1.0f : 0.0f;
+        for (int i = 0; i < NumComb; ++i)
+            combGainTargets[i] = isCombActive(newLevel, i) ? 1.0f : 0.0f;
+        levelRamping = true;
+    }
+
+    ProcessingLevel getProcessingLevel() const { return processingLevel; }
+
+    //==============================================================================
+    // Non-finite guard. A NaN or Inf in the feedback network would recirculate
+    // forever, so each block's output and comb states get one vector pass. On
+    // a hit, the lines holding non-finite samples are cleared, the block is
+    // muted and the output fades back in over recoveryRampSeconds.
+    static constexpr float recoveryRampSeconds = 0.01f;
+
+    // Blocks recovered since construction
+    int getNumRecoveries() const { return numRecoveries; }
+
+    //==============================================================================
+    void prepare(double sr, int maxBlockSize)
+    {
+        sampleRate = sr;
+
+        // Shrinking too, so a drop in sample rate gives the memory back
+        auto allocate = [](std::vector<float>& line, int length)
+        {
+            line.assign(static_cast<size_t>(length), 0.0f);
+            line.shrink_to_fit();
         };
 
+        for (int ch = 0; ch < 2; ++ch)
+            preDelayBuffer[ch].allocate(getPreDelayCapacity(sampleRate), delayPrecision);
+        preDelayWriteIndex = 0;
+
+        inputDiffuser.prepare(sampleRate);
+
+        // Initialize comb filters
         for (int ch = 0; ch < 2; ++ch)
         {
             for (int i = 0; i < NumComb; ++i)
-            {
-                float offset = (ch == 0) ? 0.0f : 0.5f;
-                int samples = static_cast<int>((combTimesMs[i] + offset) * sampleRate / 1000.0);
-                combBuffers[ch][i].resize(static_cast<size_t>(samples + 500));
-                std::fill(combBuffers[ch][i].begin(), combBuffers[ch][i].end(), 0.0f);
-                combDelays[ch][i] = samples;
-            }
+                combBuffers[ch][i].allocate(getCombCapacity(ch, i, sampleRate), delayPrecision);
             combWriteIndex[ch].fill(0);
         }
+        updateDelayTimes();
 
         // Initialize allpass filters
-        const std::array<float, NumAllpass> allpassTimesMs = { 5.0f, 1.7f, 0.6f, 0.2f };
-
         for (int ch = 0; ch < 2; ++ch)
         {
             for (int i = 0; i < NumAllpass; ++i)
             {
-                float offset = (ch == 0) ? 0.0f : 0.1f;
-                int samples = static_cast<int>((allpassTimesMs[i] + offset) * sampleRate / 1000.0);
-                allpassBuffers[ch][i].resize(static_cast<size_t>(samples + 50));
-                std::fill(allpassBuffers[ch][i].begin(), allpassBuffers[ch][i].end(), 0.0f);
-                allpassDelays[ch][i] = samples;
+                allocate(allpassBuffers[ch][i], getAllpassCapacity(ch, i, sampleRate));
+                allpassDelays[ch][i] = getAllpassDelay(ch, i, sampleRate);
             }
             allpassWriteIndex[ch].fill(0);
         }
@@ -137,19 +265,23 @@ public:
         midBandHighFilter.prepare(spec);
         highBandFilter.prepare(spec);
 
-        // Initialize LFOs for comb modulation (different rates per comb for richness)
-        const std::array<float, NumComb> lfoRates = { 0.13f, 0.17f, 0.23f, 0.29f, 0.31f, 0.37f, 0.41f, 0.47f };
+        // Initialize LFOs for comb modulation
         for (int ch = 0; ch < 2; ++ch)
         {
             for (int i = 0; i < NumComb; ++i)
             {
                 combLFOs[ch][i].prepare(sampleRate);
                 combLFOs[ch][i].setRate(lfoRates[i]);
-                // Offset phases between channels for stereo width
-                combLFOs[ch][i].setPhase(ch * 0.5f + i * 0.125f);
+                combLFOs[ch][i].setPhase(getLFOPhase(ch, i));
             }
         }
 
+        levelRampStep = 1.0f / juce::jmax(1.0f, levelRampSeconds * static_cast<float>(sampleRate));
+        snapProcessingLevel();
+
+        recoveryRampStep = 1.0f / juce::jmax(1.0f, recoveryRampSeconds * static_cast<float>(sampleRate));
+        recoveryGain = 1.0f;
+
         updateFilters();
         updateCrossoverFilters();
         updateFeedback();
@@ -159,10 +291,10 @@ public:
     {
         for (int ch = 0; ch < 2; ++ch)
         {
-            std::fill(preDelayBuffer[ch].begin(), preDelayBuffer[ch].end(), 0.0f);
+            preDelayBuffer[ch].clear();
             for (int i = 0; i < NumComb; ++i)
             {
-                std::fill(combBuffers[ch][i].begin(), combBuffers[ch][i].end(), 0.0f);
+                combBuffers[ch][i].clear();
                 dampingFilters[ch][i].reset();
             }
             for (int i = 0; i < NumAllpass; ++i)
@@ -171,8 +303,13 @@ public:
             }
         }
         preDelayWriteIndex = 0;
+        inputDiffuser.reset();
         highCutFilter.reset();
         lowCutFilter.reset();
+
+        // Nothing is ringing, so there is nothing to ramp
+        snapProcessingLevel();
+        recoveryGain = 1.0f;
     }
 
     void setSize(float s)
@@ -202,7 +339,7 @@ public:
     void setPreDelay(float ms)
     {
         preDelaySamples = static_cast<int>(ms * sampleRate / 1000.0);
-        preDelaySamples = juce::jlimit(0, static_cast<int>(preDelayBuffer[0].size()) - 1, preDelaySamples);
+        preDelaySamples = juce::jlimit(0, preDelayBuffer[0].size() - 1, preDelaySamples);
     }
 
     void setWidth(float w)
@@ -232,12 +369,11 @@ public:
     {
         modRate = juce::jlimit(0.1f, 2.0f, rate);
         // Update all LFO rates with slight variation
-        const std::array<float, NumComb> baseRates = { 0.13f, 0.17f, 0.23f, 0.29f, 0.31f, 0.37f, 0.41f, 0.47f };
         for (int ch = 0; ch < 2; ++ch)
         {
             for (int i = 0; i < NumComb; ++i)
             {
-                combLFOs[ch][i].setRate(baseRates[i] * modRate);
+                combLFOs[ch][i].setRate(lfoRates[i] * modRate);
             }
         }
     }
@@ -273,96 +409,180 @@ public:
         updateCrossoverFilters();
     }
 
+    //==============================================================================
+    // The feedback and output filter coefficients the decay and cut settings
+    // resolve to. Designing them costs a pow or tan per value, so a preset
+    // morph designs both ends ahead of time and the audio thread only
+    // interpolates. Biquads are stored normalised (a0 = 1): the stable region
+    // of (a1, a2) is convex, so a blend of two stable designs is stable too.
+    struct Design
+    {
+        using Biquad = std::array<float, 6>;
+
+        float feedback = 0.7f;
+        Biquad highCut {}, lowCut {};
+
+        static constexpr std::array<Biquad Design::*, 2> biquads { &Design::highCut, &Design::lowCut };
+
+        // t = 0 gives a exactly
+        static Design interpolate(const Design& a, const Design& b, float t)
+        {
+            Design design;
+            design.feedback = a.feedback + (b.feedback - a.feedback) * t;
+
+            for (auto biquad : biquads)
+                for (size_t i = 0; i < (design.*biquad).size(); ++i)
+                    (design.*biquad)[i] = (a.*biquad)[i] + ((b.*biquad)[i] - (a.*biquad)[i]) * t;
+
+            return design;
+        }
+    };
+
+    // Takes the units of the setters and clamps like them, so applying the
+    // design matches calling setSize, setDecay and the cut setters
+    static Design makeDesign(double sr, float size, float decay, float highCut, float lowCut)
+    {
+        using Array = juce::dsp::IIR::ArrayCoefficients<float>;
+
+        Design design;
+        design.feedback = getFeedback(juce::jlimit(0.0f, 1.0f, size), juce::jlimit(0.1f, 10.0f, decay));
+        design.highCut = normalise(Array::makeLowPass(sr, juce::jlimit(1000.0f, 20000.0f, highCut), 0.707f));
+        design.lowCut = normalise(Array::makeHighPass(sr, juce::jlimit(20.0f, 500.0f, lowCut), 0.707f));
+        return design;
+    }
+
+    // Writes a design in place: no pow, no tan and no allocation. The decay
+    // and cut settings it came from aren't stored; the next call to one of
+    // their setters redesigns from those.
+    void setDesign(const Design& design)
+    {
+        feedback = design.feedback;
+        *highCutFilter.state = design.highCut;
+        *lowCutFilter.state = design.lowCut;
+    }
+
     float getDecayEnvelope() const { return decayEnvelope; }
 
-    void process(juce::AudioBuffer<float>& buffer)
+    // With monoInput the first channel is the input for both sides: the
+    // pre-delay runs once and the combs decorrelate the two outputs
+    void process(juce::AudioBuffer<float>& buffer, bool monoInput = false)
     {
         int numSamples = buffer.getNumSamples();
         int numChannels = juce::jmin(buffer.getNumChannels(), 2);
+        const bool sharedInput = monoInput || numChannels < 2;
 
-        for (int sample = 0; sample < numSamples; ++sample)
+        // The storage format is fixed between prepare() calls, so it is
+        // picked once per block rather than per sample
+        if (preDelayBuffer[0].getPrecision() == DelayPrecision::Half)
+            processSamples<uint16_t>(buffer, numSamples, numChannels, sharedInput);
+        else
+            processSamples<float>(buffer, numSamples, numChannels, sharedInput);
+
+        // Apply output filters
+        juce::dsp::AudioBlock<float> block(buffer);
+        juce::dsp::ProcessContextReplacing<float> context(block);
+        highCutFilter.process(context);
+        lowCutFilter.process(context);
+
+        if (!isFinite(buffer, numChannels, numSamples))
+            recoverFromNonFinite(buffer);
+        else if (recoveryGain < 1.0f)
+            rampInAfterRecovery(buffer, numChannels, numSamples);
+
+        // Update decay envelope for visualization
+        float maxLevel = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            float leftIn = buffer.getSample(0, sample);
-            float rightIn = (numChannels > 1) ? buffer.getSample(1, sample) : leftIn;
+            for (int i = 0; i < numSamples; ++i)
+            {
+                maxLevel = juce::jmax(maxLevel, std::abs(buffer.getSample(ch, i)));
+            }
+        }
+        decayEnvelope = decayEnvelope * 0.95f + maxLevel * 0.05f;
+
+        Denormals::flush(decayEnvelope);
+        for (auto& channelFilters : dampingFilters)
+            for (auto& filter : channelFilters)
+                filter.snapToZero();
+    }
 
+private:
+    template <typename Sample>
+    void processSamples(juce::AudioBuffer<float>& buffer, int numSamples, int numChannels, bool sharedInput)
+    {
+        Sample* preDelay[2] = { preDelayBuffer[0].getData<Sample>(),
+                                preDelayBuffer[1].getData<Sample>() };
+        const int preDelayLength = preDelayBuffer[0].size();
+
+        for (int sample = 0; sample < numSamples; ++sample)
+        {
             // Pre-delay
-            preDelayBuffer[0][preDelayWriteIndex] = leftIn;
-            preDelayBuffer[1][preDelayWriteIndex] = rightIn;
+            storeSample(preDelay[0][preDelayWriteIndex], buffer.getSample(0, sample));
 
             int readIndex = preDelayWriteIndex - preDelaySamples;
-            if (readIndex < 0) readIndex += static_cast<int>(preDelayBuffer[0].size());
+            if (readIndex < 0) readIndex += preDelayLength;
 
-            float leftDelayed = preDelayBuffer[0][readIndex];
-            float rightDelayed = preDelayBuffer[1][readIndex];
+            // The offset keeps the diffuser, combs and allpasses from decaying
+            // into subnormals once the input goes silent
+            float leftDelayed = loadSample(preDelay[0][readIndex]) + Denormals::offset;
+            float rightDelayed = leftDelayed;
 
-            preDelayWriteIndex = (preDelayWriteIndex + 1) % static_cast<int>(preDelayBuffer[0].size());
+            if (!sharedInput)
+            {
+                storeSample(preDelay[1][preDelayWriteIndex], buffer.getSample(1, sample));
+                rightDelayed = loadSample(preDelay[1][readIndex]) + Denormals::offset;
+            }
+
+            // Raise the echo density before the combs
+            if (sharedInput)
+                rightDelayed = leftDelayed = inputDiffuser.process(leftDelayed);
+            else
+                inputDiffuser.process(leftDelayed, rightDelayed);
+
+            preDelayWriteIndex = (preDelayWriteIndex + 1) % preDelayLength;
 
             // Process comb filters in parallel with modulation
             float leftComb = 0.0f;
             float rightComb = 0.0f;
 
-            for (int i = 0; i < NumComb; ++i)
+            if (!levelRamping && processingLevel == ProcessingLevel::Full)
             {
-                // Left channel with modulation
+                for (int i = 0; i < NumComb; ++i)
                 {
-                    // Get LFO modulation value
-                    float lfoValue = combLFOs[0][i].getNext();
-                    float modOffset = lfoValue * modDepth * 10.0f;  // Max ±10 samples modulation
-
-                    int baseDelay = combDelays[0][i];
-                    float exactDelay = static_cast<float>(baseDelay) + modOffset;
-                    int delay1 = static_cast<int>(exactDelay);
-                    int delay2 = delay1 + 1;
-                    float frac = exactDelay - static_cast<float>(delay1);
-
-                    // Clamp delays
-                    delay1 = juce::jlimit(1, static_cast<int>(combBuffers[0][i].size()) - 2, delay1);
-                    delay2 = juce::jlimit(1, static_cast<int>(combBuffers[0][i].size()) - 1, delay2);
-
-                    int rIdx1 = combWriteIndex[0][i] - delay1;
-                    int rIdx2 = combWriteIndex[0][i] - delay2;
-                    if (rIdx1 < 0) rIdx1 += static_cast<int>(combBuffers[0][i].size());
-                    if (rIdx2 < 0) rIdx2 += static_cast<int>(combBuffers[0][i].size());
-
-                    // Linear interpolation for smooth modulation
-                    float delayed = combBuffers[0][i][rIdx1] * (1.0f - frac) + combBuffers[0][i][rIdx2] * frac;
-                    float filtered = dampingFilters[0][i].process(delayed);
-                    combBuffers[0][i][combWriteIndex[0][i]] = leftDelayed + filtered * feedback;
-                    combWriteIndex[0][i] = (combWriteIndex[0][i] + 1) % static_cast<int>(combBuffers[0][i].size());
-
-                    leftComb += delayed;
+                    leftComb += processComb<Sample, true>(0, i, leftDelayed, modDepth);
+                    rightComb += processComb<Sample, true>(1, i, rightDelayed, modDepth);
                 }
 
-                // Right channel with modulation
-                {
-                    float lfoValue = combLFOs[1][i].getNext();
-                    float modOffset = lfoValue * modDepth * 10.0f;
-
-                    int baseDelay = combDelays[1][i];
-                    float exactDelay = static_cast<float>(baseDelay) + modOffset;
-                    int delay1 = static_cast<int>(exactDelay);
-                    int delay2 = delay1 + 1;
-                    float frac = exactDelay - static_cast<float>(delay1);
-
-                    delay1 = juce::jlimit(1, static_cast<int>(combBuffers[1][i].size()) - 2, delay1);
-                    delay2 = juce::jlimit(1, static_cast<int>(combBuffers[1][i].size()) - 1, delay2);
-
-                    int rIdx1 = combWriteIndex[1][i] - delay1;
-                    int rIdx2 = combWriteIndex[1][i] - delay2;
-                    if (rIdx1 < 0) rIdx1 += static_cast<int>(combBuffers[1][i].size());
-                    if (rIdx2 < 0) rIdx2 += static_cast<int>(combBuffers[1][i].size());
+                leftComb /= NumComb;
+                rightComb /= NumComb;
+            }
+            else
+            {
+                if (levelRamping)
+                    advanceLevelRamp();
 
-                    float delayed = combBuffers[1][i][rIdx1] * (1.0f - frac) + combBuffers[1][i][rIdx2] * frac;
-                    float filtered = dampingFilters[1][i].process(delayed);
-                    combBuffers[1][i][combWriteIndex[1][i]] = rightDelayed + filtered * feedback;
-                    combWriteIndex[1][i] = (combWriteIndex[1][i] + 1) % static_cast<int>(combBuffers[1][i].size());
+                // Modulation fades out before the fixed-delay path takes over,
+                // which then reads exactly the same taps
+                const bool modulated = modulationGain > 0.0f;
+                const float depth = modDepth * modulationGain;
 
-                    rightComb += delayed;
+                for (int i = 0; i < NumComb; ++i)
+                {
+                    const float gain = combGains[i];
+                    if (gain <= 0.0f)
+                        continue;
+
+                    const float left = modulated ? processComb<Sample, true>(0, i, leftDelayed, depth)
+                                                 : processComb<Sample, false>(0, i, leftDelayed, depth);
+                    const float right = modulated ? processComb<Sample, true>(1, i, rightDelayed, depth)
+                                                  : processComb<Sample, false>(1, i, rightDelayed, depth);
+                    leftComb += left * gain;
+                    rightComb += right * gain;
                 }
-            }
 
-            leftComb /= NumComb;
-            rightComb /= NumComb;
+                leftComb *= combNormalisation;
+                rightComb *= combNormalisation;
+            }
 
             // Process allpass filters in series
             float leftOut = leftComb;
@@ -384,26 +604,164 @@ public:
             if (numChannels > 1)
                 buffer.setSample(1, sample, rightOut);
         }
+    }
 
-        // Apply output filters
-        juce::dsp::AudioBlock<float> block(buffer);
-        juce::dsp::ProcessContextReplacing<float> context(block);
-        highCutFilter.process(context);
-        lowCutFilter.process(context);
+    // One comb of one channel; returns the delayed sample before feedback
+    template <typename Sample, bool modulated>
+    float processComb(int ch, int i, float input, float depth)
+    {
+        auto* line = combBuffers[ch][i].getData<Sample>();
+        const int length = combBuffers[ch][i].size();
+        int& writeIndex = combWriteIndex[ch][i];
+        float delayed;
+
+        if constexpr (modulated)
+        {
+            float lfoValue = combLFOs[ch][i].getNext();
+            float modOffset = lfoValue * depth * static_cast<float>(maxModulationSamples);
+
+            int baseDelay = combDelays[ch][i];
+            float exactDelay = static_cast<float>(baseDelay) + modOffset;
+            int delay1 = static_cast<int>(exactDelay);
+            int delay2 = delay1 + 1;
+            float frac = exactDelay - static_cast<float>(delay1);
+
+            // Clamp delays
+            delay1 = juce::jlimit(1, length - 2, delay1);
+            delay2 = juce::jlimit(1, length - 1, delay2);
+
+            int rIdx1 = writeIndex - delay1;
+            int rIdx2 = writeIndex - delay2;
+            if (rIdx1 < 0) rIdx1 += length;
+            if (rIdx2 < 0) rIdx2 += length;
+
+            // Linear interpolation for smooth modulation
+            delayed = loadSample(line[rIdx1]) * (1.0f - frac) + loadSample(line[rIdx2]) * frac;
+        }
+        else
+        {
+            juce::ignoreUnused(depth);
+
+            int rIdx = writeIndex - juce::jlimit(1, length - 2, combDelays[ch][i]);
+            if (rIdx < 0) rIdx += length;
+
+            delayed = loadSample(line[rIdx]);
+        }
+
+        float filtered = dampingFilters[ch][i].process(delayed);
+        storeSample(line[writeIndex], input + filtered * feedback);
+        writeIndex = (writeIndex + 1) % length;
+
+        return delayed;
+    }
+
+    // Moves the modulation and comb gains one sample along their ramps. A comb
+    // that has faded out is cleared, so it fades back in from silence.
+    void advanceLevelRamp()
+    {
+        auto approach = [this](float value, float target)
+        {
+            return value < target ? juce::jmin(target, value + levelRampStep)
+                                  : juce::jmax(target, value - levelRampStep);
+        };
+
+        modulationGain = approach(modulationGain, modulationTarget);
+        bool done = modulationGain == modulationTarget;
+        float sumOfSquares = 0.0f;
+
+        for (int i = 0; i < NumComb; ++i)
+        {
+            const float previous = combGains[i];
+            combGains[i] = approach(previous, combGainTargets[i]);
+            done = done && combGains[i] == combGainTargets[i];
+            sumOfSquares += combGains[i] * combGains[i];
+
+            if (previous > 0.0f && combGains[i] <= 0.0f)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    combBuffers[ch][i].clear();
+                    dampingFilters[ch][i].reset();
+                }
+            }
+        }
+
+        // The combs are roughly uncorrelated, so the level follows the square
+        // root of the number running; at full strength this is 1 / NumComb
+        combNormalisation = sumOfSquares > 0.0f ? 1.0f / std::sqrt(static_cast<float>(NumComb) * sumOfSquares) : 0.0f;
+        levelRamping = !done;
+    }
+
+    bool isFinite(const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) const
+    {
+        const auto& kernels = Kernels::get();
 
-        // Update decay envelope for visualization
-        float maxLevel = 0.0f;
         for (int ch = 0; ch < numChannels; ++ch)
+            if (!kernels.isFinite(buffer.getReadPointer(ch), numSamples))
+                return false;
+
+        // A state that has blown up may not have reached the output yet
+        for (const auto& channelFilters : dampingFilters)
+            for (const auto& filter : channelFilters)
+                if (!filter.isFinite())
+                    return false;
+
+        return true;
+    }
+
+    // Clears only what holds a non-finite sample; a clean line keeps ringing
+    void recoverFromNonFinite(juce::AudioBuffer<float>& buffer)
+    {
+        ++numRecoveries;
+
+        for (int ch = 0; ch < 2; ++ch)
         {
-            for (int i = 0; i < numSamples; ++i)
+            if (!preDelayBuffer[ch].isFinite())
+                preDelayBuffer[ch].clear();
+
+            for (int i = 0; i < NumComb; ++i)
             {
-                maxLevel = juce::jmax(maxLevel, std::abs(buffer.getSample(ch, i)));
+                if (!combBuffers[ch][i].isFinite() || !dampingFilters[ch][i].isFinite())
+                {
+                    combBuffers[ch][i].clear();
+                    dampingFilters[ch][i].reset();
+                }
             }
+
+            for (auto& line : allpassBuffers[ch])
+                if (!Kernels::get().isFinite(line.data(), static_cast<int>(line.size())))
+                    std::fill(line.begin(), line.end(), 0.0f);
         }
-        decayEnvelope = decayEnvelope * 0.95f + maxLevel * 0.05f;
+
+        if (!inputDiffuser.isFinite())
+            inputDiffuser.reset();
+
+        // The output filters ran on the bad block, so their state is suspect
+        highCutFilter.reset();
+        lowCutFilter.reset();
+
+        buffer.clear();
+        recoveryGain = 0.0f;
+    }
+
+    void rampInAfterRecovery(juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+    {
+        const float endGain = juce::jmin(1.0f, recoveryGain + recoveryRampStep * static_cast<float>(numSamples));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.applyGainRamp(ch, 0, numSamples, recoveryGain, endGain);
+
+        recoveryGain = endGain;
+    }
+
+    void snapProcessingLevel()
+    {
+        modulationGain = modulationTarget;
+        combGains = combGainTargets;
+        levelRamping = true;
+        advanceLevelRamp();
     }
 
-private:
     float processAllpass(int ch, int index, float input)
     {
         int delay = allpassDelays[ch][index];
@@ -421,49 +779,59 @@ private:
 
     void updateDelayTimes()
     {
-        float sizeScale = 0.5f + size * 1.0f;
-
-        const std::array<float, NumComb> baseCombMs = {
-            25.3f, 26.9f, 28.9f, 30.7f, 32.7f, 34.4f, 36.1f, 38.6f
-        };
-
         for (int ch = 0; ch < 2; ++ch)
         {
             for (int i = 0; i < NumComb; ++i)
             {
-                float offset = (ch == 0) ? 0.0f : 0.5f;
-                int newDelay = static_cast<int>((baseCombMs[i] + offset) * sizeScale * sampleRate / 1000.0);
-                newDelay = juce::jlimit(1, static_cast<int>(combBuffers[ch][i].size()) - 1, newDelay);
-                combDelays[ch][i] = newDelay;
+                // The capacity covers size 1, so the top clamp never engages
+                const int maxDelay = combBuffers[ch][i].size() - maxModulationSamples - 2;
+                combDelays[ch][i] = juce::jlimit(1, juce::jmax(1, maxDelay), getCombDelay(ch, i, size, sampleRate));
             }
         }
     }
 
-    void updateFeedback()
+    // Feedback for the desired RT60
+    static float getFeedback(float size, float decay)
     {
-        // Calculate feedback for desired RT60
         float avgDelaySec = 0.030f * (0.5f + size);
-        feedback = std::pow(10.0f, -3.0f * avgDelaySec / decay);
-        feedback = juce::jlimit(0.0f, 0.98f, feedback);
+        return juce::jlimit(0.0f, 0.98f, std::pow(10.0f, -3.0f * avgDelaySec / decay));
+    }
+
+    // Scaled the way Coefficients scales on assignment, so assigning the
+    // result gives the same coefficients as assigning the unnormalised design
+    static Design::Biquad normalise(Design::Biquad coefficients)
+    {
+        const float a0Inv = 1.0f / coefficients[3];
+        for (auto& c : coefficients)
+            c *= a0Inv;
+        coefficients[3] = 1.0f;
+        return coefficients;
+    }
+
+    void updateFeedback()
+    {
+        feedback = getFeedback(size, decay);
     }
 
+    // Coefficients are written in place; called from apply() on the audio thread,
+    // so no new Coefficients objects may be allocated here
     void updateFilters()
     {
-        *highCutFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+        *highCutFilter.state = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
             sampleRate, highCutFreq, 0.707f);
-        *lowCutFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+        *lowCutFilter.state = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
             sampleRate, lowCutFreq, 0.707f);
     }
 
     void updateCrossoverFilters()
     {
-        *lowBandFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+        *lowBandFilter.state = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
             sampleRate, crossoverLowFreq, 0.707f);
-        *midBandLowFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+        *midBandLowFilter.state = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
             sampleRate, crossoverLowFreq, 0.707f);
-        *midBandHighFilter.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(
+        *midBandHighFilter.state = juce::dsp::IIR::ArrayCoefficients<float>::makeLowPass(
             sampleRate, crossoverHighFreq, 0.707f);
-        *highBandFilter.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(
+        *highBandFilter.state = juce::dsp::IIR::ArrayCoefficients<float>::makeHighPass(
             sampleRate, crossoverHighFreq, 0.707f);
     }
 
@@ -490,14 +858,31 @@ private:
     float crossoverLowFreq = 200.0f;
     float crossoverHighFreq = 4000.0f;
 
-    static constexpr float allpassFeedback = 0.5f;
+    DelayPrecision delayPrecision = DelayPrecision::Full;
+
+    // Processing level, ramped per sample while it changes
+    ProcessingLevel processingLevel = ProcessingLevel::Full;
+    bool levelRamping = false;
+    float levelRampStep = 1.0f;
+    float modulationGain = 1.0f;
+    float modulationTarget = 1.0f;
+    std::array<float, NumComb> combGains = { 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    std::array<float, NumComb> combGainTargets = combGains;
+    float combNormalisation = 1.0f / NumComb;
+
+    // Non-finite guard
+    int numRecoveries = 0;
+    float recoveryGain = 1.0f;
+    float recoveryRampStep = 1.0f;
 
     // Pre-delay
-    std::array<std::vector<float>, 2> preDelayBuffer;
+    std::array<DelayBuffer, 2> preDelayBuffer;
     int preDelayWriteIndex = 0;
 
+    InputDiffuser inputDiffuser;
+
     // Comb filters
-    std::array<std::array<std::vector<float>, NumComb>, 2> combBuffers;
+    std::array<std::array<DelayBuffer, NumComb>, 2> combBuffers;
     std::array<std::array<int, NumComb>, 2> combDelays = {};
     std::array<std::array<int, NumComb>, 2> combWriteIndex = {};
     std::array<std::array<DampingFilter, NumComb>, 2> dampingFilters;
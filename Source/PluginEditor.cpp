@@ -33,6 +33,7 @@ AuraEditor::AuraEditor(AuraProcessor& p)
     }
 
     setLookAndFeel(&lookAndFeel);
+    setOpaque(true);
 
     // Title
     titleLabel.setText("AURA", juce::dontSendNotification);
@@ -50,13 +51,28 @@ AuraEditor::AuraEditor(AuraProcessor& p)
     // Preset selector
     addAndMakeVisible(presetSelector);
 
+    // CPU level
+    cpuLevelLabel.setFont(juce::Font(juce::FontOptions(10.0f)));
+    cpuLevelLabel.setColour(juce::Label::textColourId, AuraLookAndFeel::Colors::warm);
+    cpuLevelLabel.setJustificationType(juce::Justification::centredRight);
+    addChildComponent(cpuLevelLabel);
+
+    // Engine recoveries
+    recoveryLabel.setFont(juce::Font(juce::FontOptions(10.0f)));
+    recoveryLabel.setColour(juce::Label::textColourId, AuraLookAndFeel::Colors::warm);
+    recoveryLabel.setJustificationType(juce::Justification::centredRight);
+    addChildComponent(recoveryLabel);
+
     // Room selector
     addAndMakeVisible(roomSelector);
 
     // Visualizer
     addAndMakeVisible(visualizer);
 
-    // Section panels
+    // Section panels are static, so they are drawn once and cached
+    for (auto* section : { &mainSection, &erSection, &filterSection, &ioSection })
+        section->setBufferedToImage(true);
+
     addAndMakeVisible(mainSection);
     addAndMakeVisible(erSection);
     addAndMakeVisible(filterSection);
@@ -84,18 +100,42 @@ AuraEditor::AuraEditor(AuraProcessor& p)
     addAndMakeVisible(inputKnob);
     addAndMakeVisible(outputKnob);
 
+    // Preset morph
+    addAndMakeVisible(morphStrip);
+
     setSize(750, 520);
-    startTimerHz(30);
+
+    processor.getDecayAnalyser().setEnabled(true);
 }
 
 AuraEditor::~AuraEditor()
 {
-    stopTimer();
+    processor.getDecayAnalyser().setEnabled(false);
     setLookAndFeel(nullptr);
 }
 
 void AuraEditor::paint(juce::Graphics& g)
 {
+    AURA_TRACE_SCOPE("AuraEditor::paint");
+
+    const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (!background.isValid() || backgroundScale != scale)
+        renderBackground(scale);
+
+    g.drawImage(background, getLocalBounds().toFloat());
+}
+
+void AuraEditor::renderBackground(float scale)
+{
+    backgroundScale = scale;
+    background = juce::Image(juce::Image::ARGB,
+                             juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                             juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+                             true);
+
+    juce::Graphics g(background);
+    g.addTransform(juce::AffineTransform::scale(scale));
+
     // Background gradient
     juce::ColourGradient bgGradient(
         AuraLookAndFeel::Colors::bgDark, 0, 0,
@@ -146,6 +186,8 @@ void AuraEditor::paint(juce::Graphics& g)
 
 void AuraEditor::resized()
 {
+    background = {};
+
     const int margin = 12;
     const int headerHeight = 60;
     const int spacing = 10;
@@ -164,6 +206,9 @@ void AuraEditor::resized()
     auto presetArea = headerArea.removeFromRight(220).reduced(16, 14);
     presetSelector.setBounds(presetArea);
 
+    cpuLevelLabel.setBounds(headerArea.removeFromRight(100).reduced(0, 20));
+    recoveryLabel.setBounds(headerArea.removeFromRight(100).reduced(0, 20));
+
     bounds.removeFromTop(spacing);
 
     // ===== MAIN CONTENT =====
@@ -252,10 +297,27 @@ void AuraEditor::resized()
     int ioKnobX = ioContent.getX() + (ioContent.getWidth() - smallKnobSize * 2 - knobSpacing) / 2;
     inputKnob.setBounds(ioKnobX, ioContent.getY(), smallKnobSize, smallKnobSize + 14);
     outputKnob.setBounds(ioKnobX + smallKnobSize + knobSpacing, ioContent.getY(), smallKnobSize, smallKnobSize + 14);
+
+    // ===== MORPH STRIP =====
+    contentArea.removeFromTop(spacing);
+    morphStrip.setBounds(contentArea.removeFromTop(28));
 }
 
-void AuraEditor::timerCallback()
+void AuraEditor::updateVisualizers()
 {
+    // Display refresh can be 120 Hz or more; the visualizers don't need that
+    auto now = juce::Time::getMillisecondCounterHiRes();
+    if (now - lastVisualizerUpdateMs < visualizerIntervalMs)
+        return;
+
+    lastVisualizerUpdateMs = now;
+    AURA_TRACE_SCOPE("AuraEditor::updateVisualizers");
+
+    auto& analyser = processor.getDecayAnalyser();
+    if (analyser.process())
+        visualizer.setMeasuredDecay(analyser.getLatest());
+
+    // The visualizer only repaints if one of these visibly changed
     auto& apvts = processor.getAPVTS();
     float decayVal = apvts.getRawParameterValue(ParamIDs::decay)->load();
     int roomType = static_cast<int>(apvts.getRawParameterValue(ParamIDs::roomType)->load());
@@ -263,6 +325,22 @@ void AuraEditor::timerCallback()
     visualizer.setDecayLevel(processor.getDecayEnvelope());
     visualizer.setDecayTime(decayVal);
     visualizer.setRoomType(roomType);
+
+    const int cpuLevel = processor.getCpuLevel();
+    if (cpuLevel != shownCpuLevel)
+    {
+        shownCpuLevel = cpuLevel;
+        cpuLevelLabel.setText("CPU: " + CpuLevels::names[cpuLevel], juce::dontSendNotification);
+        cpuLevelLabel.setVisible(cpuLevel > 0);
+    }
+
+    const int recoveries = processor.getNumEngineRecoveries();
+    if (recoveries != shownRecoveries)
+    {
+        shownRecoveries = recoveries;
+        recoveryLabel.setText("NaN RESETS: " + juce::String(recoveries), juce::dontSendNotification);
+        recoveryLabel.setVisible(recoveries > 0);
+    }
 }
 
 } // namespace Aura
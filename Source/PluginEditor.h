@@ -65,25 +65,116 @@ private:
 /**
  * Enhanced Decay Visualizer
  *
- * Larger, more prominent visualization with decay curve and level meter
+ * Larger, more prominent visualization with decay curve and level meter.
+ * Shows the decay predicted from the parameters until the analyser has
+ * measured a real one, then the measured energy decay curve and RT60s.
+ * The background is rendered once per size into an image, and the curve is
+ * only rebuilt when the decay, the level or the room type visibly change.
+ * There is no timer; the editor pushes new values and this repaints on change.
  */
-class EnhancedVisualizer : public juce::Component,
-                           public juce::Timer
+class EnhancedVisualizer : public juce::Component
 {
 public:
     EnhancedVisualizer()
     {
-        startTimerHz(30);
+        setOpaque(false);
     }
 
-    void setDecayLevel(float level) { currentLevel = level; }
-    void setDecayTime(float seconds) { decayTime = seconds; }
-    void setRoomType(int type) { roomType = type; }
+    void setDecayLevel(float level)
+    {
+        // Quantised to what the curve can show, so a steady tail doesn't repaint
+        int step = juce::roundToInt(juce::jmin(1.0f, level * 1.2f + 0.3f) * levelSteps);
+        if (step != levelStep)
+        {
+            levelStep = step;
+            invalidateCurve();
+        }
+    }
 
-    void timerCallback() override { repaint(); }
+    void setDecayTime(float seconds)
+    {
+        if (std::abs(seconds - decayTime) > 0.005f)
+        {
+            decayTime = seconds;
+            invalidateCurve();
+        }
+    }
+
+    void setRoomType(int type)
+    {
+        if (type != roomType)
+        {
+            roomType = type;
+            invalidateCurve();
+        }
+    }
+
+    void setMeasuredDecay(const DecayAnalysis& analysis)
+    {
+        if (analysis.generation == measured.generation || analysis.energyDecayCurve.empty())
+            return;
+
+        measured = analysis;
+        invalidateCurve();
+    }
+
+    void resized() override
+    {
+        background = {};
+        invalidateCurve();
+    }
 
     void paint(juce::Graphics& g) override
     {
+        auto bounds = getLocalBounds().toFloat().reduced(2.0f);
+
+        const float scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        if (!background.isValid() || backgroundScale != scale)
+            renderBackground(scale);
+
+        g.drawImage(background, getLocalBounds().toFloat());
+
+        if (curveDirty)
+            rebuildCurve(bounds);
+
+        // Time markers
+        g.setFont(juce::Font(juce::FontOptions(9.0f)));
+        g.setColour(AuraLookAndFeel::Colors::textDim.withAlpha(0.6f));
+        g.drawText(juce::String(curveSeconds, 1) + "s", static_cast<int>(bounds.getRight() - 30), static_cast<int>(bounds.getBottom() - 14), 28, 12, juce::Justification::right);
+
+        if (rt60Text.isNotEmpty())
+        {
+            g.setColour(AuraLookAndFeel::Colors::textDim);
+            g.drawText(rt60Text, bounds.reduced(8, 4).removeFromTop(12), juce::Justification::centredRight);
+        }
+
+        g.setGradientFill(curveFill);
+        g.fillPath(curve);
+
+        // Curve outline with glow
+        g.setColour(AuraLookAndFeel::Colors::primaryLight.withAlpha(0.8f));
+        g.strokePath(curve, juce::PathStrokeType(2.0f));
+    }
+
+private:
+    void invalidateCurve()
+    {
+        curveDirty = true;
+        repaint();
+    }
+
+    // Everything that doesn't depend on the values: fill, grid, border and labels
+    void renderBackground(float scale)
+    {
+        backgroundScale = scale;
+        background = juce::Image(juce::Image::ARGB,
+                                 juce::jmax(1, juce::roundToInt(static_cast<float>(getWidth()) * scale)),
+                                 juce::jmax(1, juce::roundToInt(static_cast<float>(getHeight()) * scale)),
+                                 true);
+
+        juce::Graphics g(background);
+        g.addTransform(juce::AffineTransform::scale(scale));
+
         auto bounds = getLocalBounds().toFloat().reduced(2.0f);
         const float cornerRadius = 8.0f;
 
@@ -108,10 +199,24 @@ public:
         g.setFont(juce::Font(juce::FontOptions(9.0f)));
         g.setColour(AuraLookAndFeel::Colors::textDim.withAlpha(0.6f));
         g.drawText("0s", static_cast<int>(bounds.getX() + 4), static_cast<int>(bounds.getBottom() - 14), 20, 12, juce::Justification::left);
-        g.drawText(juce::String(decayTime, 1) + "s", static_cast<int>(bounds.getRight() - 30), static_cast<int>(bounds.getBottom() - 14), 28, 12, juce::Justification::right);
+
+        // Border
+        g.setColour(AuraLookAndFeel::Colors::knobRing.withAlpha(0.6f));
+        g.drawRoundedRectangle(bounds, cornerRadius, 1.0f);
+
+        // Label
+        g.setColour(AuraLookAndFeel::Colors::textDim);
+        g.setFont(juce::Font(juce::FontOptions(9.0f)));
+        g.drawText("DECAY ENVELOPE", bounds.reduced(8, 4).removeFromTop(12),
+                   juce::Justification::centredLeft);
+    }
+
+    void rebuildCurve(juce::Rectangle<float> bounds)
+    {
+        curveDirty = false;
+        curve.clear();
 
         // Decay curve
-        juce::Path curve;
         float w = bounds.getWidth() - 8;
         float h = bounds.getHeight() - 20;
         float startX = bounds.getX() + 4;
@@ -120,12 +225,30 @@ public:
         curve.startNewSubPath(startX, startY + h);
 
         float decayFactor = juce::jmax(0.1f, decayTime / 10.0f);
-        float levelScale = juce::jmin(1.0f, currentLevel * 1.2f + 0.3f);
+        float levelScale = static_cast<float>(levelStep) / levelSteps;
+
+        const auto& edc = measured.energyDecayCurve;
+        const bool useMeasured = edc.size() > 1;
+
+        curveSeconds = useMeasured ? static_cast<float>(edc.size()) * measured.frameSeconds : decayTime;
+        rt60Text = useMeasured ? formatRT60s() : juce::String();
 
         for (float x = 0; x <= w; x += 1.5f)
         {
             float t = x / w;
-            float amplitude = std::exp(-3.0f * t / decayFactor) * levelScale;
+            float amplitude;
+
+            if (useMeasured)
+            {
+                // Energy decay curve in dB, shown as amplitude like the predicted curve
+                auto index = juce::jmin(edc.size() - 1, static_cast<size_t>(t * static_cast<float>(edc.size() - 1)));
+                amplitude = juce::Decibels::decibelsToGain(edc[index] * 0.5f) * levelScale;
+            }
+            else
+            {
+                amplitude = std::exp(-3.0f * t / decayFactor) * levelScale;
+            }
+
             float y = startY + h - (h * 0.85f * amplitude);
             curve.lineTo(startX + x, y);
         }
@@ -151,34 +274,207 @@ public:
                 break;
         }
 
-        juce::ColourGradient gradient(fillColor1, startX, startY, fillColor2, startX, startY + h, false);
-        g.setGradientFill(gradient);
-        g.fillPath(curve);
-
-        // Curve outline with glow
-        g.setColour(AuraLookAndFeel::Colors::primaryLight.withAlpha(0.8f));
-        g.strokePath(curve, juce::PathStrokeType(2.0f));
+        curveFill = juce::ColourGradient(fillColor1, startX, startY, fillColor2, startX, startY + h, false);
+    }
 
-        // Border
-        g.setColour(AuraLookAndFeel::Colors::knobRing.withAlpha(0.6f));
-        g.drawRoundedRectangle(bounds, cornerRadius, 1.0f);
+    juce::String formatRT60s() const
+    {
+        auto format = [](const char* name, float seconds)
+        {
+            return std::isfinite(seconds) ? juce::String(name) + " " + juce::String(seconds, 2) + "s  " : juce::String();
+        };
 
-        // Label
-        g.setColour(AuraLookAndFeel::Colors::textDim);
-        g.setFont(juce::Font(juce::FontOptions(9.0f)));
-        g.drawText("DECAY ENVELOPE", bounds.reduced(8, 4).removeFromTop(12),
-                   juce::Justification::centredLeft);
+        return (format("RT60", measured.rt60[DecayAnalysis::Broadband])
+                + format("L", measured.rt60[DecayAnalysis::Low])
+                + format("M", measured.rt60[DecayAnalysis::Mid])
+                + format("H", measured.rt60[DecayAnalysis::High])).trimEnd();
     }
 
-private:
-    float currentLevel = 0.0f;
+    static constexpr float levelSteps = 200.0f;
+
+    int levelStep = juce::roundToInt(0.3f * levelSteps);
     float decayTime = 2.0f;
     int roomType = 1;
+
+    juce::Image background;
+    float backgroundScale = 0.0f;
+
+    DecayAnalysis measured;
+    float curveSeconds = 2.0f;
+    juce::String rt60Text;
+
+    juce::Path curve;
+    juce::ColourGradient curveFill;
+    bool curveDirty = true;
 };
 
 //==============================================================================
-class AuraEditor : public juce::AudioProcessorEditor,
-                   public juce::Timer
+/**
+ * Morph Strip
+ *
+ * Picks presets A and B for the morph, with the morph control between them.
+ * The pair lives in the processor's state, so it is saved with the session
+ * and a restored session shows it here. Off on either side ends the morph.
+ */
+class MorphStrip : public juce::Component,
+                   private juce::ChangeListener,
+                   private juce::ValueTree::Listener,
+                   private juce::AsyncUpdater
+{
+public:
+    explicit MorphStrip(AuraProcessor& p)
+        : processor(p), attachment(p.getAPVTS(), ParamIDs::morph, slider)
+    {
+        label.setText("MORPH", juce::dontSendNotification);
+        label.setFont(juce::Font(juce::FontOptions(10.0f).withStyle("Bold")));
+        label.setColour(juce::Label::textColourId, AuraLookAndFeel::Colors::textDim);
+        addAndMakeVisible(label);
+
+        for (auto* box : { &presetABox, &presetBBox })
+        {
+            box->onChange = [this]() { selectionChanged(); };
+            addAndMakeVisible(*box);
+        }
+
+        slider.setSliderStyle(juce::Slider::LinearHorizontal);
+        slider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 50, 16);
+        addAndMakeVisible(slider);
+
+        // User presets arrive from the background indexer; the pair can change
+        // with a restored session
+        processor.getPresetManager().getPresetIndexer().addChangeListener(this);
+        processor.getAPVTS().state.addListener(this);
+
+        refreshPresetLists();
+    }
+
+    ~MorphStrip() override
+    {
+        processor.getAPVTS().state.removeListener(this);
+        processor.getPresetManager().getPresetIndexer().removeChangeListener(this);
+    }
+
+    void resized() override
+    {
+        auto bounds = getLocalBounds();
+        const int boxWidth = 180;
+        const int spacing = 8;
+
+        label.setBounds(bounds.removeFromLeft(60));
+        presetABox.setBounds(bounds.removeFromLeft(boxWidth));
+        bounds.removeFromLeft(spacing);
+        presetBBox.setBounds(bounds.removeFromRight(boxWidth));
+        bounds.removeFromRight(spacing);
+        slider.setBounds(bounds);
+    }
+
+private:
+    static constexpr int offId = 1;
+    static constexpr int firstPresetId = 2;
+
+    void refreshPresetLists()
+    {
+        auto& presetManager = processor.getPresetManager();
+        auto factoryNames = presetManager.getFactoryPresetNames();
+
+        presetNames = factoryNames;
+        for (const auto& entry : presetManager.getPresetIndexer().getSnapshot().entries)
+            presetNames.add(entry.name);
+
+        for (auto* box : { &presetABox, &presetBBox })
+        {
+            box->clear(juce::dontSendNotification);
+            box->addItem("Off", offId);
+
+            for (int i = 0; i < presetNames.size(); ++i)
+            {
+                if (i == factoryNames.size())
+                    box->addSectionHeading("User");
+
+                box->addItem(presetNames[i], firstPresetId + i);
+            }
+        }
+
+        showSelection();
+    }
+
+    void showSelection()
+    {
+        const auto presetA = processor.getMorphPresetA();
+        const auto presetB = processor.getMorphPresetB();
+        const bool morphing = presetA.isNotEmpty() && presetB.isNotEmpty();
+
+        auto select = [this](juce::ComboBox& box, const juce::String& name)
+        {
+            const int index = presetNames.indexOf(name);
+            box.setSelectedId(index >= 0 ? firstPresetId + index : offId, juce::dontSendNotification);
+        };
+
+        auto isPicked = [](const juce::ComboBox& box) { return box.getSelectedId() >= firstPresetId; };
+
+        if (morphing)
+        {
+            select(presetABox, presetA);
+            select(presetBBox, presetB);
+        }
+        else if (isPicked(presetABox) && isPicked(presetBBox))
+        {
+            // A morph shown here has ended. A half-picked pair is left for the user to finish.
+            select(presetABox, {});
+            select(presetBBox, {});
+        }
+
+        slider.setEnabled(morphing);
+    }
+
+    void selectionChanged()
+    {
+        const int indexA = presetABox.getSelectedId() - firstPresetId;
+        const int indexB = presetBBox.getSelectedId() - firstPresetId;
+
+        const bool picked = juce::isPositiveAndBelow(indexA, presetNames.size())
+                         && juce::isPositiveAndBelow(indexB, presetNames.size());
+
+        // A preset deleted since the list was built can't be resolved, which ends the morph too
+        if (!picked || !processor.setMorphPresets(presetNames[indexA], presetNames[indexB]))
+            processor.clearMorphPresets();
+
+        showSelection();
+    }
+
+    void changeListenerCallback(juce::ChangeBroadcaster*) override
+    {
+        refreshPresetLists();
+    }
+
+    // Hosts may restore a session off the message thread, so the boxes follow asynchronously
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier&) override
+    {
+        if (tree == processor.getAPVTS().state)
+            triggerAsyncUpdate();
+    }
+
+    void valueTreeRedirected(juce::ValueTree&) override
+    {
+        triggerAsyncUpdate();
+    }
+
+    void handleAsyncUpdate() override
+    {
+        showSelection();
+    }
+
+    AuraProcessor& processor;
+    juce::StringArray presetNames;     // factory presets, then user presets
+
+    juce::Label label;
+    juce::ComboBox presetABox, presetBBox;
+    juce::Slider slider;
+    juce::AudioProcessorValueTreeState::SliderAttachment attachment;
+};
+
+//==============================================================================
+class AuraEditor : public juce::AudioProcessorEditor
 {
 public:
     explicit AuraEditor(AuraProcessor& p);
@@ -186,20 +482,34 @@ public:
 
     void paint(juce::Graphics&) override;
     void resized() override;
-    void timerCallback() override;
 
 private:
+    void updateVisualizers();
+    void renderBackground(float scale);
+
     AuraProcessor& processor;
     AuraLookAndFeel lookAndFeel;
 
     // Company logo
     juce::Image companyLogo;
 
+    // Gradients, header and logo, rendered once per size
+    juce::Image background;
+    float backgroundScale = 0.0f;
+
     // Header components
     juce::Label titleLabel;
     juce::Label subtitleLabel;
     PresetSelector presetSelector { processor.getPresetManager() };
 
+    // Shown only while the CPU governor has reduced the quality
+    juce::Label cpuLevelLabel;
+    int shownCpuLevel = 0;
+
+    // Shown once the engines have had to recover from a NaN or Inf
+    juce::Label recoveryLabel;
+    int shownRecoveries = 0;
+
     // Room selector
     RoomSelector roomSelector;
 
@@ -234,6 +544,14 @@ private:
     LabeledKnob inputKnob;
     LabeledKnob outputKnob;
 
+    // Preset morph, along the bottom
+    MorphStrip morphStrip { processor };
+
+    // The only periodic callback in the editor, synced to the display refresh
+    double lastVisualizerUpdateMs = 0.0;
+    static constexpr double visualizerIntervalMs = 1000.0 / 30.0;
+    juce::VBlankAttachment vBlank { this, [this]() { updateVisualizers(); } };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AuraEditor)
 };
 
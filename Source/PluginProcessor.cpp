@@ -4,6 +4,26 @@
 namespace Aura
 {
 
+namespace
+{
+    // Morph preset names are kept in the state so sessions reopen mid-morph
+    const juce::Identifier morphPresetAProperty { "morphPresetA" };
+    const juce::Identifier morphPresetBProperty { "morphPresetB" };
+
+    // Averages all channels into the first one
+    void sumToMono(juce::AudioBuffer<float>& buffer)
+    {
+        const int numChannels = buffer.getNumChannels();
+        if (numChannels < 2)
+            return;
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            buffer.addFrom(0, 0, buffer, ch, 0, buffer.getNumSamples());
+
+        buffer.applyGain(0, 0, buffer.getNumSamples(), 1.0f / static_cast<float>(numChannels));
+    }
+}
+
 AuraProcessor::AuraProcessor()
     : AudioProcessor(BusesProperties()
                          .withInput("Input", juce::AudioChannelSet::stereo(), true)
@@ -18,6 +38,11 @@ AuraProcessor::AuraProcessor()
     preDelayParam = apvts.getRawParameterValue(ParamIDs::preDelay);
     widthParam = apvts.getRawParameterValue(ParamIDs::width);
     mixParam = apvts.getRawParameterValue(ParamIDs::mix);
+    equalPowerMixParam = apvts.getRawParameterValue(ParamIDs::equalPowerMix);
+    sendModeParam = apvts.getRawParameterValue(ParamIDs::sendMode);
+    qualityParam = apvts.getRawParameterValue(ParamIDs::quality);
+    adaptiveQualityParam = apvts.getRawParameterValue(ParamIDs::adaptiveQuality);
+    bypassParam = apvts.getRawParameterValue(ParamIDs::bypass);
     erLevelParam = apvts.getRawParameterValue(ParamIDs::erLevel);
     erSizeParam = apvts.getRawParameterValue(ParamIDs::erSize);
     highCutParam = apvts.getRawParameterValue(ParamIDs::highCut);
@@ -35,22 +60,102 @@ AuraProcessor::AuraProcessor()
     highDecayParam = apvts.getRawParameterValue(ParamIDs::highDecay);
     crossoverLowParam = apvts.getRawParameterValue(ParamIDs::crossoverLow);
     crossoverHighParam = apvts.getRawParameterValue(ParamIDs::crossoverHigh);
+
+    // Preset morph
+    morphParam = apvts.getRawParameterValue(ParamIDs::morph);
+
+    // Prepare a spare engine around every preset load so the switch is crossfaded
+    presetManager.onPresetLoadStarted = [this]() { swapPending = beginEngineSwap(); };
+    presetManager.onPresetLoadFinished = [this]()
+    {
+        if (swapPending)
+            commitEngineSwap();
+        swapPending = false;
+    };
+
+    startTimerHz(qualityPollHz);
+
+   #if AURA_TRACE
+    Trace::start(Trace::getDefaultFile());
+   #endif
 }
 
-AuraProcessor::~AuraProcessor() = default;
+AuraProcessor::~AuraProcessor()
+{
+    stopTimer();
+
+   #if AURA_TRACE
+    Trace::stop();
+   #endif
+}
 
 void AuraProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
-    reverb.prepare(sampleRate, samplesPerBlock);
-    earlyReflections.prepare(sampleRate, samplesPerBlock);
+    enginesPrepared.store(false);
+
+    juce::ignoreUnused(samplesPerBlock);
+    currentSampleRate = sampleRate;
 
-    wetBuffer.setSize(2, samplesPerBlock);
+    // Sized for the internal sub-block, not the host's announced block size,
+    // so nothing the host sends later can make the audio thread reallocate
+    for (auto& engine : engines)
+    {
+        engine.setDelayPrecision(getQualityPrecision());
+        engine.prepare(sampleRate, internalBlockSize);
+    }
+
+    wetBuffer.setSize(2, internalBlockSize);
+    fadeBuffer.setSize(2, internalBlockSize);
+    bypassDryBuffer.setSize(2, internalBlockSize);
+    decayAnalyser.prepare(sampleRate);
+    governor.prepare(sampleRate);
+
+    // The morph's filter designs are made for one rate. The audio thread is
+    // stopped here, so its copy can be redone directly.
+    {
+        const juce::SpinLock::ScopedLockType lock(morphLock);
+        pendingMorph.prepare(sampleRate);
+    }
+    morph.prepare(sampleRate);
+
+    // The wet path has no latency of its own, so the dry path isn't delayed
+    outputStage.prepare(sampleRate, maxDryDelaySamples);
+    outputStage.setDryDelay(0);
+    lastInputGain = juce::Decibels::decibelsToGain(inputGainParam->load());
+
+    fadeLengthSamples = juce::jmax(1, static_cast<int>(engineCrossfadeSeconds * sampleRate));
+    fadingEngine = -1;
+    fadePosition = 0;
+    swapState.store(SwapState::Idle);
+
+    // A session that opens bypassed has no tail to ring out, so it starts asleep
+    bypassStep = 1.0f / juce::jmax(1.0f, static_cast<float>(bypassRampSeconds * sampleRate));
+    bypassMix = bypassParam->load() >= 0.5f ? 1.0f : 0.0f;
+    tailSleepSamples = static_cast<int>(tailSleepSeconds * sampleRate);
+    quietSamples = 0;
+    tailAsleep.store(bypassMix >= 1.0f);
+
+    enginesPrepared.store(true);
 }
 
 void AuraProcessor::releaseResources()
 {
-    reverb.reset();
-    earlyReflections.reset();
+    for (auto& engine : engines)
+        engine.reset();
+}
+
+size_t AuraProcessor::getMemoryFootprint() const
+{
+    // The wet, fade and bypass buffers shrink their visible size per sub-block,
+    // but keep the allocation made in prepareToPlay
+    const size_t bufferBytes = 2 * static_cast<size_t>(internalBlockSize) * sizeof(float);
+
+    size_t bytes = 3 * bufferBytes + outputStage.getMemoryFootprint() + decayAnalyser.getMemoryFootprint();
+
+    for (const auto& engine : engines)
+        bytes += engine.getMemoryFootprint();
+
+    return bytes;
 }
 
 bool AuraProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
@@ -59,104 +164,497 @@ bool AuraProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
         layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
         return false;
 
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+    // Matching input and output, or a mono source into a stereo reverb
+    const auto input = layouts.getMainInputChannelSet();
+    const auto output = layouts.getMainOutputChannelSet();
+
+    return input == output
+        || (input == juce::AudioChannelSet::mono() && output == juce::AudioChannelSet::stereo());
+}
+
+EngineSettings AuraProcessor::getEngineSettings() const
+{
+    EngineSettings settings;
+    settings.roomType = static_cast<int>(roomTypeParam->load());
+    settings.size = sizeParam->load();
+    settings.decay = decayParam->load();
+    settings.damping = dampingParam->load();
+    settings.preDelay = preDelayParam->load();
+    settings.width = widthParam->load();
+    settings.erLevel = erLevelParam->load();
+    settings.erSize = erSizeParam->load();
+    settings.highCut = highCutParam->load();
+    settings.lowCut = lowCutParam->load();
+
+    // Modulation
+    settings.modDepth = modDepthParam->load();
+    settings.modRate = modRateParam->load();
+
+    // Multi-band decay
+    settings.lowDecay = lowDecayParam->load();
+    settings.midDecay = midDecayParam->load();
+    settings.highDecay = highDecayParam->load();
+    settings.crossoverLow = crossoverLowParam->load();
+    settings.crossoverHigh = crossoverHighParam->load();
+    return settings;
+}
+
+bool AuraProcessor::beginEngineSwap()
+{
+    // While morphing the engines follow the morph targets, not the preset
+    if (!enginesPrepared.load() || morphActive.load())
+        return false;
+
+    // A morph that was just cleared still holds the spare until the audio
+    // thread's next callback sees it; wait that long rather than jump
+    for (int waitedMs = 0; swapState.load(std::memory_order_acquire) == SwapState::Morphing; ++waitedMs)
+    {
+        if (waitedMs >= morphReleaseTimeoutMs || morphActive.load())
+            return false;
+
+        juce::Thread::sleep(1);
+    }
+
+    // A swap that is still fading keeps its engines; this load simply jumps
+    auto expected = SwapState::Idle;
+    return swapState.compare_exchange_strong(expected, SwapState::Preparing,
+                                             std::memory_order_acquire);
+}
+
+void AuraProcessor::commitEngineSwap()
+{
+    // The audio thread leaves the spare engine alone while we hold Preparing,
+    // so filter coefficient updates and the reset happen here, not in the callback
+    auto& spare = engines[static_cast<size_t>(1 - activeEngine.load(std::memory_order_relaxed))];
+    spare.reset();
+    spare.apply(getEngineSettings());
+
+    swapState.store(SwapState::Ready, std::memory_order_release);
+}
+
+DelayPrecision AuraProcessor::getQualityPrecision() const
+{
+    return static_cast<QualityTier>(juce::roundToInt(qualityParam->load())) == QualityTier::Eco
+        ? DelayPrecision::Half
+        : DelayPrecision::Full;
+}
+
+void AuraProcessor::timerCallback()
+{
+    AURA_TRACE_SCOPE("AuraProcessor::timerCallback");
+    updateQualityTier();
+}
+
+void AuraProcessor::updateQualityTier()
+{
+    if (!enginesPrepared.load())
+        return;
+
+    const auto precision = getQualityPrecision();
+    const int active = activeEngine.load(std::memory_order_relaxed);
+    auto& spare = engines[static_cast<size_t>(1 - active)];
+
+    if (spare.getDelayPrecision() != precision)
+    {
+        // Reallocating is fine here: the audio thread leaves the spare alone
+        // while we hold Preparing. The crossfade follows on the next tick, and
+        // while a room morph holds the spare this simply retries.
+        auto expected = SwapState::Idle;
+        if (!swapState.compare_exchange_strong(expected, SwapState::Preparing, std::memory_order_acquire))
+            return;
+
+        spare.setDelayPrecision(precision);
+        spare.prepare(currentSampleRate, internalBlockSize);
+        swapState.store(SwapState::Idle, std::memory_order_release);
+    }
+    else if (engines[static_cast<size_t>(active)].getDelayPrecision() != precision && beginEngineSwap())
+    {
+        commitEngineSwap();
+    }
+}
+
+bool AuraProcessor::setMorphPresets(const juce::String& presetA, const juce::String& presetB)
+{
+    juce::NamedValueSet valuesA, valuesB;
+    if (!presetManager.getPresetValues(presetA, valuesA) || !presetManager.getPresetValues(presetB, valuesB))
         return false;
 
+    // Everything the audio thread needs is resolved here, so it only has to lerp
+    PresetMorph targets;
+    targets.setTargets(EngineSettings::fromValues(valuesA),
+                       static_cast<float>(valuesA.getWithDefault(ParamIDs::mix, Defaults::mix)),
+                       EngineSettings::fromValues(valuesB),
+                       static_cast<float>(valuesB.getWithDefault(ParamIDs::mix, Defaults::mix)),
+                       currentSampleRate);
+
+    {
+        const juce::SpinLock::ScopedLockType lock(morphLock);
+        pendingMorph = targets;
+        morphChanged.store(true, std::memory_order_release);
+    }
+
+    morphActive.store(true);
+    apvts.state.setProperty(morphPresetAProperty, presetA, nullptr);
+    apvts.state.setProperty(morphPresetBProperty, presetB, nullptr);
     return true;
 }
 
+void AuraProcessor::clearMorphPresets()
+{
+    {
+        const juce::SpinLock::ScopedLockType lock(morphLock);
+        pendingMorph.clear();
+        morphChanged.store(true, std::memory_order_release);
+    }
+
+    morphActive.store(false);
+    apvts.state.removeProperty(morphPresetAProperty, nullptr);
+    apvts.state.removeProperty(morphPresetBProperty, nullptr);
+}
+
+juce::String AuraProcessor::getMorphPresetA() const
+{
+    return apvts.state.getProperty(morphPresetAProperty).toString();
+}
+
+juce::String AuraProcessor::getMorphPresetB() const
+{
+    return apvts.state.getProperty(morphPresetBProperty).toString();
+}
+
+void AuraProcessor::restoreMorphPresets()
+{
+    auto presetA = getMorphPresetA();
+    auto presetB = getMorphPresetB();
+
+    if (presetA.isEmpty() || presetB.isEmpty() || !setMorphPresets(presetA, presetB))
+        clearMorphPresets();
+}
+
 void AuraProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
+    process(buffer, bypassParam->load() >= 0.5f);
+}
+
+void AuraProcessor::processBlockBypassed(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    // Hosts that bypass without the parameter get the same ring-out
+    process(buffer, true);
+}
+
+void AuraProcessor::process(juce::AudioBuffer<float>& buffer, bool bypassed)
+{
+    AURA_TRACE_THREAD("Audio");
+    AURA_TRACE_SCOPE("AuraProcessor::processBlock");
+
+    if (bypassed && tailAsleep.load(std::memory_order_relaxed))
+    {
+        passThroughAsleep(buffer);
+        return;
+    }
+
+    tailAsleep.store(false, std::memory_order_relaxed);
+
     juce::ScopedNoDenormals noDenormals;
 
+    // Offline renders have no deadline, so they always run at full quality
+    // and the governor doesn't even see them
+    const bool governed = adaptiveQualityParam->load() >= 0.5f && !isNonRealtime();
+    const auto startTicks = governed ? juce::Time::getHighResolutionTicks() : 0;
+
+    // Hosts may send more samples than announced, or a different count every
+    // call, so the block is processed in slices that fit the internal buffers
+    const int numSamples = buffer.getNumSamples();
+
+    for (int start = 0; start < numSamples; start += internalBlockSize)
+    {
+        juce::AudioBuffer<float> subBlock(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                          start, juce::jmin(internalBlockSize, numSamples - start));
+        processSubBlock(subBlock, bypassed);
+    }
+
+    if (governed)
+        governor.update(juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks),
+                        numSamples);
+    else if (governor.getLevel() != 0)
+        governor.reset();
+}
+
+void AuraProcessor::passThroughAsleep(juce::AudioBuffer<float>& buffer)
+{
+    // The output is the input; a mono input still reaches both outputs
+    for (int ch = getTotalNumInputChannels(); ch < buffer.getNumChannels(); ++ch)
+        buffer.copyFrom(ch, 0, buffer, 0, 0, buffer.getNumSamples());
+
+    // A preset prepared while asleep has no tail to fade from, so it takes over at once
+    if (swapState.load(std::memory_order_acquire) == SwapState::Ready)
+    {
+        activeEngine.store(1 - activeEngine.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        swapState.store(SwapState::Idle, std::memory_order_release);
+    }
+}
+
+void AuraProcessor::processSubBlock(juce::AudioBuffer<float>& buffer, bool bypassed)
+{
+    AURA_TRACE_SCOPE("AuraProcessor::processSubBlock");
     int numSamples = buffer.getNumSamples();
-    int numChannels = buffer.getNumChannels();
-
-    // Get parameters
-    int roomType = static_cast<int>(roomTypeParam->load());
-    float sizeVal = sizeParam->load() / 100.0f;
-    float decayVal = decayParam->load();
-    float dampingVal = dampingParam->load() / 100.0f;
-    float preDelayVal = preDelayParam->load();
-    float widthVal = widthParam->load() / 100.0f;
-    float mixVal = mixParam->load() / 100.0f;
-    float erLevelVal = erLevelParam->load() / 100.0f;
-    float erSizeVal = erSizeParam->load() / 100.0f;
-    float highCutVal = highCutParam->load();
-    float lowCutVal = lowCutParam->load();
 
+    // Bypass crossfades the engine input out and the untouched input in, so
+    // the tail keeps ringing after the switch
+    const float bypassStart = bypassMix;
+    const float bypassEnd = juce::jlimit(0.0f, 1.0f, bypassMix + (bypassed ? bypassStep : -bypassStep)
+                                                                   * static_cast<float>(numSamples));
+    const bool bypassEngaged = bypassStart > 0.0f || bypassEnd > 0.0f;
+    bypassMix = bypassEnd;
+
+    if (bypassEngaged)
+    {
+        const int lastHostInput = juce::jmax(0, getTotalNumInputChannels() - 1);
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            bypassDryBuffer.copyFrom(ch, 0, buffer, juce::jmin(ch, lastHostInput), 0, numSamples);
+    }
+
+    // Take over a prepared spare engine and start fading the old one out
+    auto state = swapState.load(std::memory_order_acquire);
+    if (state == SwapState::Ready)
+    {
+        fadingEngine = activeEngine.load(std::memory_order_relaxed);
+        activeEngine.store(1 - fadingEngine, std::memory_order_relaxed);
+        fadePosition = 0;
+        state = SwapState::Fading;
+        swapState.store(state, std::memory_order_relaxed);
+    }
+
+    // Pick up new morph targets, but never wait on the message thread for them
+    if (morphChanged.load(std::memory_order_acquire))
+    {
+        const juce::SpinLock::ScopedTryLockType lock(morphLock);
+        if (lock.isLocked())
+        {
+            morph = pendingMorph;
+            morphChanged.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    const int active = activeEngine.load(std::memory_order_relaxed);
+    auto& engine = engines[static_cast<size_t>(active)];
+    auto& spare = engines[static_cast<size_t>(1 - active)];
+
+    const float morphPosition = morphParam->load() / 100.0f;
+
+    // Rooms A and B run on one engine each. The spare is claimed through the
+    // swap state like a preset load, so the message thread can't prepare it
+    // while it runs here, and it is handed back as soon as the morph ends.
+    const bool wantsMorphRooms = morph.isActive() && morph.needsRoomCrossfade();
+
+    if (wantsMorphRooms && state == SwapState::Idle
+        && swapState.compare_exchange_strong(state, SwapState::Morphing, std::memory_order_acquire))
+    {
+        // Once per morph: clear whatever tail the spare was left with
+        state = SwapState::Morphing;
+        spare.reset();
+        lastMorphPosition = morphPosition;
+    }
+    else if (!wantsMorphRooms && state == SwapState::Morphing)
+    {
+        state = SwapState::Idle;
+        swapState.store(state, std::memory_order_release);
+    }
+
+    const bool morphRooms = state == SwapState::Morphing;
+
+    // Engines ramp between levels themselves; the spare follows whenever this
+    // thread is running it
+    const auto level = static_cast<RoomReverb::ProcessingLevel>(governor.getLevel());
+    engine.setProcessingLevel(level);
+    if (morphRooms || fadingEngine >= 0)
+        spare.setProcessingLevel(level);
+
+    if (morph.isActive())
+    {
+        // Both ends are designed already, so this only interpolates
+        const int roomA = morph.getRoomTypeA();
+        engine.applyMorph(morph.interpolate(morphPosition, roomA), morph.interpolateDesign(morphPosition, roomA));
+
+        if (morphRooms)
+        {
+            const int roomB = morph.getRoomTypeB();
+            spare.applyMorph(morph.interpolate(morphPosition, roomB), morph.interpolateDesign(morphPosition, roomB));
+        }
+    }
+    else if (state != SwapState::Preparing)
+    {
+        // While a preset is being prepared the running engine holds its settings,
+        // so the old sound never picks up the new parameters before the crossfade
+        engine.apply(getEngineSettings());
+    }
+
+    float mixVal = (morph.isActive() ? morph.interpolateMix(morphPosition) : mixParam->load()) / 100.0f;
     float inputGainLinear = juce::Decibels::decibelsToGain(inputGainParam->load());
     float outputGainLinear = juce::Decibels::decibelsToGain(outputGainParam->load());
 
-    // Apply room type multipliers
-    float roomSizeMultiplier = RoomPresets::getSizeMultiplier(static_cast<RoomType>(roomType));
-    float roomDecayMultiplier = RoomPresets::getDecayMultiplier(static_cast<RoomType>(roomType));
-
-    float effectiveSize = sizeVal * roomSizeMultiplier;
-    float effectiveDecay = decayVal * roomDecayMultiplier;
-
-    // Get modulation parameters
-    float modDepthVal = modDepthParam->load() / 100.0f;
-    float modRateVal = modRateParam->load() / 50.0f;  // 0-2 range
-
-    // Get multi-band decay parameters
-    float lowDecayVal = lowDecayParam->load() / 100.0f;    // 0.5-2.0 range
-    float midDecayVal = midDecayParam->load() / 100.0f;
-    float highDecayVal = highDecayParam->load() / 100.0f;
-    float crossoverLowVal = crossoverLowParam->load();
-    float crossoverHighVal = crossoverHighParam->load();
-
-    // Update DSP parameters
-    reverb.setSize(effectiveSize);
-    reverb.setDecay(effectiveDecay);
-    reverb.setDamping(dampingVal);
-    reverb.setPreDelay(preDelayVal);
-    reverb.setWidth(widthVal);
-    reverb.setHighCut(highCutVal);
-    reverb.setLowCut(lowCutVal);
-
-    // Set modulation parameters
-    reverb.setModulationDepth(modDepthVal);
-    reverb.setModulationRate(modRateVal);
-
-    // Set multi-band decay parameters
-    reverb.setLowDecayMultiplier(lowDecayVal);
-    reverb.setMidDecayMultiplier(midDecayVal);
-    reverb.setHighDecayMultiplier(highDecayVal);
-    reverb.setCrossoverLow(crossoverLowVal);
-    reverb.setCrossoverHigh(crossoverHighVal);
-
-    earlyReflections.setSize(erSizeVal * roomSizeMultiplier);
-    earlyReflections.setLevel(erLevelVal);
-
-    // Apply input gain
-    buffer.applyGainRamp(0, numSamples, lastInputGain, inputGainLinear);
+    // Send mode keeps no dry signal, so the engine works on the block in place.
+    // Preset and room crossfades feed a second engine the same dry input, so
+    // they take the insert path, fully wet, until they finish.
+    const bool sendMode = sendModeParam->load() >= 0.5f;
+
+    // A mono input (mono bus, or summed for send mode) sits in the first channel
+    // and the engines run their input stages on it once
+    const int numChannels = buffer.getNumChannels();
+    const bool monoInput = sendMode || getTotalNumInputChannels() < 2;
+    const int numInputChannels = monoInput ? 1 : numChannels;
+
+    if (sendMode)
+        sumToMono(buffer);
+
+    // Apply input gain; skipped entirely at a steady 0 dB
+    if (lastInputGain != 1.0f || inputGainLinear != 1.0f)
+        for (int ch = 0; ch < numInputChannels; ++ch)
+            buffer.applyGainRamp(ch, 0, numSamples, lastInputGain, inputGainLinear);
     lastInputGain = inputGainLinear;
 
-    // Copy to wet buffer
-    wetBuffer.makeCopyOf(buffer, true);
+    if (bypassEngaged)
+        for (int ch = 0; ch < numInputChannels; ++ch)
+            buffer.applyGainRamp(ch, 0, numSamples, 1.0f - bypassStart, 1.0f - bypassEnd);
+
+    const juce::AudioBuffer<float> input(buffer.getArrayOfWritePointers(), numInputChannels, numSamples);
+
+    if (sendMode && fadingEngine < 0 && !morphRooms && !bypassEngaged)
+    {
+        processEngine(engine, input, buffer, numChannels);
+
+        decayAnalyser.push(buffer);
+        outputStage.processWetOnly(buffer, outputGainLinear);
+    }
+    else
+    {
+        // The engines read the dry signal and write the wet one to their own buffer,
+        // which never exceeds the preallocated size
+        processEngine(engine, input, wetBuffer, numChannels);
+
+        // The dry path carries a mono input on every output channel
+        for (int ch = numInputChannels; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, 0, buffer, 0, 0, numSamples);
+
+        if (morphRooms)
+            crossfadeMorphRooms(input, morphPosition);
+        else if (fadingEngine >= 0)
+            crossfadeEngines(input);
+
+        // Only a copy into the analyser's FIFO; the analysis runs on the message thread
+        decayAnalyser.push(wetBuffer);
+
+        // Mix dry and wet and apply the output gain in one pass
+        outputStage.setMixLaw(equalPowerMixParam->load() >= 0.5f ? OutputStage::MixLaw::EqualPower
+                                                                 : OutputStage::MixLaw::Linear);
+        outputStage.process(buffer, wetBuffer, sendMode ? 1.0f : mixVal, outputGainLinear);
+
+        if (bypassEngaged)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.addFromWithRamp(ch, 0, bypassDryBuffer.getReadPointer(ch), numSamples, bypassStart, bypassEnd);
+
+            updateTailSleep(numSamples);
+        }
+    }
+
+    lastMorphPosition = morphPosition;
+}
+
+void AuraProcessor::processEngine(ReverbEngine& engine, const juce::AudioBuffer<float>& input,
+                                  juce::AudioBuffer<float>& output, int numOutputChannels)
+{
+    const int recoveriesBefore = engine.getNumRecoveries();
+    engine.process(input, output, numOutputChannels);
+
+    // Counted by the thread running the engine, and only while it runs it:
+    // the message thread may be preparing the other one
+    if (const int recovered = engine.getNumRecoveries() - recoveriesBefore; recovered > 0)
+        numEngineRecoveries.store(numEngineRecoveries.load(std::memory_order_relaxed) + recovered,
+                                  std::memory_order_relaxed);
+}
+
+void AuraProcessor::updateTailSleep(int numSamples)
+{
+    // Only a lone engine ringing out with nothing left to fade can go to sleep
+    bool quiet = bypassMix >= 1.0f && fadingEngine < 0
+              && swapState.load(std::memory_order_relaxed) == SwapState::Idle;
+
+    for (int ch = 0; quiet && ch < wetBuffer.getNumChannels(); ++ch)
+        quiet = wetBuffer.getMagnitude(ch, 0, numSamples) < tailSilenceThreshold;
+
+    quietSamples = quiet ? quietSamples + numSamples : 0;
+
+    if (quietSamples >= tailSleepSamples)
+    {
+        // Wakes up clean, with nothing of the old tail left to click back in
+        engines[static_cast<size_t>(activeEngine.load(std::memory_order_relaxed))].reset();
+        governor.reset();
+        quietSamples = 0;
+        tailAsleep.store(true, std::memory_order_relaxed);
+    }
+}
 
-    // Process early reflections on wet signal
-    earlyReflections.process(wetBuffer);
+void AuraProcessor::crossfadeEngines(const juce::AudioBuffer<float>& input)
+{
+    AURA_TRACE_SCOPE("AuraProcessor::crossfadeEngines");
+    // The outgoing engine keeps its old settings and rings out on the same input
+    auto& outgoing = engines[static_cast<size_t>(fadingEngine)];
+    processEngine(outgoing, input, fadeBuffer, wetBuffer.getNumChannels());
 
-    // Process reverb on wet signal
-    reverb.process(wetBuffer);
+    const int numSamples = input.getNumSamples();
+    const int numChannels = wetBuffer.getNumChannels();
+    const float fadeStep = 1.0f / static_cast<float>(fadeLengthSamples);
 
-    // Mix dry and wet
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (int i = 0; i < numSamples; ++i)
     {
-        float* dry = buffer.getWritePointer(ch);
-        const float* wet = wetBuffer.getReadPointer(ch);
+        // Equal-power law keeps the summed tail level constant through the switch
+        float t = juce::jmin(1.0f, static_cast<float>(fadePosition + i) * fadeStep);
+        float gainIn = std::sin(t * juce::MathConstants<float>::halfPi);
+        float gainOut = std::cos(t * juce::MathConstants<float>::halfPi);
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            dry[i] = dry[i] * (1.0f - mixVal) + wet[i] * mixVal;
+            float* wet = wetBuffer.getWritePointer(ch);
+            const float* old = fadeBuffer.getReadPointer(ch);
+            wet[i] = wet[i] * gainIn + old[i] * gainOut;
         }
     }
 
-    // Apply output gain
-    buffer.applyGainRamp(0, numSamples, lastOutputGain, outputGainLinear);
-    lastOutputGain = outputGainLinear;
+    fadePosition += numSamples;
+
+    if (fadePosition >= fadeLengthSamples)
+    {
+        fadingEngine = -1;
+        swapState.store(SwapState::Idle, std::memory_order_release);
+    }
+}
+
+void AuraProcessor::crossfadeMorphRooms(const juce::AudioBuffer<float>& input, float morphPosition)
+{
+    AURA_TRACE_SCOPE("AuraProcessor::crossfadeMorphRooms");
+    // The spare engine carries room B with the same interpolated settings
+    auto& roomB = engines[static_cast<size_t>(1 - activeEngine.load(std::memory_order_relaxed))];
+    processEngine(roomB, input, fadeBuffer, wetBuffer.getNumChannels());
+
+    const int numSamples = input.getNumSamples();
+    const int numChannels = wetBuffer.getNumChannels();
+    const float step = (morphPosition - lastMorphPosition) / static_cast<float>(juce::jmax(1, numSamples));
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Ramped across the block so automation doesn't zipper
+        float t = lastMorphPosition + step * static_cast<float>(i + 1);
+        float gainB = std::sin(t * juce::MathConstants<float>::halfPi);
+        float gainA = std::cos(t * juce::MathConstants<float>::halfPi);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* wet = wetBuffer.getWritePointer(ch);
+            const float* b = fadeBuffer.getReadPointer(ch);
+            wet[i] = wet[i] * gainA + b[i] * gainB;
+        }
+    }
 }
 
 juce::AudioProcessorEditor* AuraProcessor::createEditor()
@@ -166,16 +664,14 @@ juce::AudioProcessorEditor* AuraProcessor::createEditor()
 
 void AuraProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
-    auto state = apvts.copyState();
-    std::unique_ptr<juce::XmlElement> xml(state.createXml());
-    copyXmlToBinary(*xml, destData);
+    stateSerializer.save(destData);
 }
 
 void AuraProcessor::setStateInformation(const void* data, int sizeInBytes)
 {
-    std::unique_ptr<juce::XmlElement> xml(getXmlFromBinary(data, sizeInBytes));
-    if (xml != nullptr && xml->hasTagName(apvts.state.getType()))
-        apvts.replaceState(juce::ValueTree::fromXml(*xml));
+    // Falls back to the XML format for sessions saved by older versions
+    if (stateSerializer.load(data, sizeInBytes))
+        restoreMorphPresets();
 }
 
 } // namespace Aura
@@ -2,14 +2,20 @@
 
 #include "Utils/Parameters.h"
 #include "Utils/PresetManager.h"
-#include "DSP/RoomReverb.h"
-#include "DSP/EarlyReflections.h"
+#include "Utils/StateSerializer.h"
+#include "Utils/Trace.h"
+#include "DSP/ReverbEngine.h"
+#include "DSP/CpuGovernor.h"
+#include "DSP/PresetMorph.h"
+#include "DSP/DecayAnalyser.h"
+#include "DSP/OutputStage.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 
 namespace Aura
 {
 
-class AuraProcessor : public juce::AudioProcessor
+class AuraProcessor : public juce::AudioProcessor,
+                      private juce::Timer
 {
 public:
     AuraProcessor();
@@ -21,6 +27,12 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void processBlockBypassed(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    // While bypassed the engines stop taking input and the tail rings out over
+    // the dry signal; once it has died away they stop running altogether
+    juce::AudioProcessorParameter* getBypassParameter() const override { return apvts.getParameter(ParamIDs::bypass); }
+    bool isAsleep() const { return tailAsleep.load(std::memory_order_relaxed); }
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -44,16 +56,126 @@ public:
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
     PresetManager& getPresetManager() { return presetManager; }
 
-    float getDecayEnvelope() const { return reverb.getDecayEnvelope(); }
+    // Preset morph (message thread). While set, the morph parameter sweeps the
+    // engines from preset A to preset B instead of following the other knobs.
+    bool setMorphPresets(const juce::String& presetA, const juce::String& presetB);
+    void clearMorphPresets();
+    juce::String getMorphPresetA() const;
+    juce::String getMorphPresetB() const;
+
+    // True while the audio thread runs the spare engine as room B
+    bool isMorphingRooms() const { return swapState.load(std::memory_order_relaxed) == SwapState::Morphing; }
+
+    float getDecayEnvelope() const
+    {
+        return engines[static_cast<size_t>(activeEngine.load(std::memory_order_relaxed))].getDecayEnvelope();
+    }
+
+    // Measured decay of the wet output; drained by the editor
+    DecayAnalyser& getDecayAnalyser() { return decayAnalyser; }
+
+    // Bytes of DSP memory this instance holds after prepareToPlay
+    size_t getMemoryFootprint() const;
+
+    // Processing level the CPU governor has the engines at; 0 is full quality.
+    // An atomic the editor polls, not a host parameter: a value written from
+    // the plugin would show up in the host's undo history and automation.
+    int getCpuLevel() const { return governor.getLevel(); }
+
+    // Blocks the engines had to recover from a NaN or Inf, since construction
+    int getNumEngineRecoveries() const { return numEngineRecoveries.load(std::memory_order_relaxed); }
 
 private:
+    EngineSettings getEngineSettings() const;
+
+    void process(juce::AudioBuffer<float>& buffer, bool bypassed);
+    void processSubBlock(juce::AudioBuffer<float>& buffer, bool bypassed);
+    void passThroughAsleep(juce::AudioBuffer<float>& buffer);
+    void updateTailSleep(int numSamples);
+
+    // Preset hot-switch (message thread)
+    bool beginEngineSwap();
+    void commitEngineSwap();
+
+    // Audio thread: runs an engine it owns and adds its recoveries to the count
+    void processEngine(ReverbEngine& engine, const juce::AudioBuffer<float>& input,
+                       juce::AudioBuffer<float>& output, int numOutputChannels);
+
+    void crossfadeEngines(const juce::AudioBuffer<float>& input);
+    void crossfadeMorphRooms(const juce::AudioBuffer<float>& input, float morphPosition);
+
+    void restoreMorphPresets();
+
+    // Message thread housekeeping: the quality tier
+    void timerCallback() override;
+
+    // Quality tier. Polls the quality parameter and moves the engines onto
+    // the delay storage it asks for: the spare is reallocated first, then
+    // crossfaded in through the same handshake as a preset load.
+    void updateQualityTier();
+    DelayPrecision getQualityPrecision() const;
+
     juce::AudioProcessorValueTreeState apvts;
     PresetManager presetManager;
+    StateSerializer stateSerializer { apvts };
 
-    // DSP
-    RoomReverb reverb;
-    EarlyReflections earlyReflections;
+    // DSP - double-buffered so preset changes can be crossfaded
+    std::array<ReverbEngine, 2> engines;
+    static constexpr int internalBlockSize = 512;
+    double currentSampleRate = 44100.0;
     juce::AudioBuffer<float> wetBuffer;
+    juce::AudioBuffer<float> fadeBuffer;
+    DecayAnalyser decayAnalyser;
+    OutputStage outputStage;
+
+    // Sheds engine work when callbacks run close to their deadline
+    CpuGovernor governor { RoomReverb::numProcessingLevels };
+
+    // Written by the audio thread only, as the engines it runs recover
+    std::atomic<int> numEngineRecoveries { 0 };
+
+    // Bypass. bypassMix moves from 0 (processing) to 1 (dry plus tail) over
+    // bypassRampSeconds. The engines sleep once the tail has stayed below
+    // tailSilenceThreshold for tailSleepSeconds, which outlasts the longest
+    // pre-delay plus comb delay, so nothing audible is still in flight.
+    static constexpr double bypassRampSeconds = 0.02;
+    static constexpr float tailSilenceThreshold = 1.0e-5f;    // -100 dBFS
+    static constexpr double tailSleepSeconds = 0.5;
+
+    juce::AudioBuffer<float> bypassDryBuffer;
+    float bypassMix = 0.0f;             // audio thread only
+    float bypassStep = 1.0f;
+    int quietSamples = 0;               // audio thread only
+    int tailSleepSamples = 0;
+    std::atomic<bool> tailAsleep { false };
+
+    static constexpr int maxDryDelaySamples = 4096;
+
+    // Engine swap handshake. The message thread only touches the spare
+    // engine while it owns the swap (Preparing); the audio thread takes it
+    // over on Ready and hands it back as Idle once the crossfade finishes.
+    // Morphing is held by the audio thread while it runs the spare as room B.
+    enum class SwapState { Idle, Preparing, Ready, Fading, Morphing };
+    std::atomic<SwapState> swapState { SwapState::Idle };
+    std::atomic<int> activeEngine { 0 };
+    std::atomic<bool> enginesPrepared { false };
+    bool swapPending = false;       // message thread only
+    int fadingEngine = -1;          // audio thread only
+    int fadePosition = 0;
+    int fadeLengthSamples = 0;
+
+    static constexpr double engineCrossfadeSeconds = 0.05;
+    static constexpr int morphReleaseTimeoutMs = 50;    // a few host callbacks
+    static constexpr int qualityPollHz = 10;
+
+    // Preset morph. The message thread publishes new targets under the lock;
+    // the audio thread copies them only if it gets the lock without waiting.
+    PresetMorph pendingMorph;
+    juce::SpinLock morphLock;
+    std::atomic<bool> morphChanged { false };
+    std::atomic<bool> morphActive { false };
+    PresetMorph morph;                  // audio thread only
+    float lastMorphPosition = 0.0f;
 
     // Parameter pointers
     std::atomic<float>* roomTypeParam = nullptr;
@@ -63,6 +185,11 @@ private:
     std::atomic<float>* preDelayParam = nullptr;
     std::atomic<float>* widthParam = nullptr;
     std::atomic<float>* mixParam = nullptr;
+    std::atomic<float>* equalPowerMixParam = nullptr;
+    std::atomic<float>* sendModeParam = nullptr;
+    std::atomic<float>* qualityParam = nullptr;
+    std::atomic<float>* adaptiveQualityParam = nullptr;
+    std::atomic<float>* bypassParam = nullptr;
     std::atomic<float>* erLevelParam = nullptr;
     std::atomic<float>* erSizeParam = nullptr;
     std::atomic<float>* highCutParam = nullptr;
@@ -81,8 +208,10 @@ private:
     std::atomic<float>* crossoverLowParam = nullptr;
     std::atomic<float>* crossoverHighParam = nullptr;
 
+    // Preset morph
+    std::atomic<float>* morphParam = nullptr;
+
     float lastInputGain = 1.0f;
-    float lastOutputGain = 1.0f;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AuraProcessor)
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_gui_basics/juce_gui_basics.h>
+#include <map>
 
 namespace Aura
 {
@@ -92,24 +93,11 @@ public:
         g.setGradientFill(glowGradient);
         g.fillEllipse(rx - 8, ry - 8, rw + 16, rw + 16);
 
-        // Background with gradient
-        juce::ColourGradient bgGradient(
-            Colors::bgLight, centreX, centreY - radius,
-            Colors::knobBg, centreX, centreY + radius, false);
-        g.setGradientFill(bgGradient);
-        g.fillEllipse(rx, ry, rw, rw);
-
-        // Outer ring
-        g.setColour(Colors::knobRing);
-        g.drawEllipse(rx, ry, rw, rw, 2.0f);
-
-        // Value arc background
-        juce::Path arcBg;
-        arcBg.addCentredArc(centreX, centreY, radius - 8.0f, radius - 8.0f, 0.0f,
-                            rotaryStartAngle, rotaryEndAngle, true);
-        g.setColour(Colors::bgDark);
-        g.strokePath(arcBg, juce::PathStrokeType(5.0f, juce::PathStrokeType::curved,
-                                                  juce::PathStrokeType::rounded));
+        // Face, ring and track are value-independent and come from the cache
+        g.drawImage(getKnobFace(radius, g.getInternalContext().getPhysicalPixelScaleFactor(),
+                                rotaryStartAngle, rotaryEndAngle),
+                    juce::Rectangle<float>(rx - knobFaceMargin, ry - knobFaceMargin,
+                                           rw + knobFaceMargin * 2.0f, rw + knobFaceMargin * 2.0f));
 
         // Value arc with gradient
         juce::Path valueArc;
@@ -143,6 +131,47 @@ public:
                       centerRadius * 2, centerRadius * 2);
     }
 
+    //==========================================================================
+    // Renders the static part of a knob once per pixel size. Every knob uses
+    // the same rotary angles, so the size is the only key.
+    const juce::Image& getKnobFace(float radius, float scale, float rotaryStartAngle, float rotaryEndAngle)
+    {
+        const float extent = radius * 2.0f + knobFaceMargin * 2.0f;
+        const int pixels = juce::jmax(1, juce::roundToInt(extent * scale));
+
+        auto& face = knobFaces[pixels];
+        if (face.isValid())
+            return face;
+
+        face = juce::Image(juce::Image::ARGB, pixels, pixels, true);
+        juce::Graphics g(face);
+        g.addTransform(juce::AffineTransform::scale(static_cast<float>(pixels) / extent));
+
+        const float centre = extent * 0.5f;
+        const float rw = radius * 2.0f;
+
+        // Background with gradient
+        juce::ColourGradient bgGradient(
+            Colors::bgLight, centre, centre - radius,
+            Colors::knobBg, centre, centre + radius, false);
+        g.setGradientFill(bgGradient);
+        g.fillEllipse(knobFaceMargin, knobFaceMargin, rw, rw);
+
+        // Outer ring
+        g.setColour(Colors::knobRing);
+        g.drawEllipse(knobFaceMargin, knobFaceMargin, rw, rw, 2.0f);
+
+        // Value arc background
+        juce::Path arcBg;
+        arcBg.addCentredArc(centre, centre, radius - 8.0f, radius - 8.0f, 0.0f,
+                            rotaryStartAngle, rotaryEndAngle, true);
+        g.setColour(Colors::bgDark);
+        g.strokePath(arcBg, juce::PathStrokeType(5.0f, juce::PathStrokeType::curved,
+                                                  juce::PathStrokeType::rounded));
+
+        return face;
+    }
+
     //==========================================================================
     void drawButtonBackground(juce::Graphics& g, juce::Button& button,
                               const juce::Colour&, bool shouldDrawButtonAsHighlighted,
@@ -221,6 +250,10 @@ public:
     {
         return juce::Font(juce::FontOptions(13.0f).withStyle("Bold"));
     }
+
+private:
+    static constexpr float knobFaceMargin = 2.0f;   // room for the ring stroke
+    std::map<int, juce::Image> knobFaces;
 };
 
 } // namespace Aura
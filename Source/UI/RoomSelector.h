@@ -106,30 +106,35 @@ private:
 /**
  * Decay Visualizer
  *
- * Shows reverb tail envelope visualization
+ * Shows reverb tail envelope visualization. Driven by its owner's setters
+ * and only repaints, and rebuilds the curve, when a value visibly changes.
  */
-class DecayVisualizer : public juce::Component,
-                        public juce::Timer
+class DecayVisualizer : public juce::Component
 {
 public:
-    DecayVisualizer()
-    {
-        startTimerHz(30);
-    }
+    DecayVisualizer() = default;
 
     void setDecayLevel(float level)
     {
-        currentLevel = level;
+        if (std::abs(level - currentLevel) > 0.005f)
+        {
+            currentLevel = level;
+            invalidateCurve();
+        }
     }
 
     void setDecayTime(float seconds)
     {
-        decayTime = seconds;
+        if (std::abs(seconds - decayTime) > 0.005f)
+        {
+            decayTime = seconds;
+            invalidateCurve();
+        }
     }
 
-    void timerCallback() override
+    void resized() override
     {
-        repaint();
+        invalidateCurve();
     }
 
     void paint(juce::Graphics& g) override
@@ -140,25 +145,8 @@ public:
         g.setColour(AuraLookAndFeel::Colors::bgDark);
         g.fillRoundedRectangle(bounds, 4.0f);
 
-        // Decay curve
-        juce::Path curve;
-        float w = bounds.getWidth();
-        float h = bounds.getHeight();
-
-        curve.startNewSubPath(bounds.getX(), bounds.getBottom());
-
-        float decayFactor = juce::jmax(0.1f, decayTime / 10.0f);
-
-        for (float x = 0; x <= w; x += 2.0f)
-        {
-            float t = x / w;
-            float amplitude = std::exp(-3.0f * t / decayFactor) * currentLevel;
-            float y = bounds.getBottom() - (h * 0.9f * amplitude);
-            curve.lineTo(bounds.getX() + x, y);
-        }
-
-        curve.lineTo(bounds.getRight(), bounds.getBottom());
-        curve.closeSubPath();
+        if (curveDirty)
+            rebuildCurve(bounds);
 
         // Gradient fill
         juce::ColourGradient gradient(
@@ -179,8 +167,42 @@ public:
     }
 
 private:
+    void invalidateCurve()
+    {
+        curveDirty = true;
+        repaint();
+    }
+
+    void rebuildCurve(juce::Rectangle<float> bounds)
+    {
+        curveDirty = false;
+        curve.clear();
+
+        // Decay curve
+        float w = bounds.getWidth();
+        float h = bounds.getHeight();
+
+        curve.startNewSubPath(bounds.getX(), bounds.getBottom());
+
+        float decayFactor = juce::jmax(0.1f, decayTime / 10.0f);
+
+        for (float x = 0; x <= w; x += 2.0f)
+        {
+            float t = x / w;
+            float amplitude = std::exp(-3.0f * t / decayFactor) * currentLevel;
+            float y = bounds.getBottom() - (h * 0.9f * amplitude);
+            curve.lineTo(bounds.getX() + x, y);
+        }
+
+        curve.lineTo(bounds.getRight(), bounds.getBottom());
+        curve.closeSubPath();
+    }
+
     float currentLevel = 0.0f;
     float decayTime = 2.0f;
+
+    juce::Path curve;
+    bool curveDirty = true;
 };
 
 } // namespace Aura
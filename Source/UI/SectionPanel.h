@@ -96,7 +96,8 @@ namespace Aura
  * Dropdown for selecting presets with save functionality
  */
 class PresetSelector : public juce::Component,
-                       public juce::ComboBox::Listener
+                       public juce::ComboBox::Listener,
+                       private juce::ChangeListener
 {
 public:
     PresetSelector(PresetManager& pm)
@@ -116,10 +117,18 @@ public:
         nextButton.onClick = [this]() { navigatePreset(1); };
         addAndMakeVisible(nextButton);
 
+        // User presets arrive from the background indexer
+        presetManager.getPresetIndexer().addChangeListener(this);
+
         // Populate with presets from PresetManager
         refreshPresetList();
     }
 
+    ~PresetSelector() override
+    {
+        presetManager.getPresetIndexer().removeChangeListener(this);
+    }
+
     void resized() override
     {
         auto bounds = getLocalBounds();
@@ -138,15 +147,21 @@ public:
     void comboBoxChanged(juce::ComboBox*) override
     {
         int selectedIndex = presetBox.getSelectedId() - 1; // ComboBox IDs are 1-based
-        if (selectedIndex >= 0)
+        int numFactory = presetManager.getNumFactoryPresets();
+
+        if (selectedIndex >= 0 && selectedIndex < numFactory)
         {
             presetManager.loadFactoryPreset(selectedIndex);
         }
+        else if (selectedIndex >= numFactory && selectedIndex - numFactory < userPresetNames.size())
+        {
+            presetManager.loadPreset(userPresetNames[selectedIndex - numFactory]);
+        }
     }
 
     void refreshPresetList()
     {
-        presetBox.clear();
+        presetBox.clear(juce::dontSendNotification);
 
         // Get factory presets from PresetManager
         auto presetNames = presetManager.getFactoryPresetNames();
@@ -155,12 +170,35 @@ public:
             presetBox.addItem(presetNames[i], i + 1); // ComboBox IDs are 1-based
         }
 
+        // User presets follow, with IDs continuing so navigation walks both lists
+        userPresetNames.clearQuick();
+        for (const auto& entry : presetManager.getPresetIndexer().getSnapshot().entries)
+            userPresetNames.add(entry.name);
+
+        if (!userPresetNames.isEmpty())
+        {
+            presetBox.addSectionHeading("User");
+            for (int i = 0; i < userPresetNames.size(); ++i)
+                presetBox.addItem(userPresetNames[i], presetNames.size() + i + 1);
+        }
+
         // Select current preset
         int currentIndex = presetManager.getCurrentPresetIndex();
+        if (currentIndex < 0)
+        {
+            int userIndex = userPresetNames.indexOf(presetManager.getCurrentPresetName());
+            currentIndex = userIndex >= 0 ? presetNames.size() + userIndex : -1;
+        }
+
         presetBox.setSelectedId(currentIndex + 1, juce::dontSendNotification);
     }
 
 private:
+    void changeListenerCallback(juce::ChangeBroadcaster*) override
+    {
+        refreshPresetList();
+    }
+
     void navigatePreset(int direction)
     {
         int current = presetBox.getSelectedId();
@@ -174,6 +212,7 @@ private:
     }
 
     PresetManager& presetManager;
+    juce::StringArray userPresetNames;
     juce::ComboBox presetBox;
     juce::TextButton prevButton, nextButton;
 };
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Parameters.h"
+#include <iterator>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * A factory preset as plain values. Parameters it doesn't list load at
+ * their defaults. The table below is built at compile time, so creating a
+ * processor costs nothing for it; XML is only made when one is exported.
+ */
+struct FactoryPreset
+{
+    const char* name;
+    const char* category;
+    int roomType;
+    float size;
+    float decay;
+    float damping;
+    float preDelay;
+    float width;
+    float mix;
+    float erLevel;
+    float erSize;
+    float highCut;
+    float lowCut;
+
+    // Calls function(id, value) for every parameter the preset sets
+    template <typename Function>
+    void forEachValue(Function&& function) const
+    {
+        function(ParamIDs::roomType, static_cast<float>(roomType));
+        function(ParamIDs::size, size);
+        function(ParamIDs::decay, decay);
+        function(ParamIDs::damping, damping);
+        function(ParamIDs::preDelay, preDelay);
+        function(ParamIDs::width, width);
+        function(ParamIDs::mix, mix);
+        function(ParamIDs::erLevel, erLevel);
+        function(ParamIDs::erSize, erSize);
+        function(ParamIDs::highCut, highCut);
+        function(ParamIDs::lowCut, lowCut);
+    }
+};
+
+namespace FactoryPresets
+{
+    // Room types: 0 Booth, 1 Room, 2 Hall, 3 Cathedral
+    inline constexpr FactoryPreset presets[] =
+    {
+        //  name            category        room  size    decay  damp   pre    width   mix    erLvl  erSize highCut   lowCut
+        { "Init",           "Default",      Defaults::roomType, Defaults::size, Defaults::decay, Defaults::damping,
+                                            Defaults::preDelay, Defaults::width, Defaults::mix, Defaults::erLevel,
+                                            Defaults::erSize, Defaults::highCut, Defaults::lowCut },
+        { "Vocal Booth",    "Vocals",       0,    30.0f,  0.5f,  60.0f, 5.0f,  80.0f,  20.0f, 70.0f, 40.0f, 8000.0f,  150.0f },
+        { "Warm Room",      "Rooms",        1,    50.0f,  1.2f,  55.0f, 15.0f, 100.0f, 30.0f, 50.0f, 50.0f, 10000.0f, 100.0f },
+        { "Live Room",      "Rooms",        1,    65.0f,  1.8f,  30.0f, 20.0f, 100.0f, 35.0f, 60.0f, 55.0f, 14000.0f, 80.0f },
+        { "Concert Hall",   "Halls",        2,    75.0f,  2.5f,  45.0f, 35.0f, 100.0f, 40.0f, 45.0f, 70.0f, 12000.0f, 60.0f },
+        { "Cathedral",      "Large Spaces", 3,    90.0f,  4.5f,  40.0f, 50.0f, 100.0f, 45.0f, 35.0f, 85.0f, 10000.0f, 50.0f },
+        { "Ambient Pad",    "Creative",     3,    100.0f, 7.0f,  65.0f, 80.0f, 100.0f, 60.0f, 20.0f, 90.0f, 8000.0f,  100.0f },
+        { "Drum Room",      "Drums",        1,    55.0f,  0.8f,  50.0f, 0.0f,  90.0f,  25.0f, 80.0f, 45.0f, 12000.0f, 120.0f },
+        { "Snare Plate",    "Drums",        0,    40.0f,  1.5f,  25.0f, 0.0f,  70.0f,  30.0f, 30.0f, 30.0f, 16000.0f, 200.0f },
+        { "Dark Chamber",   "Creative",     2,    70.0f,  3.0f,  80.0f, 40.0f, 100.0f, 35.0f, 40.0f, 60.0f, 4000.0f,  80.0f },
+    };
+
+    inline constexpr int numPresets = static_cast<int>(std::size(presets));
+
+    // Index of the preset with that name, or -1
+    inline int indexOf(const juce::String& name)
+    {
+        for (int i = 0; i < numPresets; ++i)
+            if (name == presets[i].name)
+                return i;
+
+        return -1;
+    }
+}
+
+} // namespace Aura
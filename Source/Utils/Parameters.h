@@ -48,6 +48,26 @@ namespace RoomPresets
     }
 }
 
+//==============================================================================
+// Quality Tiers
+//==============================================================================
+enum class QualityTier
+{
+    High = 0,   // 32-bit float delay lines
+    Eco         // 16-bit float delay lines: half the memory, ~-65 dB noise floor
+};
+
+namespace QualityTiers
+{
+    inline const juce::StringArray names = { "HIGH", "ECO" };
+}
+
+// Processing levels the CPU governor steps through, lightest load last
+namespace CpuLevels
+{
+    inline const juce::StringArray names = { "FULL", "NO MOD", "REDUCED", "MINIMAL" };
+}
+
 //==============================================================================
 // Parameter IDs
 //==============================================================================
@@ -63,6 +83,14 @@ namespace ParamIDs
     inline const juce::String preDelay { "preDelay" };
     inline const juce::String width { "width" };
     inline const juce::String mix { "mix" };
+    inline const juce::String equalPowerMix { "equalPowerMix" };
+    inline const juce::String sendMode { "sendMode" };
+    inline const juce::String quality { "quality" };
+    inline const juce::String adaptiveQuality { "adaptiveQuality" };
+
+    // Host bypass. Kept in the state but left out of presets, so loading a
+    // sound never bypasses or wakes the plugin.
+    inline const juce::String bypass { "bypass" };
 
     // Early reflections
     inline const juce::String erLevel { "erLevel" };
@@ -86,6 +114,20 @@ namespace ParamIDs
     inline const juce::String highDecay { "highDecay" };
     inline const juce::String crossoverLow { "crossoverLow" };
     inline const juce::String crossoverHigh { "crossoverHigh" };
+
+    // Preset morph
+    inline const juce::String morph { "morph" };
+
+    // Fixed order used by the binary state format.
+    // Append new IDs at the end; never reorder or remove entries.
+    inline const juce::StringArray stateOrder {
+        roomType, size, decay, damping, preDelay, width, mix,
+        erLevel, erSize, highCut, lowCut, inputGain, outputGain,
+        modDepth, modRate,
+        lowDecay, midDecay, highDecay, crossoverLow, crossoverHigh,
+        morph, equalPowerMix, sendMode, quality, adaptiveQuality,
+        bypass
+    };
 }
 
 //==============================================================================
@@ -100,6 +142,11 @@ namespace Defaults
     constexpr float preDelay = 10.0f;    // ms
     constexpr float width = 100.0f;      // %
     constexpr float mix = 30.0f;         // %
+    constexpr bool equalPowerMix = false;
+    constexpr bool sendMode = false;     // insert
+    constexpr int quality = 0;           // High
+    constexpr bool adaptiveQuality = false;   // opt in: shedding changes the sound
+    constexpr bool bypass = false;
     constexpr float erLevel = 50.0f;     // %
     constexpr float erSize = 50.0f;      // %
     constexpr float highCut = 12000.0f;  // Hz
@@ -117,6 +164,9 @@ namespace Defaults
     constexpr float highDecay = 100.0f;  // %
     constexpr float crossoverLow = 200.0f;   // Hz
     constexpr float crossoverHigh = 4000.0f; // Hz
+
+    // Preset morph
+    constexpr float morph = 0.0f;        // % (all preset A)
 }
 
 //==============================================================================
@@ -316,6 +366,50 @@ inline juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout
         Defaults::crossoverHigh,
         juce::AudioParameterFloatAttributes().withLabel("Hz")));
 
+    // Preset Morph (A -> B)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        juce::ParameterID{ ParamIDs::morph, 1 },
+        "Morph",
+        juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+        Defaults::morph,
+        juce::AudioParameterFloatAttributes().withLabel("%")));
+
+    // Mix law: linear (default) or equal-power
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ ParamIDs::equalPowerMix, 1 },
+        "Equal Power Mix",
+        Defaults::equalPowerMix));
+
+    // Send mode: 100% wet from a mono sum, for use on an aux send.
+    // Switching it changes the signal flow, so it isn't automatable.
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ ParamIDs::sendMode, 1 },
+        "Send Mode",
+        Defaults::sendMode,
+        juce::AudioParameterBoolAttributes().withAutomatable(false)));
+
+    // Quality tier: the storage format of the delay lines. Changing it
+    // reallocates an engine, so it isn't automatable either.
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        juce::ParameterID{ ParamIDs::quality, 1 },
+        "Quality",
+        QualityTiers::names,
+        Defaults::quality,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+
+    // Adaptive quality: lets the CPU governor shed work under load
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ ParamIDs::adaptiveQuality, 1 },
+        "Adaptive Quality",
+        Defaults::adaptiveQuality,
+        juce::AudioParameterBoolAttributes().withAutomatable(false)));
+
+    // Bypass, handed to the host through getBypassParameter()
+    params.push_back(std::make_unique<juce::AudioParameterBool>(
+        juce::ParameterID{ ParamIDs::bypass, 1 },
+        "Bypass",
+        Defaults::bypass));
+
     return { params.begin(), params.end() };
 }
 
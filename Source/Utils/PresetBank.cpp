@@ -0,0 +1,342 @@
+#include "PresetBank.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <map>
+
+namespace Aura
+{
+
+namespace
+{
+    constexpr size_t headerSize = 9 * sizeof(juce::uint32);
+    constexpr size_t entrySize = 3 * sizeof(juce::uint32);
+
+    // String pool writer that de-duplicates repeated strings (categories mostly)
+    struct StringPool
+    {
+        juce::uint32 add(const juce::String& text)
+        {
+            auto existing = offsets.find(text);
+            if (existing != offsets.end())
+                return existing->second;
+
+            auto offset = static_cast<juce::uint32>(stream.getDataSize());
+            auto utf8 = text.toRawUTF8();
+            auto numBytes = static_cast<juce::uint32>(text.getNumBytesAsUTF8());
+            stream.writeInt(static_cast<int>(numBytes));
+            stream.write(utf8, numBytes);
+
+            offsets[text] = offset;
+            return offset;
+        }
+
+        juce::MemoryOutputStream stream;
+        std::map<juce::String, juce::uint32> offsets;
+    };
+
+    void padToFourBytes(juce::MemoryOutputStream& stream)
+    {
+        while ((stream.getDataSize() & 3) != 0)
+            stream.writeByte(0);
+    }
+}
+
+//==============================================================================
+bool PresetBank::open(const juce::File& file)
+{
+    close();
+
+    if (!file.existsAsFile())
+        return false;
+
+    // Read into memory rather than kept mapped: Windows can't replace a file
+    // while any process or instance has it mapped, and every instance's
+    // indexer reads the bank whenever it changes
+    if (!file.loadFileAsData(contents) || contents.getSize() == 0)
+    {
+        close();
+        return false;
+    }
+
+    data = static_cast<const char*>(contents.getData());
+    dataSize = contents.getSize();
+
+    if (data == nullptr || dataSize < headerSize
+        || readUInt(0) != magic || readUInt(4) == 0 || readUInt(4) > currentVersion)
+    {
+        close();
+        return false;
+    }
+
+    numPresets = readUInt(8);
+    numParameters = readUInt(12);
+    hashTableSize = readUInt(16);
+    parameterTableOffset = readUInt(20);
+    entryTableOffset = readUInt(24);
+    hashTableOffset = readUInt(28);
+    valuesOffset = readUInt(32);
+
+    if (!validate())
+    {
+        close();
+        return false;
+    }
+
+    for (juce::uint32 i = 0; i < numParameters; ++i)
+        parameterIds.add(readString(readUInt(parameterTableOffset + i * sizeof(juce::uint32))));
+
+    return true;
+}
+
+void PresetBank::close()
+{
+    contents.reset();
+    data = nullptr;
+    dataSize = 0;
+    numPresets = 0;
+    numParameters = 0;
+    hashTableSize = 0;
+    parameterIds.clear();
+}
+
+bool PresetBank::validate() const
+{
+    auto fits = [this](juce::uint64 offset, juce::uint64 size)
+    {
+        return offset + size <= static_cast<juce::uint64>(dataSize);
+    };
+
+    // The hash index needs a power-of-two size with at least one empty slot
+    if (hashTableSize == 0 || (hashTableSize & (hashTableSize - 1)) != 0 || hashTableSize <= numPresets)
+        return false;
+
+    return fits(parameterTableOffset, juce::uint64(numParameters) * sizeof(juce::uint32))
+        && fits(entryTableOffset, juce::uint64(numPresets) * entrySize)
+        && fits(hashTableOffset, juce::uint64(hashTableSize) * sizeof(juce::uint32))
+        && fits(valuesOffset, juce::uint64(numPresets) * numParameters * sizeof(float));
+}
+
+juce::uint32 PresetBank::readUInt(size_t offset) const
+{
+    return juce::ByteOrder::littleEndianInt(data + offset);
+}
+
+juce::String PresetBank::readString(juce::uint32 offset) const
+{
+    if (static_cast<size_t>(offset) + sizeof(juce::uint32) > dataSize)
+        return {};
+
+    auto numBytes = static_cast<size_t>(readUInt(offset));
+    auto start = static_cast<size_t>(offset) + sizeof(juce::uint32);
+
+    if (start + numBytes > dataSize)
+        return {};
+
+    return juce::String::fromUTF8(data + start, static_cast<int>(numBytes));
+}
+
+//==============================================================================
+juce::String PresetBank::getName(int index) const
+{
+    if (!juce::isPositiveAndBelow(index, getNumPresets()))
+        return {};
+
+    return readString(readUInt(entryTableOffset + static_cast<size_t>(index) * entrySize));
+}
+
+juce::String PresetBank::getCategory(int index) const
+{
+    if (!juce::isPositiveAndBelow(index, getNumPresets()))
+        return {};
+
+    return readString(readUInt(entryTableOffset + static_cast<size_t>(index) * entrySize + 4));
+}
+
+juce::StringArray PresetBank::getNames() const
+{
+    juce::StringArray names;
+    names.ensureStorageAllocated(getNumPresets());
+
+    for (int i = 0; i < getNumPresets(); ++i)
+        names.add(getName(i));
+
+    return names;
+}
+
+int PresetBank::indexOf(const juce::String& name) const
+{
+    if (!isOpen() || numPresets == 0)
+        return -1;
+
+    const auto hash = hashName(name);
+    const auto mask = hashTableSize - 1;
+
+    // Linear probing. A valid table always has an empty slot, but a corrupt
+    // one may not, so the probe never visits a slot twice.
+    auto slot = hash & mask;
+
+    for (juce::uint32 probe = 0; probe < hashTableSize; ++probe, slot = (slot + 1) & mask)
+    {
+        auto stored = readUInt(hashTableOffset + slot * sizeof(juce::uint32));
+        if (stored == 0 || stored > numPresets)
+            return -1;
+
+        auto index = static_cast<int>(stored - 1);
+        auto entry = entryTableOffset + static_cast<size_t>(index) * entrySize;
+
+        if (readUInt(entry + 8) == hash && getName(index) == name)
+            return index;
+    }
+
+    return -1;
+}
+
+bool PresetBank::getPreset(int index, Preset& result) const
+{
+    if (!juce::isPositiveAndBelow(index, getNumPresets()))
+        return false;
+
+    result.name = getName(index);
+    result.category = getCategory(index);
+    result.values.resize(numParameters);
+
+    auto row = data + valuesOffset + static_cast<size_t>(index) * numParameters * sizeof(float);
+    for (juce::uint32 i = 0; i < numParameters; ++i)
+    {
+        auto bits = juce::ByteOrder::littleEndianInt(row + i * sizeof(float));
+        std::memcpy(&result.values[i], &bits, sizeof(float));
+    }
+
+    return true;
+}
+
+std::vector<PresetBank::Preset> PresetBank::getAllPresets() const
+{
+    std::vector<Preset> presets(static_cast<size_t>(getNumPresets()));
+
+    for (int i = 0; i < getNumPresets(); ++i)
+        getPreset(i, presets[static_cast<size_t>(i)]);
+
+    return presets;
+}
+
+//==============================================================================
+juce::uint32 PresetBank::hashName(const juce::String& name)
+{
+    // FNV-1a over the UTF-8 bytes
+    juce::uint32 hash = 2166136261u;
+    for (auto p = name.toRawUTF8(); *p != 0; ++p)
+    {
+        hash ^= static_cast<juce::uint8>(*p);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool PresetBank::write(const juce::File& file,
+                       const juce::StringArray& ids,
+                       std::vector<Preset> presets)
+{
+    // Sort by name and drop duplicates, keeping the most recently added
+    std::stable_sort(presets.begin(), presets.end(), [](const Preset& a, const Preset& b)
+    {
+        auto order = a.name.compareNatural(b.name);
+        return order != 0 ? order < 0 : a.name.compare(b.name) < 0;
+    });
+
+    std::vector<Preset> unique;
+    unique.reserve(presets.size());
+    for (auto& preset : presets)
+    {
+        if (!unique.empty() && unique.back().name == preset.name)
+            unique.back() = std::move(preset);
+        else
+            unique.push_back(std::move(preset));
+    }
+
+    const auto count = static_cast<juce::uint32>(unique.size());
+    const auto numParams = static_cast<juce::uint32>(ids.size());
+
+    juce::uint32 tableSize = 8;
+    while (tableSize < count * 2)
+        tableSize <<= 1;
+
+    // Strings
+    StringPool pool;
+    std::vector<juce::uint32> parameterOffsets;
+    for (auto& id : ids)
+        parameterOffsets.push_back(pool.add(id));
+
+    std::vector<juce::uint32> nameOffsets, categoryOffsets, hashes;
+    for (auto& preset : unique)
+    {
+        nameOffsets.push_back(pool.add(preset.name));
+        categoryOffsets.push_back(pool.add(preset.category));
+        hashes.push_back(hashName(preset.name));
+    }
+
+    // Hash index
+    std::vector<juce::uint32> slots(tableSize, 0);
+    for (juce::uint32 i = 0; i < count; ++i)
+    {
+        auto slot = hashes[i] & (tableSize - 1);
+        while (slots[slot] != 0)
+            slot = (slot + 1) & (tableSize - 1);
+        slots[slot] = i + 1;
+    }
+
+    // Offsets
+    const auto parameterTable = static_cast<juce::uint32>(headerSize);
+    const auto entryTable = parameterTable + numParams * static_cast<juce::uint32>(sizeof(juce::uint32));
+    const auto hashTable = entryTable + count * static_cast<juce::uint32>(entrySize);
+    const auto stringPool = hashTable + tableSize * static_cast<juce::uint32>(sizeof(juce::uint32));
+    const auto values = (stringPool + static_cast<juce::uint32>(pool.stream.getDataSize()) + 3u) & ~3u;
+
+    juce::MemoryOutputStream out;
+    out.writeInt(static_cast<int>(magic));
+    out.writeInt(static_cast<int>(currentVersion));
+    out.writeInt(static_cast<int>(count));
+    out.writeInt(static_cast<int>(numParams));
+    out.writeInt(static_cast<int>(tableSize));
+    out.writeInt(static_cast<int>(parameterTable));
+    out.writeInt(static_cast<int>(entryTable));
+    out.writeInt(static_cast<int>(hashTable));
+    out.writeInt(static_cast<int>(values));
+
+    for (auto offset : parameterOffsets)
+        out.writeInt(static_cast<int>(stringPool + offset));
+
+    for (juce::uint32 i = 0; i < count; ++i)
+    {
+        out.writeInt(static_cast<int>(stringPool + nameOffsets[i]));
+        out.writeInt(static_cast<int>(stringPool + categoryOffsets[i]));
+        out.writeInt(static_cast<int>(hashes[i]));
+    }
+
+    for (auto slot : slots)
+        out.writeInt(static_cast<int>(slot));
+
+    out.write(pool.stream.getData(), pool.stream.getDataSize());
+    padToFourBytes(out);
+    jassert(out.getDataSize() == values);
+
+    for (auto& preset : unique)
+    {
+        for (juce::uint32 i = 0; i < numParams; ++i)
+        {
+            auto value = i < preset.values.size() ? preset.values[i]
+                                                  : std::numeric_limits<float>::quiet_NaN();
+            out.writeFloat(value);
+        }
+    }
+
+    // Write next to the target and swap it in, so a crash never leaves a torn bank
+    juce::TemporaryFile temp(file);
+    if (!temp.getFile().replaceWithData(out.getData(), out.getDataSize()))
+        return false;
+
+    return temp.overwriteTargetFileWithTemporary();
+}
+
+} // namespace Aura
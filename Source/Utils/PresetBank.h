@@ -0,0 +1,89 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Preset Bank
+ *
+ * Versioned binary container holding every user preset in a single file.
+ * The file is read in one go and carries an on-disk hash index, so listing
+ * presets or looking one up by name never parses anything. No handle stays
+ * open, so another instance can replace the file at any time.
+ *
+ * Layout (little-endian):
+ *   Header        magic, version, preset/parameter counts, table offsets
+ *   Parameters    one string offset per parameter ID
+ *   Entries       name offset, category offset, name hash per preset (sorted by name)
+ *   Hash index    open-addressed slots holding entry index + 1 (0 = empty)
+ *   String pool   length-prefixed UTF-8
+ *   Values        numPresets x numParameters floats, NaN = not stored
+ */
+class PresetBank
+{
+public:
+    static constexpr juce::uint32 magic = 0x42525541;   // "AURB"
+    static constexpr juce::uint32 currentVersion = 1;
+
+    struct Preset
+    {
+        juce::String name;
+        juce::String category;
+        std::vector<float> values;   // aligned with the bank's parameter IDs
+    };
+
+    PresetBank() = default;
+
+    // Reads a bank file into memory. Returns false if it is missing or invalid.
+    bool open(const juce::File& file);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    int getNumPresets() const { return static_cast<int>(numPresets); }
+    const juce::StringArray& getParameterIds() const { return parameterIds; }
+
+    juce::String getName(int index) const;
+    juce::String getCategory(int index) const;
+    juce::StringArray getNames() const;
+
+    // Hash lookup, returns -1 if the name is not in the bank
+    int indexOf(const juce::String& name) const;
+
+    bool getPreset(int index, Preset& result) const;
+    std::vector<Preset> getAllPresets() const;
+
+    // Writes a complete bank, replacing the target file atomically.
+    // Presets are sorted by name; for duplicate names the last one wins.
+    static bool write(const juce::File& file,
+                      const juce::StringArray& ids,
+                      std::vector<Preset> presets);
+
+    static juce::uint32 hashName(const juce::String& name);
+
+private:
+    juce::uint32 readUInt(size_t offset) const;
+    juce::String readString(juce::uint32 offset) const;
+    bool validate() const;
+
+    juce::MemoryBlock contents;
+    const char* data = nullptr;
+    size_t dataSize = 0;
+
+    juce::uint32 numPresets = 0;
+    juce::uint32 numParameters = 0;
+    juce::uint32 hashTableSize = 0;
+    juce::uint32 parameterTableOffset = 0;
+    juce::uint32 entryTableOffset = 0;
+    juce::uint32 hashTableOffset = 0;
+    juce::uint32 valuesOffset = 0;
+
+    juce::StringArray parameterIds;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetBank)
+};
+
+} // namespace Aura
@@ -0,0 +1,342 @@
+#include "PresetIndexer.h"
+#include "PresetBank.h"
+#include "Parameters.h"
+#include "Trace.h"
+#include <algorithm>
+
+#if JUCE_LINUX
+ #include <poll.h>
+ #include <sys/inotify.h>
+ #include <unistd.h>
+#endif
+
+namespace Aura
+{
+
+PresetIndexer::PresetIndexer(const juce::File& presetsDirectory, const juce::String& bankName)
+    : juce::Thread("Aura Preset Indexer"),
+      directory(presetsDirectory),
+      bankFileName(bankName),
+      current(new PresetCatalogue())
+{
+}
+
+PresetIndexer::~PresetIndexer()
+{
+    stopThread(2000);
+    delete current.load();
+}
+
+void PresetIndexer::start()
+{
+    if (!isThreadRunning())
+        startThread(juce::Thread::Priority::low);
+}
+
+void PresetIndexer::requestRescan()
+{
+    rescanRequested = true;
+    notify();
+}
+
+//==============================================================================
+void PresetIndexer::run()
+{
+    AURA_TRACE_THREAD("Preset Indexer");
+
+    // Creating the directory can stall on network homes, so it happens here
+    directory.createDirectory();
+
+    if (prepareDirectory)
+        prepareDirectory();
+
+    rescanAll();
+    publishCatalogue();
+
+   #if JUCE_LINUX
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd >= 0)
+    {
+        bool watched = watchWithInotify(fd);
+        ::close(fd);
+
+        if (watched)
+            return;
+    }
+   #endif
+
+    // Fallback: compare modification times on an interval
+    while (!threadShouldExit())
+    {
+        wait(pollIntervalMs);
+        rescanRequested = false;
+
+        if (!threadShouldExit() && rescanAll())
+            publishCatalogue();
+    }
+}
+
+bool PresetIndexer::watchWithInotify(int fd)
+{
+   #if JUCE_LINUX
+    constexpr auto mask = IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO
+                        | IN_DELETE_SELF | IN_MOVE_SELF;
+
+    const auto path = directory.getFullPathName();
+    int watch = inotify_add_watch(fd, path.toRawUTF8(), mask);
+    if (watch < 0)
+        return false;
+
+    alignas(inotify_event) char buffer[4096];
+
+    while (!threadShouldExit())
+    {
+        pollfd pfd { fd, POLLIN, 0 };
+        bool overflow = false;
+        bool directoryGone = false;
+        juce::StringArray changed;
+
+        if (::poll(&pfd, 1, 250) > 0 && (pfd.revents & POLLIN) != 0)
+        {
+            // Let bursts settle; a bank rewrite is a create, a write and a rename
+            wait(50);
+
+            for (;;)
+            {
+                auto length = ::read(fd, buffer, sizeof(buffer));
+                if (length <= 0)
+                    break;
+
+                for (auto* p = buffer; p < buffer + length;)
+                {
+                    auto* event = reinterpret_cast<const inotify_event*>(p);
+
+                    if ((event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) != 0)
+                        directoryGone = true;
+                    else if ((event->mask & IN_Q_OVERFLOW) != 0)
+                        overflow = true;
+                    else if (event->len > 0)
+                        changed.addIfNotAlreadyThere(juce::String::fromUTF8(event->name));
+
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+
+        // A deleted or renamed directory takes its watch with it. The path is
+        // watched again before the rescan, so nothing dropped in between is missed.
+        if (directoryGone)
+        {
+            inotify_rm_watch(fd, watch);
+            directory.createDirectory();
+
+            watch = inotify_add_watch(fd, path.toRawUTF8(), mask);
+            if (watch < 0)
+                return false;
+        }
+
+        if (rescanRequested.exchange(false) || overflow || directoryGone)
+        {
+            if (rescanAll())
+                publishCatalogue();
+            continue;
+        }
+
+        // Only the files named in the events are re-read
+        bool anyChanged = false;
+        for (const auto& name : changed)
+        {
+            if (isIndexable(name))
+                anyChanged = refreshFile(directory.getChildFile(name)) || anyChanged;
+        }
+
+        if (anyChanged)
+            publishCatalogue();
+    }
+
+    return true;
+   #else
+    juce::ignoreUnused(fd);
+    return false;
+   #endif
+}
+
+//==============================================================================
+bool PresetIndexer::isIndexable(const juce::String& fileName) const
+{
+    return fileName == bankFileName || fileName.endsWithIgnoreCase(".xml");
+}
+
+bool PresetIndexer::rescanAll()
+{
+    AURA_TRACE_SCOPE("PresetIndexer::rescanAll");
+
+    bool changed = false;
+    std::map<juce::String, CachedFile> seen;
+
+    for (const auto& file : directory.findChildFiles(juce::File::findFiles, false))
+    {
+        if (!isIndexable(file.getFileName()))
+            continue;
+
+        changed = refreshFile(file) || changed;
+
+        auto path = file.getFullPathName();
+        seen[path] = std::move(cache[path]);
+    }
+
+    changed = changed || seen.size() != cache.size();
+    cache = std::move(seen);
+    return changed;
+}
+
+bool PresetIndexer::refreshFile(const juce::File& file)
+{
+    auto path = file.getFullPathName();
+
+    if (!file.existsAsFile())
+        return cache.erase(path) > 0;
+
+    auto modified = file.getLastModificationTime();
+    auto size = file.getSize();
+
+    auto existing = cache.find(path);
+    if (existing != cache.end() && existing->second.modified == modified && existing->second.size == size)
+        return false;
+
+    CachedFile cached;
+    cached.modified = modified;
+    cached.size = size;
+    cached.entries = file.getFileName() == bankFileName ? readBank(file) : readXmlPreset(file);
+
+    cache[path] = std::move(cached);
+    return true;
+}
+
+void PresetIndexer::publishCatalogue()
+{
+    auto next = std::make_unique<PresetCatalogue>();
+    next->generation = ++generation;
+
+    // Bank presets first, so they win over a loose XML file of the same name
+    for (bool loose : { false, true })
+    {
+        for (const auto& file : cache)
+        {
+            for (const auto& entry : file.second.entries)
+            {
+                if (entry.isLooseFile == loose)
+                    next->entries.push_back(entry);
+            }
+        }
+    }
+
+    std::stable_sort(next->entries.begin(), next->entries.end(),
+                     [](const PresetCatalogue::Entry& a, const PresetCatalogue::Entry& b)
+                     {
+                         return a.name.compareNatural(b.name) < 0;
+                     });
+
+    next->entries.erase(std::unique(next->entries.begin(), next->entries.end(),
+                                    [](const PresetCatalogue::Entry& a, const PresetCatalogue::Entry& b)
+                                    {
+                                        return a.name == b.name;
+                                    }),
+                        next->entries.end());
+
+    auto* old = current.exchange(next.release(), std::memory_order_acq_rel);
+
+    // Readers live on the message thread, so once it has drained its queue
+    // nobody can still be looking at the old snapshot
+    if (juce::MessageManager::getInstanceWithoutCreating() != nullptr)
+        juce::MessageManager::callAsync([old]() { delete old; });
+    else
+        retired.emplace_back(old);
+
+    sendChangeMessage();
+}
+
+//==============================================================================
+std::vector<PresetCatalogue::Entry> PresetIndexer::readBank(const juce::File& file)
+{
+    std::vector<PresetCatalogue::Entry> entries;
+
+    PresetBank bank;
+    if (!bank.open(file))
+        return entries;
+
+    const auto& ids = bank.getParameterIds();
+    const int roomTypeIndex = ids.indexOf(ParamIDs::roomType);
+    const int sizeIndex = ids.indexOf(ParamIDs::size);
+    const int decayIndex = ids.indexOf(ParamIDs::decay);
+    const int mixIndex = ids.indexOf(ParamIDs::mix);
+
+    auto valueAt = [](const PresetBank::Preset& preset, int index)
+    {
+        return index >= 0 ? preset.values[static_cast<size_t>(index)]
+                          : std::numeric_limits<float>::quiet_NaN();
+    };
+
+    auto modified = file.getLastModificationTime();
+    PresetBank::Preset preset;
+
+    for (int i = 0; i < bank.getNumPresets(); ++i)
+    {
+        if (!bank.getPreset(i, preset))
+            continue;
+
+        PresetCatalogue::Entry entry;
+        entry.name = preset.name;
+        entry.category = preset.category;
+        entry.modified = modified;
+        entry.source = file;
+        entry.roomType = valueAt(preset, roomTypeIndex);
+        entry.size = valueAt(preset, sizeIndex);
+        entry.decay = valueAt(preset, decayIndex);
+        entry.mix = valueAt(preset, mixIndex);
+        entry.parameterIds = ids;
+        entry.values = std::move(preset.values);
+        entries.push_back(std::move(entry));
+    }
+
+    return entries;
+}
+
+std::vector<PresetCatalogue::Entry> PresetIndexer::readXmlPreset(const juce::File& file)
+{
+    std::vector<PresetCatalogue::Entry> entries;
+
+    auto xml = juce::XmlDocument::parse(file);
+    if (xml == nullptr)
+        return entries;
+
+    // Named after the file, which is what PresetManager looks loose presets up by
+    PresetCatalogue::Entry entry;
+    entry.name = file.getFileNameWithoutExtension();
+    entry.category = xml->getStringAttribute("category", "User");
+    entry.modified = file.getLastModificationTime();
+    entry.source = file;
+    entry.isLooseFile = true;
+
+    for (auto* param : xml->getChildWithTagNameIterator("PARAM"))
+    {
+        auto id = param->getStringAttribute("id");
+        auto value = static_cast<float>(param->getDoubleAttribute("value"));
+
+        if (id == ParamIDs::roomType)   entry.roomType = value;
+        else if (id == ParamIDs::size)  entry.size = value;
+        else if (id == ParamIDs::decay) entry.decay = value;
+        else if (id == ParamIDs::mix)   entry.mix = value;
+
+        if (param->hasAttribute("value"))
+        {
+            entry.parameterIds.add(id);
+            entry.values.push_back(value);
+        }
+    }
+
+    entries.push_back(std::move(entry));
+    return entries;
+}
+
+} // namespace Aura
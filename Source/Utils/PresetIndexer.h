@@ -0,0 +1,112 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Preset Catalogue
+ *
+ * Immutable listing of the user presets directory, built by PresetIndexer.
+ */
+struct PresetCatalogue
+{
+    struct Entry
+    {
+        juce::String name;
+        juce::String category;
+        juce::Time modified;
+        juce::File source;          // the bank, or a loose XML preset
+        bool isLooseFile = false;
+
+        // Parameter summary for the browser, NaN where the preset doesn't store it
+        float roomType = std::numeric_limits<float>::quiet_NaN();
+        float size = std::numeric_limits<float>::quiet_NaN();
+        float decay = std::numeric_limits<float>::quiet_NaN();
+        float mix = std::numeric_limits<float>::quiet_NaN();
+
+        // Every stored value, in the order of parameterIds, so a preset can be
+        // loaded from the catalogue without reading the file again
+        juce::StringArray parameterIds;
+        std::vector<float> values;
+    };
+
+    std::vector<Entry> entries;     // sorted by name
+    int generation = 0;
+};
+
+//==============================================================================
+/**
+ * Preset Indexer
+ *
+ * Background thread that keeps a catalogue of the user presets directory.
+ * It refreshes only the files that changed, driven by inotify on Linux and
+ * by modification-time polling elsewhere, so the message thread never
+ * touches the disk to list presets.
+ *
+ * getSnapshot() is lock-free. Snapshots are retired through the message
+ * queue, so a pointer stays valid until the message thread returns to its
+ * event loop; don't hold on to it across callbacks.
+ */
+class PresetIndexer : public juce::ChangeBroadcaster,
+                      private juce::Thread
+{
+public:
+    PresetIndexer(const juce::File& presetsDirectory, const juce::String& bankName);
+    ~PresetIndexer() override;
+
+    // Runs on the indexer thread before its first scan, with the directory
+    // created, e.g. to build the bank from an older library. Set it before start().
+    std::function<void()> prepareDirectory;
+
+    void start();
+
+    // Message thread
+    const PresetCatalogue& getSnapshot() const { return *current.load(std::memory_order_acquire); }
+
+    // Forces a full rescan, e.g. after this process rewrote the bank
+    void requestRescan();
+
+private:
+    void run() override;
+    // Returns false if the directory couldn't be watched, so polling takes over
+    bool watchWithInotify(int fd);
+
+    bool rescanAll();
+    bool refreshFile(const juce::File& file);
+    bool isIndexable(const juce::String& fileName) const;
+    void publishCatalogue();
+
+    static std::vector<PresetCatalogue::Entry> readBank(const juce::File& file);
+    static std::vector<PresetCatalogue::Entry> readXmlPreset(const juce::File& file);
+
+    const juce::File directory;
+    const juce::String bankFileName;
+
+    // Indexer thread only
+    struct CachedFile
+    {
+        juce::Time modified;
+        juce::int64 size = 0;
+        std::vector<PresetCatalogue::Entry> entries;
+    };
+    std::map<juce::String, CachedFile> cache;
+    int generation = 0;
+
+    std::atomic<PresetCatalogue*> current;
+    std::vector<std::unique_ptr<PresetCatalogue>> retired;
+    std::atomic<bool> rescanRequested { false };
+
+    static constexpr int pollIntervalMs = 2000;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetIndexer)
+};
+
+} // namespace Aura
@@ -1,377 +1,268 @@
 #include "PresetManager.h"
+#include "FactoryPresets.h"
 #include "Parameters.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace Aura
 {
 
-PresetManager::PresetManager(juce::AudioProcessorValueTreeState& apvts)
-    : valueTreeState(apvts)
+PresetManager::PresetManager(juce::AudioProcessorValueTreeState& apvts, const juce::File& presetsDirectory)
+    : valueTreeState(apvts),
+      userPresetsDirectory(presetsDirectory),
+      parameterIds(collectParameterIds(apvts)),
+      stateType(apvts.state.getType())
 {
-    createFactoryPresets();
 }
 
 juce::File PresetManager::getUserPresetsDirectory() const
 {
-    auto presetDir = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
-                         .getChildFile("SeshNx")
-                         .getChildFile("Aura")
-                         .getChildFile("Presets");
+    if (userPresetsDirectory != juce::File())
+        return userPresetsDirectory;
+
+    // Path only; the directory is created by whoever first writes to it,
+    // so listing presets never blocks on a slow home directory
+    return juce::File::getSpecialLocation(juce::File::userDocumentsDirectory)
+               .getChildFile("SeshNx")
+               .getChildFile("Aura")
+               .getChildFile("Presets");
+}
 
-    if (!presetDir.exists())
-    {
-        presetDir.createDirectory();
-    }
+juce::File PresetManager::getUserBankFile() const
+{
+    return getUserPresetsDirectory().getChildFile("UserPresets.aurabank");
+}
 
-    return presetDir;
+PresetManager::~PresetManager()
+{
+    // Its thread may be building the bank, which uses the members below
+    presetIndexer.reset();
 }
 
-void PresetManager::createFactoryPresets()
+PresetIndexer& PresetManager::getPresetIndexer() const
 {
-    // 1. Init - Default settings
+    if (presetIndexer == nullptr)
     {
-        FactoryPreset preset;
-        preset.name = "Init";
-        preset.category = "Default";
-        factoryPresets.push_back(std::move(preset));
+        presetIndexer = std::make_unique<PresetIndexer>(getUserPresetsDirectory(),
+                                                        getUserBankFile().getFileName());
+        presetIndexer->prepareDirectory = [this]() { buildInitialBank(); };
+        presetIndexer->start();
     }
 
-    // 2. Vocal Booth - Tight, intimate space
-    {
-        FactoryPreset preset;
-        preset.name = "Vocal Booth";
-        preset.category = "Vocals";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 0);      // Booth
-        xml->setAttribute(ParamIDs::size, 30.0f);
-        xml->setAttribute(ParamIDs::decay, 0.5f);
-        xml->setAttribute(ParamIDs::damping, 60.0f);
-        xml->setAttribute(ParamIDs::preDelay, 5.0f);
-        xml->setAttribute(ParamIDs::width, 80.0f);
-        xml->setAttribute(ParamIDs::mix, 20.0f);
-        xml->setAttribute(ParamIDs::erLevel, 70.0f);
-        xml->setAttribute(ParamIDs::erSize, 40.0f);
-        xml->setAttribute(ParamIDs::highCut, 8000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 150.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
-    }
+    return *presetIndexer;
+}
 
-    // 3. Warm Room - Natural room sound
-    {
-        FactoryPreset preset;
-        preset.name = "Warm Room";
-        preset.category = "Rooms";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 1);      // Room
-        xml->setAttribute(ParamIDs::size, 50.0f);
-        xml->setAttribute(ParamIDs::decay, 1.2f);
-        xml->setAttribute(ParamIDs::damping, 55.0f);
-        xml->setAttribute(ParamIDs::preDelay, 15.0f);
-        xml->setAttribute(ParamIDs::width, 100.0f);
-        xml->setAttribute(ParamIDs::mix, 30.0f);
-        xml->setAttribute(ParamIDs::erLevel, 50.0f);
-        xml->setAttribute(ParamIDs::erSize, 50.0f);
-        xml->setAttribute(ParamIDs::highCut, 10000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 100.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
-    }
+bool PresetManager::savePreset(const juce::String& presetName)
+{
+    AURA_TRACE_SCOPE("PresetManager::savePreset");
 
-    // 4. Live Room - Bright, lively space
-    {
-        FactoryPreset preset;
-        preset.name = "Live Room";
-        preset.category = "Rooms";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 1);      // Room
-        xml->setAttribute(ParamIDs::size, 65.0f);
-        xml->setAttribute(ParamIDs::decay, 1.8f);
-        xml->setAttribute(ParamIDs::damping, 30.0f);
-        xml->setAttribute(ParamIDs::preDelay, 20.0f);
-        xml->setAttribute(ParamIDs::width, 100.0f);
-        xml->setAttribute(ParamIDs::mix, 35.0f);
-        xml->setAttribute(ParamIDs::erLevel, 60.0f);
-        xml->setAttribute(ParamIDs::erSize, 55.0f);
-        xml->setAttribute(ParamIDs::highCut, 14000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 80.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
-    }
+    const juce::ScopedLock lock(bankLock);
+    auto presets = getUserBankPresets();
+    presets.push_back(captureCurrentState(presetName));
+
+    if (!writeUserBank(std::move(presets)))
+        return false;
+
+    currentPresetName = presetName;
+    presetModified = false;
+    return true;
+}
 
-    // 5. Concert Hall - Large, smooth hall
+void PresetManager::loadPreset(const juce::String& presetName)
+{
+    AURA_TRACE_SCOPE("PresetManager::loadPreset");
+
+    // First check factory presets
+    if (auto index = FactoryPresets::indexOf(presetName); index >= 0)
     {
-        FactoryPreset preset;
-        preset.name = "Concert Hall";
-        preset.category = "Halls";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 2);      // Hall
-        xml->setAttribute(ParamIDs::size, 75.0f);
-        xml->setAttribute(ParamIDs::decay, 2.5f);
-        xml->setAttribute(ParamIDs::damping, 45.0f);
-        xml->setAttribute(ParamIDs::preDelay, 35.0f);
-        xml->setAttribute(ParamIDs::width, 100.0f);
-        xml->setAttribute(ParamIDs::mix, 40.0f);
-        xml->setAttribute(ParamIDs::erLevel, 45.0f);
-        xml->setAttribute(ParamIDs::erSize, 70.0f);
-        xml->setAttribute(ParamIDs::highCut, 12000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 60.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
+        loadFactoryPreset(index);
+        return;
     }
 
-    // 6. Cathedral - Massive, ethereal space
+    // Then check user presets
+    juce::StringArray ids;
+    std::vector<float> values;
+
+    if (findUserPreset(presetName, ids, values))
     {
-        FactoryPreset preset;
-        preset.name = "Cathedral";
-        preset.category = "Large Spaces";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 3);      // Cathedral
-        xml->setAttribute(ParamIDs::size, 90.0f);
-        xml->setAttribute(ParamIDs::decay, 4.5f);
-        xml->setAttribute(ParamIDs::damping, 40.0f);
-        xml->setAttribute(ParamIDs::preDelay, 50.0f);
-        xml->setAttribute(ParamIDs::width, 100.0f);
-        xml->setAttribute(ParamIDs::mix, 45.0f);
-        xml->setAttribute(ParamIDs::erLevel, 35.0f);
-        xml->setAttribute(ParamIDs::erSize, 85.0f);
-        xml->setAttribute(ParamIDs::highCut, 10000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 50.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
+        notifyPresetLoadStarted();
+        applyParameterValues(ids, values);
+        notifyPresetLoadFinished();
+
+        currentPresetName = presetName;
+        currentPresetIndex = -1; // User preset
+        presetModified = false;
     }
+}
 
-    // 7. Ambient Pad - Long, lush tail for pads
+bool PresetManager::deletePreset(const juce::String& presetName)
+{
+    const juce::ScopedLock lock(bankLock);
+    auto presets = getUserBankPresets();
+    auto removed = std::remove_if(presets.begin(), presets.end(),
+                                  [&presetName](const PresetBank::Preset& p) { return p.name == presetName; });
+
+    if (removed != presets.end())
     {
-        FactoryPreset preset;
-        preset.name = "Ambient Pad";
-        preset.category = "Creative";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 3);      // Cathedral
-        xml->setAttribute(ParamIDs::size, 100.0f);
-        xml->setAttribute(ParamIDs::decay, 7.0f);
-        xml->setAttribute(ParamIDs::damping, 65.0f);
-        xml->setAttribute(ParamIDs::preDelay, 80.0f);
-        xml->setAttribute(ParamIDs::width, 100.0f);
-        xml->setAttribute(ParamIDs::mix, 60.0f);
-        xml->setAttribute(ParamIDs::erLevel, 20.0f);
-        xml->setAttribute(ParamIDs::erSize, 90.0f);
-        xml->setAttribute(ParamIDs::highCut, 8000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 100.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
+        presets.erase(removed, presets.end());
+
+        if (!writeUserBank(std::move(presets)))
+            return false;
     }
 
-    // 8. Drum Room - Punchy room for drums
+    // Also remove a pre-bank XML copy so it doesn't come back on re-import
+    auto presetFile = getUserPresetsDirectory().getChildFile(presetName + ".xml");
+
+    if (presetFile.existsAsFile())
     {
-        FactoryPreset preset;
-        preset.name = "Drum Room";
-        preset.category = "Drums";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 1);      // Room
-        xml->setAttribute(ParamIDs::size, 55.0f);
-        xml->setAttribute(ParamIDs::decay, 0.8f);
-        xml->setAttribute(ParamIDs::damping, 50.0f);
-        xml->setAttribute(ParamIDs::preDelay, 0.0f);
-        xml->setAttribute(ParamIDs::width, 90.0f);
-        xml->setAttribute(ParamIDs::mix, 25.0f);
-        xml->setAttribute(ParamIDs::erLevel, 80.0f);
-        xml->setAttribute(ParamIDs::erSize, 45.0f);
-        xml->setAttribute(ParamIDs::highCut, 12000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 120.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
+        return presetFile.deleteFile();
     }
 
-    // 9. Snare Plate - Bright, short plate-like
+    return true;
+}
+
+bool PresetManager::exportPreset(const juce::String& presetName, const juce::File& xmlFile) const
+{
+    // Factory presets only become XML here, with every value loading them
+    // sets: getPresetValues() starts from the same defaults as the load
+    if (auto index = FactoryPresets::indexOf(presetName); index >= 0)
     {
-        FactoryPreset preset;
-        preset.name = "Snare Plate";
-        preset.category = "Drums";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 0);      // Booth
-        xml->setAttribute(ParamIDs::size, 40.0f);
-        xml->setAttribute(ParamIDs::decay, 1.5f);
-        xml->setAttribute(ParamIDs::damping, 25.0f);
-        xml->setAttribute(ParamIDs::preDelay, 0.0f);
-        xml->setAttribute(ParamIDs::width, 70.0f);
-        xml->setAttribute(ParamIDs::mix, 30.0f);
-        xml->setAttribute(ParamIDs::erLevel, 30.0f);
-        xml->setAttribute(ParamIDs::erSize, 30.0f);
-        xml->setAttribute(ParamIDs::highCut, 16000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 200.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
+        juce::NamedValueSet values;
+        getPresetValues(presetName, values);
+
+        PresetBank::Preset preset { presetName, FactoryPresets::presets[index].category, {} };
+        for (const auto& id : getParameterIds())
+            preset.values.push_back(static_cast<float>(values[id]));
+
+        return presetToXml(preset)->writeTo(xmlFile);
     }
 
-    // 10. Dark Chamber - Moody, dark reverb
+    // Export in the current parameter order so the XML is complete
+    const juce::ScopedLock lock(bankLock);
+    for (const auto& preset : getUserBankPresets())
     {
-        FactoryPreset preset;
-        preset.name = "Dark Chamber";
-        preset.category = "Creative";
-        auto xml = std::make_unique<juce::XmlElement>("Preset");
-        xml->setAttribute("name", preset.name);
-        xml->setAttribute(ParamIDs::roomType, 2);      // Hall
-        xml->setAttribute(ParamIDs::size, 70.0f);
-        xml->setAttribute(ParamIDs::decay, 3.0f);
-        xml->setAttribute(ParamIDs::damping, 80.0f);
-        xml->setAttribute(ParamIDs::preDelay, 40.0f);
-        xml->setAttribute(ParamIDs::width, 100.0f);
-        xml->setAttribute(ParamIDs::mix, 35.0f);
-        xml->setAttribute(ParamIDs::erLevel, 40.0f);
-        xml->setAttribute(ParamIDs::erSize, 60.0f);
-        xml->setAttribute(ParamIDs::highCut, 4000.0f);
-        xml->setAttribute(ParamIDs::lowCut, 80.0f);
-        preset.state = std::move(xml);
-        factoryPresets.push_back(std::move(preset));
+        if (preset.name == presetName)
+            return presetToXml(preset)->writeTo(xmlFile);
     }
+
+    return false;
 }
 
-void PresetManager::savePreset(const juce::String& presetName)
+bool PresetManager::importPreset(const juce::File& xmlFile)
 {
-    auto presetFile = getUserPresetsDirectory().getChildFile(presetName + ".xml");
+    return importPresets({ xmlFile }) > 0;
+}
+
+int PresetManager::importPresets(const juce::Array<juce::File>& xmlFiles)
+{
+    AURA_TRACE_SCOPE("PresetManager::importPresets");
 
-    auto state = valueTreeState.copyState();
-    auto xml = state.createXml();
+    const juce::ScopedLock lock(bankLock);
+    auto presets = getUserBankPresets();
+    int numImported = readXmlPresets(xmlFiles, presets);
 
-    if (xml)
-    {
-        xml->setAttribute("presetName", presetName);
-        xml->writeTo(presetFile);
-    }
+    // One bank rewrite for the whole batch, however many files came in
+    if (numImported > 0 && !writeUserBank(std::move(presets)))
+        return 0;
 
-    currentPresetName = presetName;
-    presetModified = false;
+    return numImported;
 }
 
-void PresetManager::loadPreset(const juce::String& presetName)
+bool PresetManager::getPresetValues(const juce::String& presetName, juce::NamedValueSet& values) const
 {
-    // First check factory presets
-    for (size_t i = 0; i < factoryPresets.size(); ++i)
+    const auto& ids = getParameterIds();
+    values.clear();
+
+    // Factory presets start from the defaults initializeDefaultPreset sets
+    if (auto index = FactoryPresets::indexOf(presetName); index >= 0)
     {
-        if (factoryPresets[i].name == presetName)
+        for (const auto& id : ids)
         {
-            loadFactoryPreset(static_cast<int>(i));
-            return;
+            auto* param = valueTreeState.getParameter(id);
+            values.set(id, param->convertFrom0to1(param->getDefaultValue()));
         }
-    }
 
-    // Then check user presets
-    auto presetFile = getUserPresetsDirectory().getChildFile(presetName + ".xml");
-
-    if (presetFile.existsAsFile())
-    {
-        auto xml = juce::XmlDocument::parse(presetFile);
-        if (xml)
+        FactoryPresets::presets[index].forEachValue([&values](const juce::String& id, float value)
         {
-            valueTreeState.replaceState(juce::ValueTree::fromXml(*xml));
-            currentPresetName = presetName;
-            currentPresetIndex = -1; // User preset
-            presetModified = false;
-        }
+            values.set(id, value);
+        });
+
+        return true;
     }
-}
 
-void PresetManager::deletePreset(const juce::String& presetName)
-{
-    auto presetFile = getUserPresetsDirectory().getChildFile(presetName + ".xml");
+    // User presets only store some values; the rest keep their current setting
+    for (const auto& id : ids)
+        values.set(id, valueTreeState.getRawParameterValue(id)->load());
 
-    if (presetFile.existsAsFile())
+    juce::StringArray storedIds;
+    std::vector<float> stored;
+
+    if (!findUserPreset(presetName, storedIds, stored))
+        return false;
+
+    for (int i = 0; i < storedIds.size() && i < static_cast<int>(stored.size()); ++i)
     {
-        presetFile.deleteFile();
+        auto value = stored[static_cast<size_t>(i)];
+        if (!std::isnan(value) && ids.contains(storedIds[i]))
+            values.set(storedIds[i], value);
     }
+
+    return true;
 }
 
 void PresetManager::loadFactoryPreset(int index)
 {
-    if (index < 0 || index >= static_cast<int>(factoryPresets.size()))
+    AURA_TRACE_SCOPE("PresetManager::loadFactoryPreset");
+
+    if (index < 0 || index >= FactoryPresets::numPresets)
     {
         return;
     }
 
-    const auto& preset = factoryPresets[static_cast<size_t>(index)];
+    const auto& preset = FactoryPresets::presets[index];
 
-    if (index == 0)
-    {
-        // Init preset - reset to defaults
-        initializeDefaultPreset();
-    }
-    else if (preset.state)
-    {
-        // Apply preset-specific settings
-        initializeDefaultPreset();
+    notifyPresetLoadStarted();
 
-        // Apply the preset settings
-        auto setParam = [this](const juce::String& paramId, float value) {
-            if (auto* param = valueTreeState.getParameter(paramId))
-            {
-                param->setValueNotifyingHost(param->convertTo0to1(value));
-            }
-        };
-
-        if (preset.state->hasAttribute(ParamIDs::roomType))
-            setParam(ParamIDs::roomType, static_cast<float>(preset.state->getIntAttribute(ParamIDs::roomType)));
-        if (preset.state->hasAttribute(ParamIDs::size))
-            setParam(ParamIDs::size, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::size)));
-        if (preset.state->hasAttribute(ParamIDs::decay))
-            setParam(ParamIDs::decay, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::decay)));
-        if (preset.state->hasAttribute(ParamIDs::damping))
-            setParam(ParamIDs::damping, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::damping)));
-        if (preset.state->hasAttribute(ParamIDs::preDelay))
-            setParam(ParamIDs::preDelay, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::preDelay)));
-        if (preset.state->hasAttribute(ParamIDs::width))
-            setParam(ParamIDs::width, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::width)));
-        if (preset.state->hasAttribute(ParamIDs::mix))
-            setParam(ParamIDs::mix, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::mix)));
-        if (preset.state->hasAttribute(ParamIDs::erLevel))
-            setParam(ParamIDs::erLevel, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::erLevel)));
-        if (preset.state->hasAttribute(ParamIDs::erSize))
-            setParam(ParamIDs::erSize, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::erSize)));
-        if (preset.state->hasAttribute(ParamIDs::highCut))
-            setParam(ParamIDs::highCut, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::highCut)));
-        if (preset.state->hasAttribute(ParamIDs::lowCut))
-            setParam(ParamIDs::lowCut, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::lowCut)));
-        if (preset.state->hasAttribute(ParamIDs::inputGain))
-            setParam(ParamIDs::inputGain, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::inputGain)));
-        if (preset.state->hasAttribute(ParamIDs::outputGain))
-            setParam(ParamIDs::outputGain, static_cast<float>(preset.state->getDoubleAttribute(ParamIDs::outputGain)));
-    }
+    // Every preset starts from the defaults; Init is nothing but them
+    initializeDefaultPreset();
+
+    preset.forEachValue([this](const juce::String& paramId, float value) {
+        if (auto* param = valueTreeState.getParameter(paramId))
+        {
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+        }
+    });
+
+    notifyPresetLoadFinished();
 
     currentPresetName = preset.name;
     currentPresetIndex = index;
     presetModified = false;
 }
 
-void PresetManager::initializeDefaultPreset()
+void PresetManager::notifyPresetLoadStarted()
 {
-    auto setParam = [this](const juce::String& paramId, float value) {
-        if (auto* param = valueTreeState.getParameter(paramId))
-        {
-            param->setValueNotifyingHost(param->convertTo0to1(value));
-        }
-    };
+    if (onPresetLoadStarted)
+        onPresetLoadStarted();
+}
 
-    // Reset all parameters to their default values
-    setParam(ParamIDs::roomType, static_cast<float>(Defaults::roomType));
-    setParam(ParamIDs::size, Defaults::size);
-    setParam(ParamIDs::decay, Defaults::decay);
-    setParam(ParamIDs::damping, Defaults::damping);
-    setParam(ParamIDs::preDelay, Defaults::preDelay);
-    setParam(ParamIDs::width, Defaults::width);
-    setParam(ParamIDs::mix, Defaults::mix);
-    setParam(ParamIDs::erLevel, Defaults::erLevel);
-    setParam(ParamIDs::erSize, Defaults::erSize);
-    setParam(ParamIDs::highCut, Defaults::highCut);
-    setParam(ParamIDs::lowCut, Defaults::lowCut);
-    setParam(ParamIDs::inputGain, Defaults::inputGain);
-    setParam(ParamIDs::outputGain, Defaults::outputGain);
+void PresetManager::notifyPresetLoadFinished()
+{
+    if (onPresetLoadFinished)
+        onPresetLoadFinished();
+}
+
+void PresetManager::initializeDefaultPreset()
+{
+    // Every parameter a preset carries, so a preset loaded on top of any
+    // state sounds the same, and the same as getPresetValues() reports
+    for (const auto& id : getParameterIds())
+    {
+        if (auto* param = valueTreeState.getParameter(id))
+            param->setValueNotifyingHost(param->getDefaultValue());
+    }
 
     currentPresetName = "Init";
     currentPresetIndex = 0;
@@ -381,7 +272,7 @@ void PresetManager::initializeDefaultPreset()
 juce::StringArray PresetManager::getFactoryPresetNames() const
 {
     juce::StringArray names;
-    for (const auto& preset : factoryPresets)
+    for (const auto& preset : FactoryPresets::presets)
     {
         names.add(preset.name);
     }
@@ -390,26 +281,21 @@ juce::StringArray PresetManager::getFactoryPresetNames() const
 
 int PresetManager::getNumFactoryPresets() const
 {
-    return static_cast<int>(factoryPresets.size());
+    return FactoryPresets::numPresets;
 }
 
 juce::StringArray PresetManager::getUserPresetNames() const
 {
     juce::StringArray names;
-    auto presetDir = getUserPresetsDirectory();
-
-    for (const auto& file : presetDir.findChildFiles(juce::File::findFiles, false, "*.xml"))
-    {
-        names.add(file.getFileNameWithoutExtension());
-    }
+    for (const auto& entry : getPresetIndexer().getSnapshot().entries)
+        names.add(entry.name);
 
-    names.sort(true);
     return names;
 }
 
 int PresetManager::getNumUserPresets() const
 {
-    return getUserPresetNames().size();
+    return static_cast<int>(getPresetIndexer().getSnapshot().entries.size());
 }
 
 juce::StringArray PresetManager::getAllPresetNames() const
@@ -430,4 +316,237 @@ juce::StringArray PresetManager::getAllPresetNames() const
     return names;
 }
 
+//==============================================================================
+bool PresetManager::findUserPreset(const juce::String& presetName, juce::StringArray& ids,
+                                   std::vector<float>& values) const
+{
+    // The indexer's catalogue answers without touching the disk. It can only
+    // be read on the message thread, and a preset written a moment ago may not
+    // be in it yet, so anything it can't answer comes from the files.
+    if (juce::MessageManager::existsAndIsCurrentThread())
+    {
+        for (const auto& entry : getPresetIndexer().getSnapshot().entries)
+        {
+            if (entry.name == presetName)
+            {
+                ids = entry.parameterIds;
+                values = entry.values;
+                return true;
+            }
+        }
+    }
+
+    AURA_TRACE_SCOPE("PresetManager::findUserPreset");
+
+    PresetBank bank;
+    PresetBank::Preset preset;
+
+    if (bank.open(getUserBankFile()) && bank.getPreset(bank.indexOf(presetName), preset))
+    {
+        ids = bank.getParameterIds();
+        values = std::move(preset.values);
+        return true;
+    }
+
+    // Loose XML files dropped into the presets folder load without an import
+    if (auto xml = juce::XmlDocument::parse(getUserPresetsDirectory().getChildFile(presetName + ".xml")))
+    {
+        if (presetFromXml(*xml, presetName, preset))
+        {
+            ids = getParameterIds();
+            values = std::move(preset.values);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PresetManager::buildInitialBank() const
+{
+    // Indexer thread. First run with a bank: fold the old one-file-per-preset
+    // XML library into it. A save that gets in first does the same under the lock.
+    const juce::ScopedLock lock(bankLock);
+
+    auto bankFile = getUserBankFile();
+    if (bankFile.existsAsFile())
+        return;
+
+    AURA_TRACE_SCOPE("PresetManager::buildInitialBank");
+
+    auto presets = readXmlLibrary();
+    if (!presets.empty())
+        PresetBank::write(bankFile, getParameterIds(), std::move(presets));
+}
+
+int PresetManager::readXmlPresets(const juce::Array<juce::File>& xmlFiles,
+                                  std::vector<PresetBank::Preset>& presets) const
+{
+    int numRead = 0;
+
+    for (const auto& file : xmlFiles)
+    {
+        PresetBank::Preset preset;
+        auto xml = juce::XmlDocument::parse(file);
+
+        if (xml != nullptr && presetFromXml(*xml, file.getFileNameWithoutExtension(), preset))
+        {
+            presets.push_back(std::move(preset));
+            ++numRead;
+        }
+    }
+
+    return numRead;
+}
+
+std::vector<PresetBank::Preset> PresetManager::readXmlLibrary() const
+{
+    std::vector<PresetBank::Preset> presets;
+    readXmlPresets(getUserPresetsDirectory().findChildFiles(juce::File::findFiles, false, "*.xml"), presets);
+    return presets;
+}
+
+bool PresetManager::writeUserBank(std::vector<PresetBank::Preset> presets) const
+{
+    AURA_TRACE_SCOPE("PresetManager::writeUserBank");
+
+    auto bankFile = getUserBankFile();
+    bankFile.getParentDirectory().createDirectory();
+    bool written = PresetBank::write(bankFile, getParameterIds(), std::move(presets));
+
+    if (presetIndexer != nullptr)
+        presetIndexer->requestRescan();
+
+    return written;
+}
+
+std::vector<PresetBank::Preset> PresetManager::getUserBankPresets() const
+{
+    // Callers hold bankLock and write the list back, so it is read from the
+    // file: it must include whatever another instance saved a moment ago
+    auto bankFile = getUserBankFile();
+    if (!bankFile.existsAsFile())
+        return readXmlLibrary();
+
+    PresetBank bank;
+    bank.open(bankFile);
+
+    // Remap stored values onto the current parameter list, which may have grown
+    const auto& ids = getParameterIds();
+    const auto& storedIds = bank.getParameterIds();
+
+    std::vector<int> sourceIndex;
+    for (const auto& id : ids)
+        sourceIndex.push_back(storedIds.indexOf(id));
+
+    auto presets = bank.getAllPresets();
+    for (auto& preset : presets)
+    {
+        std::vector<float> values(static_cast<size_t>(ids.size()), std::numeric_limits<float>::quiet_NaN());
+
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (sourceIndex[i] >= 0)
+                values[i] = preset.values[static_cast<size_t>(sourceIndex[i])];
+        }
+
+        preset.values = std::move(values);
+    }
+
+    return presets;
+}
+
+juce::StringArray PresetManager::collectParameterIds(const juce::AudioProcessorValueTreeState& apvts)
+{
+    juce::StringArray ids;
+
+    // Host controls and per-session settings: none of them is
+    // part of a sound, so loading a preset must leave them alone
+    static const juce::StringArray excluded {
+        ParamIDs::bypass, ParamIDs::sendMode, ParamIDs::quality,
+        ParamIDs::adaptiveQuality, ParamIDs::equalPowerMix, ParamIDs::morph
+    };
+
+    for (auto* param : apvts.processor.getParameters())
+    {
+        if (auto* withId = dynamic_cast<juce::AudioProcessorParameterWithID*>(param);
+            withId != nullptr && !excluded.contains(withId->paramID))
+            ids.add(withId->paramID);
+    }
+
+    return ids;
+}
+
+PresetBank::Preset PresetManager::captureCurrentState(const juce::String& presetName) const
+{
+    PresetBank::Preset preset;
+    preset.name = presetName;
+    preset.category = "User";
+
+    for (const auto& id : getParameterIds())
+        preset.values.push_back(valueTreeState.getRawParameterValue(id)->load());
+
+    return preset;
+}
+
+bool PresetManager::presetFromXml(const juce::XmlElement& xml, const juce::String& fallbackName,
+                                  PresetBank::Preset& result) const
+{
+    if (!xml.hasTagName(stateType))
+        return false;
+
+    const auto& ids = getParameterIds();
+
+    result.name = xml.getStringAttribute("presetName", fallbackName);
+    result.category = xml.getStringAttribute("category", "User");
+    result.values.assign(static_cast<size_t>(ids.size()), std::numeric_limits<float>::quiet_NaN());
+
+    for (auto* param : xml.getChildWithTagNameIterator("PARAM"))
+    {
+        auto index = ids.indexOf(param->getStringAttribute("id"));
+        if (index >= 0 && param->hasAttribute("value"))
+            result.values[static_cast<size_t>(index)] = static_cast<float>(param->getDoubleAttribute("value"));
+    }
+
+    return true;
+}
+
+std::unique_ptr<juce::XmlElement> PresetManager::presetToXml(const PresetBank::Preset& preset) const
+{
+    // Same shape as the APVTS state XML, so older builds can still load it
+    auto xml = std::make_unique<juce::XmlElement>(stateType);
+    xml->setAttribute("presetName", preset.name);
+    xml->setAttribute("category", preset.category);
+
+    const auto ids = getParameterIds();
+    for (int i = 0; i < ids.size() && i < static_cast<int>(preset.values.size()); ++i)
+    {
+        auto value = preset.values[static_cast<size_t>(i)];
+        if (std::isnan(value))
+            continue;
+
+        auto* param = xml->createNewChildElement("PARAM");
+        param->setAttribute("id", ids[i]);
+        param->setAttribute("value", value);
+    }
+
+    return xml;
+}
+
+void PresetManager::applyParameterValues(const juce::StringArray& ids, const std::vector<float>& values)
+{
+    // Banks written by older builds also stored the settings now left out
+    const auto soundIds = getParameterIds();
+
+    for (int i = 0; i < ids.size() && i < static_cast<int>(values.size()); ++i)
+    {
+        auto value = values[static_cast<size_t>(i)];
+        if (std::isnan(value) || !soundIds.contains(ids[i]))
+            continue;
+
+        if (auto* param = valueTreeState.getParameter(ids[i]))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+}
+
 } // namespace Aura
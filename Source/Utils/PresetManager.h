@@ -1,5 +1,7 @@
 #pragma once
 
+#include "PresetBank.h"
+#include "PresetIndexer.h"
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_data_structures/juce_data_structures.h>
 
@@ -9,23 +11,37 @@ namespace Aura
 class PresetManager
 {
 public:
-    PresetManager(juce::AudioProcessorValueTreeState& apvts);
-    ~PresetManager() = default;
-
-    // Preset operations
-    void savePreset(const juce::String& presetName);
+    // User presets live in the documents folder unless a directory is given
+    explicit PresetManager(juce::AudioProcessorValueTreeState& apvts, const juce::File& presetsDirectory = {});
+    ~PresetManager();
+
+    // Preset operations. Saving and deleting rewrite the user bank and
+    // return false if it couldn't be replaced, e.g. while another process
+    // holds it open on Windows.
+    bool savePreset(const juce::String& presetName);
     void loadPreset(const juce::String& presetName);
-    void deletePreset(const juce::String& presetName);
+    bool deletePreset(const juce::String& presetName);
 
     // Factory presets
     void loadFactoryPreset(int index);
     juce::StringArray getFactoryPresetNames() const;
     int getNumFactoryPresets() const;
 
-    // User presets
+    // User presets, as the indexer last catalogued them (message thread). The
+    // list is empty until its first scan, and trails a write by a moment.
     juce::StringArray getUserPresetNames() const;
     int getNumUserPresets() const;
 
+    // XML interchange (the format used before the preset bank). Factory
+    // presets can be exported too.
+    bool exportPreset(const juce::String& presetName, const juce::File& xmlFile) const;
+    bool importPreset(const juce::File& xmlFile);
+    int importPresets(const juce::Array<juce::File>& xmlFiles);  // 0 if the bank couldn't be written
+
+    // Parameter values a preset would leave behind if loaded now, keyed by ID.
+    // Returns false if no factory or user preset has that name.
+    bool getPresetValues(const juce::String& presetName, juce::NamedValueSet& values) const;
+
     // All presets combined
     juce::StringArray getAllPresetNames() const;
     int getCurrentPresetIndex() const { return currentPresetIndex; }
@@ -40,21 +56,52 @@ public:
 
     // Get preset directory
     juce::File getUserPresetsDirectory() const;
+    juce::File getUserBankFile() const;
+
+    // Background catalogue of the user presets directory, started on first use.
+    // Its thread also builds the bank from a pre-bank XML library.
+    PresetIndexer& getPresetIndexer() const;
+
+    // Called on the message thread before and after a preset is applied,
+    // so the processor can prepare a spare engine and crossfade to it
+    std::function<void()> onPresetLoadStarted;
+    std::function<void()> onPresetLoadFinished;
 
 private:
-    void createFactoryPresets();
     void loadPresetFromXml(const juce::XmlElement& xml);
 
+    void notifyPresetLoadStarted();
+    void notifyPresetLoadFinished();
+
+    // User preset bank
+    bool findUserPreset(const juce::String& presetName, juce::StringArray& ids, std::vector<float>& values) const;
+    void buildInitialBank() const;
+    bool writeUserBank(std::vector<PresetBank::Preset> presets) const;
+    int readXmlPresets(const juce::Array<juce::File>& xmlFiles,
+                       std::vector<PresetBank::Preset>& presets) const;
+    std::vector<PresetBank::Preset> readXmlLibrary() const;
+    std::vector<PresetBank::Preset> getUserBankPresets() const;
+    const juce::StringArray& getParameterIds() const { return parameterIds; }
+    static juce::StringArray collectParameterIds(const juce::AudioProcessorValueTreeState& apvts);
+    PresetBank::Preset captureCurrentState(const juce::String& presetName) const;
+    bool presetFromXml(const juce::XmlElement& xml, const juce::String& fallbackName,
+                       PresetBank::Preset& result) const;
+    std::unique_ptr<juce::XmlElement> presetToXml(const PresetBank::Preset& preset) const;
+    void applyParameterValues(const juce::StringArray& ids, const std::vector<float>& values);
+
     juce::AudioProcessorValueTreeState& valueTreeState;
+    const juce::File userPresetsDirectory;
+
+    // Fixed once the processor is built; kept here so the indexer thread can
+    // read XML presets without touching the APVTS
+    const juce::StringArray parameterIds;
+    const juce::Identifier stateType;
+
+    // User presets live in one bank file. Every read-modify-write of it, and
+    // the indexer thread's initial build, holds this lock.
+    mutable juce::CriticalSection bankLock;
 
-    // Factory presets stored in memory
-    struct FactoryPreset
-    {
-        juce::String name;
-        juce::String category;
-        std::unique_ptr<juce::XmlElement> state;
-    };
-    std::vector<FactoryPreset> factoryPresets;
+    mutable std::unique_ptr<PresetIndexer> presetIndexer;
 
     juce::String currentPresetName = "Init";
     int currentPresetIndex = 0;
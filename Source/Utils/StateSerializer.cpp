@@ -0,0 +1,139 @@
+#include "StateSerializer.h"
+#include "Parameters.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace Aura
+{
+
+namespace
+{
+    constexpr size_t headerSize = sizeof(juce::uint32) + 2 * sizeof(juce::uint16);
+
+    template <typename IntType>
+    void writeLittleEndian(char*& dest, IntType value)
+    {
+        value = juce::ByteOrder::swapIfBigEndian(value);
+        std::memcpy(dest, &value, sizeof(IntType));
+        dest += sizeof(IntType);
+    }
+
+    template <typename IntType>
+    IntType readLittleEndian(const char* source)
+    {
+        IntType value;
+        std::memcpy(&value, source, sizeof(IntType));
+        return juce::ByteOrder::swapIfBigEndian(value);
+    }
+}
+
+StateSerializer::StateSerializer(juce::AudioProcessorValueTreeState& apvts)
+    : valueTreeState(apvts)
+{
+    for (const auto& id : ParamIDs::stateOrder)
+    {
+        parameters.push_back(valueTreeState.getParameter(id));
+        rawValues.push_back(valueTreeState.getRawParameterValue(id));
+    }
+}
+
+bool StateSerializer::isBinaryState(const void* data, int sizeInBytes)
+{
+    return data != nullptr
+        && sizeInBytes >= static_cast<int>(headerSize)
+        && readLittleEndian<juce::uint32>(static_cast<const char*>(data)) == magic;
+}
+
+void StateSerializer::save(juce::MemoryBlock& destData) const
+{
+    // Non-parameter properties are rare; only then is a ValueTree written
+    juce::MemoryBlock extra;
+    if (valueTreeState.state.getNumProperties() > 0)
+    {
+        juce::ValueTree properties(valueTreeState.state.getType());
+        properties.copyPropertiesFrom(valueTreeState.state, nullptr);
+
+        juce::MemoryOutputStream stream(extra, false);
+        properties.writeToStream(stream);
+    }
+
+    const auto numValues = static_cast<juce::uint16>(rawValues.size());
+    destData.setSize(headerSize + numValues * sizeof(float) + sizeof(juce::uint32) + extra.getSize());
+
+    auto* dest = static_cast<char*>(destData.getData());
+    writeLittleEndian(dest, magic);
+    writeLittleEndian(dest, currentVersion);
+    writeLittleEndian(dest, numValues);
+
+    for (auto* raw : rawValues)
+    {
+        float value = raw != nullptr ? raw->load() : std::numeric_limits<float>::quiet_NaN();
+
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(float));
+        writeLittleEndian(dest, bits);
+    }
+
+    writeLittleEndian(dest, static_cast<juce::uint32>(extra.getSize()));
+    if (extra.getSize() > 0)
+        std::memcpy(dest, extra.getData(), extra.getSize());
+}
+
+bool StateSerializer::load(const void* data, int sizeInBytes)
+{
+    if (isBinaryState(data, sizeInBytes))
+        return loadBinary(static_cast<const char*>(data), static_cast<size_t>(sizeInBytes));
+
+    return loadXml(data, sizeInBytes);
+}
+
+bool StateSerializer::loadBinary(const char* data, size_t sizeInBytes)
+{
+    const auto numValues = static_cast<size_t>(readLittleEndian<juce::uint16>(data + 6));
+    const auto valuesEnd = headerSize + numValues * sizeof(float);
+
+    if (valuesEnd > sizeInBytes)
+        return false;
+
+    // Newer builds only ever append IDs, so the known prefix is always valid
+    for (size_t i = 0; i < numValues && i < parameters.size(); ++i)
+    {
+        auto bits = readLittleEndian<juce::uint32>(data + headerSize + i * sizeof(float));
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(float));
+
+        if (auto* param = parameters[i]; param != nullptr && std::isfinite(value))
+            param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    // The loaded properties replace the current ones, so a property the state
+    // doesn't have (a morph preset, say) doesn't linger from the last session
+    juce::ValueTree properties(valueTreeState.state.getType());
+
+    if (valuesEnd + sizeof(juce::uint32) <= sizeInBytes)
+    {
+        const auto extraSize = static_cast<size_t>(readLittleEndian<juce::uint32>(data + valuesEnd));
+        const auto extraStart = valuesEnd + sizeof(juce::uint32);
+
+        if (extraSize > 0 && extraStart + extraSize <= sizeInBytes)
+            if (auto loaded = juce::ValueTree::readFromData(data + extraStart, extraSize); loaded.isValid())
+                properties = loaded;
+    }
+
+    valueTreeState.state.copyPropertiesFrom(properties, nullptr);
+    return true;
+}
+
+bool StateSerializer::loadXml(const void* data, int sizeInBytes)
+{
+    std::unique_ptr<juce::XmlElement> xml(juce::AudioProcessor::getXmlFromBinary(data, sizeInBytes));
+    if (xml == nullptr || !xml->hasTagName(valueTreeState.state.getType()))
+        return false;
+
+    valueTreeState.replaceState(juce::ValueTree::fromXml(*xml));
+    return true;
+}
+
+} // namespace Aura
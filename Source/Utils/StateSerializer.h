@@ -0,0 +1,54 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <vector>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * State Serializer
+ *
+ * Compact binary plugin state used by get/setStateInformation:
+ *
+ *   uint32  magic "AUST"
+ *   uint16  version
+ *   uint16  number of values
+ *   float   values in ParamIDs::stateOrder, denormalised
+ *   uint32  size of the extra block (0 when empty)
+ *   bytes   non-parameter APVTS properties as a binary ValueTree
+ *
+ * About 90 bytes against well over a kilobyte of XML, and no DOM is built.
+ * States that don't start with the magic are handed to the XML reader, so
+ * sessions saved by older builds still load.
+ */
+class StateSerializer
+{
+public:
+    static constexpr juce::uint32 magic = 0x54535541;   // "AUST"
+    static constexpr juce::uint16 currentVersion = 1;
+
+    explicit StateSerializer(juce::AudioProcessorValueTreeState& apvts);
+
+    void save(juce::MemoryBlock& destData) const;
+
+    // Returns false if the data is neither a binary nor an XML state
+    bool load(const void* data, int sizeInBytes);
+
+    static bool isBinaryState(const void* data, int sizeInBytes);
+
+private:
+    bool loadBinary(const char* data, size_t sizeInBytes);
+    bool loadXml(const void* data, int sizeInBytes);
+
+    juce::AudioProcessorValueTreeState& valueTreeState;
+
+    // Resolved once, indexed like ParamIDs::stateOrder
+    std::vector<juce::RangedAudioParameter*> parameters;
+    std::vector<std::atomic<float>*> rawValues;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(StateSerializer)
+};
+
+} // namespace Aura
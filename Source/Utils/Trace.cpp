@@ -0,0 +1,267 @@
+#include "Trace.h"
+#include <array>
+#include <chrono>
+#include <memory>
+
+namespace Aura
+{
+
+std::atomic<bool> Trace::running { false };
+std::atomic<int> Trace::dropped { 0 };
+
+namespace
+{
+    struct Event
+    {
+        const char* name = nullptr;
+        int64_t startNanos = 0;
+        int64_t endNanos = 0;
+    };
+
+    // One producer, the thread that owns it, and one consumer, the writer
+    struct ThreadRing
+    {
+        std::array<Event, Trace::eventsPerThread> events;
+        std::atomic<uint64_t> writePos { 0 };
+        std::atomic<uint64_t> readPos { 0 };
+        std::atomic<const char*> name { nullptr };
+        std::atomic<bool> isMessageThread { false };
+        std::atomic<bool> claimed { false };    // owned by a live thread
+        const char* writtenName = nullptr;      // writer thread only
+    };
+
+    // Allocated by the first session and kept for the life of the process,
+    // so a thread still recording as a session stops never writes into freed memory
+    std::unique_ptr<std::array<ThreadRing, Trace::maxThreads>> rings;
+
+    // A thread's claim on a ring, handed back when the thread exits. Hosts
+    // start and stop render threads all the time; without this, the first
+    // maxThreads of them would use up every ring for the life of the process.
+    // Events the thread left in the ring are still written, under the same tid
+    // as the next thread to claim it.
+    class RingOwner
+    {
+    public:
+        ~RingOwner()
+        {
+            if (ring == nullptr)
+                return;
+
+            ring->name.store(nullptr, std::memory_order_relaxed);
+            ring->isMessageThread.store(false, std::memory_order_relaxed);
+            ring->claimed.store(false, std::memory_order_release);
+        }
+
+        ThreadRing* get()
+        {
+            if (ring == nullptr)
+                ring = claim();
+
+            return ring;
+        }
+
+    private:
+        // nullptr while every ring is taken; the next call tries again
+        static ThreadRing* claim()
+        {
+            for (auto& candidate : *rings)
+            {
+                bool expected = false;
+                if (!candidate.claimed.load(std::memory_order_relaxed)
+                    && candidate.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                {
+                    candidate.isMessageThread.store(juce::MessageManager::existsAndIsCurrentThread(),
+                                                    std::memory_order_release);
+                    return &candidate;
+                }
+            }
+
+            return nullptr;
+        }
+
+        ThreadRing* ring = nullptr;
+    };
+
+    ThreadRing* getThreadRing()
+    {
+        thread_local RingOwner owner;
+        return owner.get();
+    }
+
+    //==========================================================================
+    class Writer : public juce::Thread
+    {
+    public:
+        Writer(std::unique_ptr<juce::FileOutputStream> output, int64_t origin)
+            : juce::Thread("Aura Trace Writer"), stream(std::move(output)), originNanos(origin)
+        {
+            *stream << "[";
+        }
+
+        void finish()
+        {
+            stopThread(2000);
+            drain();
+            *stream << "\n]\n";
+            stream->flush();
+        }
+
+    private:
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                wait(Trace::flushIntervalMs);
+                drain();
+            }
+        }
+
+        void drain()
+        {
+            for (int i = 0; i < Trace::maxThreads; ++i)
+            {
+                auto& ring = (*rings)[static_cast<size_t>(i)];
+                const int tid = i + 1;
+
+                const char* name = ring.name.load(std::memory_order_acquire);
+                if (name == nullptr && ring.isMessageThread.load(std::memory_order_acquire))
+                    name = "Message";
+
+                if (name != nullptr && name != ring.writtenName)
+                {
+                    write("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + juce::String(tid)
+                          + ",\"args\":{\"name\":\"" + juce::String(name) + "\"}}");
+                    ring.writtenName = name;
+                }
+
+                const auto end = ring.writePos.load(std::memory_order_acquire);
+
+                for (auto pos = ring.readPos.load(std::memory_order_relaxed); pos < end; ++pos)
+                {
+                    const auto& event = ring.events[static_cast<size_t>(pos % Trace::eventsPerThread)];
+
+                    write("{\"name\":\"" + juce::String(event.name) + "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                          + juce::String(tid)
+                          + ",\"ts\":" + juce::String(static_cast<double>(event.startNanos - originNanos) / 1000.0, 3)
+                          + ",\"dur\":" + juce::String(static_cast<double>(event.endNanos - event.startNanos) / 1000.0, 3)
+                          + "}");
+                }
+
+                ring.readPos.store(end, std::memory_order_release);
+            }
+
+            stream->flush();
+        }
+
+        void write(const juce::String& json)
+        {
+            *stream << (firstEvent ? "\n" : ",\n") << json;
+            firstEvent = false;
+        }
+
+        std::unique_ptr<juce::FileOutputStream> stream;
+        const int64_t originNanos;
+        bool firstEvent = true;
+    };
+
+    juce::CriticalSection sessionLock;
+    int sessionUsers = 0;
+    std::unique_ptr<Writer> writer;
+}
+
+//==============================================================================
+bool Trace::start(const juce::File& file)
+{
+    const juce::ScopedLock lock(sessionLock);
+
+    if (sessionUsers > 0)
+    {
+        ++sessionUsers;
+        return true;
+    }
+
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream>(file);
+    if (!stream->openedOk())
+        return false;
+
+    if (rings == nullptr)
+        rings = std::make_unique<std::array<ThreadRing, maxThreads>>();
+
+    // Whatever a thread recorded after the last session stopped is stale
+    for (auto& ring : *rings)
+    {
+        ring.readPos.store(ring.writePos.load(std::memory_order_acquire), std::memory_order_relaxed);
+        ring.writtenName = nullptr;
+    }
+
+    dropped.store(0);
+    writer = std::make_unique<Writer>(std::move(stream), now());
+    writer->startThread(juce::Thread::Priority::low);
+
+    sessionUsers = 1;
+    running.store(true, std::memory_order_release);
+    return true;
+}
+
+void Trace::stop()
+{
+    const juce::ScopedLock lock(sessionLock);
+
+    if (sessionUsers == 0 || --sessionUsers > 0)
+        return;
+
+    running.store(false, std::memory_order_release);
+    writer->finish();
+    writer.reset();
+}
+
+juce::File Trace::getDefaultFile()
+{
+    const auto path = juce::SystemStats::getEnvironmentVariable("AURA_TRACE_FILE", {});
+    if (path.isNotEmpty())
+        return juce::File::getCurrentWorkingDirectory().getChildFile(path);
+
+    return juce::File::getSpecialLocation(juce::File::tempDirectory)
+        .getChildFile("Aura-" + juce::Time::getCurrentTime().formatted("%Y%m%d-%H%M%S") + ".json");
+}
+
+void Trace::setThreadName(const char* name)
+{
+    if (!running.load(std::memory_order_acquire))
+        return;
+
+    if (auto* ring = getThreadRing())
+        ring->name.store(name, std::memory_order_release);
+}
+
+void Trace::record(const char* name, int64_t startNanos, int64_t endNanos)
+{
+    if (!running.load(std::memory_order_acquire))
+        return;
+
+    auto* ring = getThreadRing();
+    if (ring == nullptr)
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    const auto pos = ring->writePos.load(std::memory_order_relaxed);
+    if (pos - ring->readPos.load(std::memory_order_acquire) >= static_cast<uint64_t>(eventsPerThread))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ring->events[static_cast<size_t>(pos % eventsPerThread)] = { name, startNanos, endNanos };
+    ring->writePos.store(pos + 1, std::memory_order_release);
+}
+
+int64_t Trace::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace Aura
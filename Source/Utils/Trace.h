@@ -0,0 +1,85 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include <atomic>
+#include <cstdint>
+
+namespace Aura
+{
+
+//==============================================================================
+/**
+ * Trace
+ *
+ * Timeline of scoped events on the audio, message and worker threads,
+ * written as Chrome trace JSON for chrome://tracing or ui.perfetto.dev, so
+ * GUI stalls, preset I/O and audio overruns can be lined up in one view.
+ *
+ * Each thread records into its own fixed ring, claimed on its first event,
+ * so recording never locks or allocates. A background thread drains the
+ * rings into the file. An event that finds its ring full is dropped and
+ * counted.
+ *
+ * The AURA_TRACE_* macros compile to nothing unless AURA_TRACE is set
+ * (CMake: -DAURA_ENABLE_TRACE=ON). start() and stop() are reference
+ * counted and called from the message thread, so plugin instances can
+ * share one session.
+ */
+class Trace
+{
+public:
+    // Opens the file on the first start; later starts join the session
+    static bool start(const juce::File& file);
+    static void stop();
+    static bool isRunning() { return running.load(std::memory_order_relaxed); }
+
+    // AURA_TRACE_FILE if set, otherwise a timestamped file in the temp directory
+    static juce::File getDefaultFile();
+
+    // Names the calling thread in the timeline; takes a string literal
+    static void setThreadName(const char* name);
+
+    // Records a finished event; name must be a string literal
+    static void record(const char* name, int64_t startNanos, int64_t endNanos);
+    static int64_t now();
+
+    // Events lost to full rings or too many threads at once, this session
+    static int getNumDropped() { return dropped.load(std::memory_order_relaxed); }
+
+    static constexpr int maxThreads = 32;
+    static constexpr int eventsPerThread = 4096;    // power of two
+    static constexpr int flushIntervalMs = 50;
+
+    class Scope
+    {
+    public:
+        explicit Scope(const char* eventName) noexcept
+            : name(eventName), startNanos(isRunning() ? now() : -1) {}
+
+        ~Scope()
+        {
+            if (startNanos >= 0)
+                record(name, startNanos, now());
+        }
+
+    private:
+        const char* name;
+        const int64_t startNanos;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+private:
+    static std::atomic<bool> running;
+    static std::atomic<int> dropped;
+};
+
+} // namespace Aura
+
+#if AURA_TRACE
+ #define AURA_TRACE_SCOPE(name)  const ::Aura::Trace::Scope JUCE_JOIN_MACRO(auraTraceScope_, __LINE__) (name)
+ #define AURA_TRACE_THREAD(name) ::Aura::Trace::setThreadName(name)
+#else
+ #define AURA_TRACE_SCOPE(name)
+ #define AURA_TRACE_THREAD(name)
+#endif
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/BatchReverb.h"
+#include "../Source/DSP/BatchRenderer.h"
+#include <array>
+#include <vector>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class BatchReverbTest : public ::testing::Test
+{
+protected:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    static juce::AudioBuffer<float> makeNoise(int numChannels, int numSamples, int seed)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        juce::Random random(seed);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample(ch, i, random.nextFloat() - 0.5f);
+
+        return buffer;
+    }
+
+    // A different room per variant, set through RoomReverb's setters
+    template <typename Reverb>
+    static void configure(Reverb& reverb, int variant)
+    {
+        const float v = static_cast<float>(variant);
+        reverb.setSize(0.2f + 0.15f * v);
+        reverb.setDecay(0.8f + 0.9f * v);
+        reverb.setDamping(0.1f + 0.2f * v);
+        reverb.setPreDelay(7.0f * v);
+        reverb.setWidth(1.0f - 0.25f * v);
+        reverb.setHighCut(16000.0f - 3000.0f * v);
+        reverb.setLowCut(40.0f + 30.0f * v);
+        reverb.setModulationDepth(0.1f + 0.25f * v);
+        reverb.setModulationRate(0.5f + 0.4f * v);
+    }
+
+    static EngineSettings makeSettings(int variant)
+    {
+        const float v = static_cast<float>(variant % 5);
+        EngineSettings settings;
+        settings.roomType = variant % 3;
+        settings.size = 20.0f + 15.0f * v;
+        settings.decay = 0.6f + 0.8f * v;
+        settings.damping = 10.0f + 20.0f * v;
+        settings.preDelay = 5.0f * v;
+        settings.erLevel = 20.0f * v;
+        settings.modDepth = 10.0f + 15.0f * v;
+        return settings;
+    }
+};
+
+// Test that every lane renders what a RoomReverb with its settings renders
+TEST_F(BatchReverbTest, LanesMatchRoomReverb)
+{
+    constexpr int lanes = 4;
+    constexpr int numSamples = 24000;
+
+    BatchReverb<lanes> batch;
+    batch.prepare(sampleRate, blockSize);
+
+    std::vector<juce::AudioBuffer<float>> expected, actual;
+
+    for (int lane = 0; lane < lanes; ++lane)
+    {
+        auto settings = batch.getLane(lane);
+        configure(settings, lane);
+
+        auto input = makeNoise(2, numSamples, lane + 1);
+        for (int ch = 0; ch < 2; ++ch)
+            input.clear(ch, numSamples / 2, numSamples / 2);   // let the tail ring
+
+        RoomReverb reverb;
+        reverb.prepare(sampleRate, blockSize);
+        configure(reverb, lane);
+
+        expected.push_back(input);
+        for (int start = 0; start < numSamples; start += blockSize)
+        {
+            juce::AudioBuffer<float> block(expected.back().getArrayOfWritePointers(), 2, start, blockSize);
+            reverb.process(block);
+        }
+
+        actual.push_back(input);
+    }
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        std::vector<juce::AudioBuffer<float>> blocks;
+        std::array<juce::AudioBuffer<float>*, lanes> io;
+        blocks.reserve(lanes);
+
+        for (int lane = 0; lane < lanes; ++lane)
+            blocks.emplace_back(actual[static_cast<size_t>(lane)].getArrayOfWritePointers(), 2, start, blockSize);
+        for (int lane = 0; lane < lanes; ++lane)
+            io[static_cast<size_t>(lane)] = &blocks[static_cast<size_t>(lane)];
+
+        batch.process(io.data(), blockSize);
+    }
+
+    for (int lane = 0; lane < lanes; ++lane)
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                ASSERT_NEAR(actual[static_cast<size_t>(lane)].getSample(ch, i),
+                            expected[static_cast<size_t>(lane)].getSample(ch, i), 1.0e-4f)
+                    << "lane " << lane << ", channel " << ch << ", sample " << i;
+}
+
+// Test that a lane reset for its next job renders like a fresh reverb
+TEST_F(BatchReverbTest, ResetLaneStartsFresh)
+{
+    BatchReverb<4> batch;
+    batch.prepare(sampleRate, blockSize);
+
+    auto noise = makeNoise(2, blockSize, 9);
+    std::array<juce::AudioBuffer<float>*, 4> io = { &noise, nullptr, nullptr, nullptr };
+    for (int b = 0; b < 20; ++b)
+        batch.process(io.data(), blockSize);
+
+    // Once reset, the lane answers an impulse like a fresh reverb
+    batch.resetLane(0);
+
+    juce::AudioBuffer<float> actual(2, blockSize), expected(2, blockSize);
+    actual.clear();
+    actual.setSample(0, 0, 1.0f);
+    expected.makeCopyOf(actual);
+
+    io[0] = &actual;
+    batch.process(io.data(), blockSize);
+
+    RoomReverb reverb;
+    reverb.prepare(sampleRate, blockSize);
+    reverb.process(expected);
+
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < blockSize; ++i)
+            ASSERT_NEAR(actual.getSample(ch, i), expected.getSample(ch, i), 1.0e-6f) << "sample " << i;
+}
+
+// Test that the renderer's output for each job matches a serial engine render,
+// with more jobs than lanes and jobs of different lengths
+TEST_F(BatchReverbTest, RendererMatchesSerialEngine)
+{
+    for (int lanes : { 4, 8, 16 })
+    {
+        std::vector<RenderJob> jobs(static_cast<size_t>(lanes) + 3);
+
+        for (size_t j = 0; j < jobs.size(); ++j)
+        {
+            const int variant = static_cast<int>(j);
+            jobs[j].input = makeNoise(variant % 2 == 0 ? 2 : 1, 1000 + 700 * variant, variant);
+            jobs[j].settings = makeSettings(variant);
+            jobs[j].tailSamples = 3000 + 100 * variant;
+        }
+
+        BatchRenderer renderer(sampleRate, lanes);
+        renderer.render(jobs);
+
+        for (size_t j = 0; j < jobs.size(); ++j)
+        {
+            const auto& job = jobs[j];
+            const int length = job.input.getNumSamples() + job.tailSamples;
+            ASSERT_EQ(job.output.getNumSamples(), length);
+
+            juce::AudioBuffer<float> expected(2, length);
+            expected.clear();
+            for (int ch = 0; ch < 2; ++ch)
+                expected.copyFrom(ch, 0, job.input, juce::jmin(ch, job.input.getNumChannels() - 1), 0,
+                                  job.input.getNumSamples());
+
+            ReverbEngine engine;
+            engine.prepare(sampleRate, BatchRenderer::blockSize);
+            engine.apply(job.settings);
+
+            for (int start = 0; start < length; start += BatchRenderer::blockSize)
+            {
+                juce::AudioBuffer<float> block(expected.getArrayOfWritePointers(), 2, start,
+                                               juce::jmin(BatchRenderer::blockSize, length - start));
+                engine.process(block);
+            }
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < length; ++i)
+                    ASSERT_NEAR(job.output.getSample(ch, i), expected.getSample(ch, i), 1.0e-4f)
+                        << lanes << " lanes, job " << j << ", channel " << ch << ", sample " << i;
+        }
+    }
+}
+
+} // namespace Tests
+} // namespace Aura
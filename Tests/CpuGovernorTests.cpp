@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/CpuGovernor.h"
+
+namespace Aura
+{
+namespace Tests
+{
+
+class CpuGovernorTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        governor.prepare(sampleRate);
+
+        // Past the hold that follows prepare()
+        run(0.3, blocksFor(CpuGovernor::holdSeconds));
+    }
+
+    // Feeds numBlocks blocks that each take the given share of their deadline
+    int run(double load, int numBlocks, int blockSize = 256)
+    {
+        const double seconds = load * blockSize / sampleRate;
+        int level = governor.getLevel();
+
+        for (int b = 0; b < numBlocks; ++b)
+            level = governor.update(seconds, blockSize);
+
+        return level;
+    }
+
+    int blocksFor(double seconds, int blockSize = 256) const
+    {
+        return static_cast<int>(seconds * sampleRate / blockSize) + 1;
+    }
+
+    const double sampleRate = 48000.0;
+    CpuGovernor governor { 4 };
+};
+
+// Test that a light load never leaves full quality
+TEST_F(CpuGovernorTest, StaysAtFullWithHeadroom)
+{
+    EXPECT_EQ(run(0.3, blocksFor(10.0)), 0);
+}
+
+// Test that only several overruns in a row step down
+TEST_F(CpuGovernorTest, StepsDownAfterConsecutiveOverruns)
+{
+    EXPECT_EQ(run(1.2, CpuGovernor::overloadBlocks - 1), 0);
+    EXPECT_EQ(run(0.5, 1), 0);
+    EXPECT_EQ(run(1.2, CpuGovernor::overloadBlocks - 1), 0);
+    EXPECT_EQ(run(1.2, 1), 1);
+}
+
+// Test that a sustained overload steps down one level per hold time, down to the last level
+TEST_F(CpuGovernorTest, HoldsBetweenSteps)
+{
+    EXPECT_EQ(run(1.5, CpuGovernor::overloadBlocks), 1);
+    EXPECT_EQ(run(1.5, blocksFor(CpuGovernor::holdSeconds) - 2), 1);
+    EXPECT_EQ(run(1.5, blocksFor(1.0)), 3);
+    EXPECT_EQ(run(1.5, blocksFor(1.0)), 3);
+}
+
+// Test that tiny host blocks need the overrun to last, not just a count of blocks
+TEST_F(CpuGovernorTest, TinyBlocksNeedSustainedOverrun)
+{
+    EXPECT_EQ(run(2.0, CpuGovernor::overloadBlocks, 1), 0);
+    EXPECT_EQ(run(2.0, blocksFor(CpuGovernor::overloadMinSeconds, 1), 1), 1);
+}
+
+// Test that quality only comes back after seconds of real headroom
+TEST_F(CpuGovernorTest, StepsBackUpWithHysteresis)
+{
+    run(1.5, CpuGovernor::overloadBlocks);
+    ASSERT_EQ(governor.getLevel(), 1);
+
+    // Within budget, but not with enough room to spare
+    EXPECT_EQ(run(0.6, blocksFor(2.0 * CpuGovernor::recoverySeconds)), 1);
+
+    // Any block without headroom restarts the wait
+    EXPECT_EQ(run(0.2, blocksFor(CpuGovernor::recoverySeconds) - 2), 1);
+    EXPECT_EQ(run(0.6, 1), 1);
+    EXPECT_EQ(run(0.2, blocksFor(CpuGovernor::recoverySeconds) - 2), 1);
+    EXPECT_EQ(run(0.2, 2), 0);
+}
+
+// Test that reset goes straight back to full quality
+TEST_F(CpuGovernorTest, ResetRestoresFullQuality)
+{
+    run(1.5, blocksFor(1.0));
+    ASSERT_GT(governor.getLevel(), 0);
+
+    governor.reset();
+    EXPECT_EQ(governor.getLevel(), 0);
+    EXPECT_EQ(run(1.5, CpuGovernor::overloadBlocks), 0);   // held again after a reset
+}
+
+} // namespace Tests
+} // namespace Aura
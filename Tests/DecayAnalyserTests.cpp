@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/DecayAnalyser.h"
+#include <cmath>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class DecayAnalyserTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        analyser.prepare(sampleRate);
+        analyser.setEnabled(true);
+    }
+
+    // Steady noise, then noise decaying 60 dB in rt60 seconds, then silence
+    void feedDecay(float rt60)
+    {
+        juce::Random random(42);
+        const int steadySamples = static_cast<int>(0.5 * sampleRate);
+        const int decaySamples = static_cast<int>(3.0 * sampleRate);
+        const int totalSamples = steadySamples + decaySamples + static_cast<int>(0.5 * sampleRate);
+
+        juce::AudioBuffer<float> block(2, blockSize);
+
+        for (int start = 0; start < totalSamples; start += blockSize)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const int n = start + i;
+                float gain = 0.0f;
+
+                if (n < steadySamples)
+                    gain = 1.0f;
+                else if (n < steadySamples + decaySamples)
+                    gain = std::exp(-6.9078f * static_cast<float>(n - steadySamples) / static_cast<float>(sampleRate) / rt60);
+
+                const float sample = (random.nextFloat() - 0.5f) * gain;
+                block.setSample(0, i, sample);
+                block.setSample(1, i, sample);
+            }
+
+            analyser.push(block);
+            analyser.process();
+        }
+    }
+
+    const double sampleRate = 48000.0;
+    const int blockSize = 512;
+    DecayAnalyser analyser;
+};
+
+// Test that nothing is reported before a decay has been seen
+TEST_F(DecayAnalyserTest, NothingMeasuredInitially)
+{
+    EXPECT_EQ(analyser.getLatest().generation, 0);
+    EXPECT_TRUE(std::isnan(analyser.getLatest().rt60[DecayAnalysis::Broadband]));
+    EXPECT_FALSE(analyser.process());
+}
+
+// Test that the RT60 of a known exponential decay is recovered
+TEST_F(DecayAnalyserTest, MeasuresKnownDecay)
+{
+    feedDecay(1.2f);
+
+    const auto& result = analyser.getLatest();
+    ASSERT_EQ(result.generation, 1);
+    EXPECT_NEAR(result.rt60[DecayAnalysis::Broadband], 1.2f, 0.12f);
+    EXPECT_NEAR(result.rt60[DecayAnalysis::Mid], 1.2f, 0.18f);
+    EXPECT_NEAR(result.rt60[DecayAnalysis::High], 1.2f, 0.18f);
+
+    ASSERT_FALSE(result.energyDecayCurve.empty());
+    EXPECT_NEAR(result.energyDecayCurve.front(), 0.0f, 0.01f);
+}
+
+// Test that the audio side does nothing while disabled
+TEST_F(DecayAnalyserTest, DisabledIgnoresInput)
+{
+    analyser.setEnabled(false);
+    feedDecay(1.2f);
+
+    EXPECT_EQ(analyser.getLatest().generation, 0);
+}
+
+// Test the Schroeder integral and line fit on an ideal exponential
+TEST_F(DecayAnalyserTest, SchroederIntegralOfExponential)
+{
+    const float frameSeconds = 0.01f;
+    const float rt60 = 2.0f;
+
+    std::vector<float> energies;
+    for (int i = 0; i < 1000; ++i)
+        energies.push_back(std::pow(10.0f, -6.0f * static_cast<float>(i) * frameSeconds / rt60));
+
+    auto curve = DecayAnalyser::schroederIntegral(energies);
+
+    EXPECT_NEAR(curve.front(), 0.0f, 1.0e-4f);
+    EXPECT_NEAR(DecayAnalyser::estimateRT60(curve, frameSeconds), rt60, 0.02f);
+}
+
+} // namespace Tests
+} // namespace Aura
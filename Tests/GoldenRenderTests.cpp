@@ -0,0 +1,294 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/ReverbEngine.h"
+#include "../Source/Utils/FactoryPresets.h"
+#include "../Source/Utils/PresetManager.h"
+#include "ParameterHost.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * Golden renders
+ *
+ * Every factory preset renders an impulse, a sine sweep and a noise burst
+ * through ReverbEngine, and the result is compared with a reference WAV in
+ * Tests/Golden. A missing reference fails the test.
+ *
+ *   AURA_UPDATE_GOLDEN=1        record all references, replacing any there
+ *   AURA_GOLDEN_MODE=exact      require bit-identical output
+ *   AURA_GOLDEN_MODE=tolerance  (default) allow a few ULPs per sample and a
+ *                               small difference in the third-octave spectrum
+ *
+ * Use exact mode for refactors that must not change the arithmetic, and
+ * tolerance mode for SIMD or reordering work that legitimately rounds differently.
+ */
+
+#ifndef AURA_GOLDEN_DIR
+ #define AURA_GOLDEN_DIR "Tests/Golden"
+#endif
+
+namespace Aura
+{
+namespace Tests
+{
+
+namespace
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int fftOrder = 16;
+    constexpr int renderLength = 1 << fftOrder;     // ~1.4 s
+
+    constexpr int maxUlps = 256;
+    constexpr float absoluteFloor = 1.0e-7f;        // below this, ULPs are meaningless
+    constexpr float maxBandDifferenceDb = 0.1f;
+
+    enum class Signal { Impulse, Sweep, Noise };
+
+    const char* getSignalName(Signal signal)
+    {
+        switch (signal)
+        {
+            case Signal::Impulse: return "impulse";
+            case Signal::Sweep:   return "sweep";
+            case Signal::Noise:   return "noise";
+        }
+        return "";
+    }
+
+    juce::AudioBuffer<float> makeSignal(Signal signal)
+    {
+        juce::AudioBuffer<float> buffer(2, renderLength);
+        buffer.clear();
+
+        if (signal == Signal::Impulse)
+        {
+            buffer.setSample(0, 0, 1.0f);
+            buffer.setSample(1, 0, 1.0f);
+        }
+        else if (signal == Signal::Sweep)
+        {
+            // Exponential sweep, 20 Hz to 20 kHz over a quarter of the render
+            const int length = renderLength / 4;
+            const double f0 = 20.0, f1 = 20000.0;
+            const double duration = length / sampleRate;
+            const double k = std::log(f1 / f0);
+
+            for (int i = 0; i < length; ++i)
+            {
+                const double t = i / sampleRate;
+                const double phase = juce::MathConstants<double>::twoPi * f0 * duration / k * (std::exp(t * k / duration) - 1.0);
+                const auto sample = static_cast<float>(0.5 * std::sin(phase));
+                buffer.setSample(0, i, sample);
+                buffer.setSample(1, i, sample);
+            }
+        }
+        else
+        {
+            // Decorrelated noise burst with a fixed seed
+            juce::Random random(0x41555241);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < renderLength / 8; ++i)
+                    buffer.setSample(ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.5f);
+        }
+
+        return buffer;
+    }
+
+    // Distance between two floats in units in the last place
+    juce::int64 ulpDistance(float a, float b)
+    {
+        juce::int32 ia, ib;
+        std::memcpy(&ia, &a, sizeof(float));
+        std::memcpy(&ib, &b, sizeof(float));
+
+        // Map the sign-magnitude bit patterns onto a monotonic integer line
+        if (ia < 0) ia = std::numeric_limits<juce::int32>::min() - ia;
+        if (ib < 0) ib = std::numeric_limits<juce::int32>::min() - ib;
+
+        return std::abs(static_cast<juce::int64>(ia) - static_cast<juce::int64>(ib));
+    }
+
+    // Energy per third-octave band from 20 Hz, in dB
+    std::vector<float> getThirdOctaveBands(const juce::AudioBuffer<float>& buffer, int channel)
+    {
+        juce::dsp::FFT fft(fftOrder);
+        std::vector<float> data(static_cast<size_t>(2 * fft.getSize()), 0.0f);
+        std::copy(buffer.getReadPointer(channel), buffer.getReadPointer(channel) + renderLength, data.begin());
+        fft.performFrequencyOnlyForwardTransform(data.data());
+
+        const double binHz = sampleRate / fft.getSize();
+        std::vector<float> bands;
+
+        for (double low = 20.0; low < sampleRate * 0.5; low *= std::pow(2.0, 1.0 / 3.0))
+        {
+            const double high = juce::jmin(low * std::pow(2.0, 1.0 / 3.0), sampleRate * 0.5);
+            double energy = 0.0;
+
+            for (auto bin = static_cast<int>(low / binHz); bin < static_cast<int>(high / binHz); ++bin)
+                energy += static_cast<double>(data[static_cast<size_t>(bin)]) * data[static_cast<size_t>(bin)];
+
+            bands.push_back(static_cast<float>(10.0 * std::log10(energy + 1.0e-30)));
+        }
+
+        return bands;
+    }
+
+    bool readWav(const juce::File& file, juce::AudioBuffer<float>& buffer)
+    {
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatReader> reader(wav.createReaderFor(file.createInputStream().release(), true));
+
+        if (reader == nullptr)
+            return false;
+
+        buffer.setSize(static_cast<int>(reader->numChannels), static_cast<int>(reader->lengthInSamples));
+        return reader->read(&buffer, 0, buffer.getNumSamples(), 0, true, true);
+    }
+
+    bool writeWav(const juce::File& file, const juce::AudioBuffer<float>& buffer)
+    {
+        file.getParentDirectory().createDirectory();
+        file.deleteFile();
+
+        // 32-bit WAV is written as IEEE float, so the round trip is lossless
+        juce::WavAudioFormat wav;
+        std::unique_ptr<juce::AudioFormatWriter> writer(
+            wav.createWriterFor(file.createOutputStream().release(), sampleRate,
+                                static_cast<unsigned int>(buffer.getNumChannels()), 32, {}, 0));
+
+        return writer != nullptr && writer->writeFromAudioSampleBuffer(buffer, 0, buffer.getNumSamples());
+    }
+
+    bool isEnvironmentFlagSet(const char* name, const char* value)
+    {
+        const char* flag = std::getenv(name);
+        return flag != nullptr && juce::String(flag).equalsIgnoreCase(value);
+    }
+}
+
+//==============================================================================
+class GoldenRenderTest : public ::testing::TestWithParam<std::tuple<int, Signal>>
+{
+protected:
+    juce::AudioBuffer<float> render(int presetIndex, Signal signal)
+    {
+        juce::NamedValueSet values;
+        presets.getPresetValues(presets.getFactoryPresetNames()[presetIndex], values);
+
+        ReverbEngine engine;
+        engine.prepare(sampleRate, blockSize);
+        engine.reset();
+        engine.apply(EngineSettings::fromValues(values));
+
+        auto buffer = makeSignal(signal);
+
+        for (int start = 0; start < renderLength; start += blockSize)
+        {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                           start, juce::jmin(blockSize, renderLength - start));
+            engine.process(block);
+        }
+
+        return buffer;
+    }
+
+    juce::File getGoldenFile(int presetIndex, Signal signal) const
+    {
+        auto name = juce::String(presetIndex).paddedLeft('0', 2) + "_"
+                  + presets.getFactoryPresetNames()[presetIndex].replaceCharacter(' ', '_') + "_"
+                  + getSignalName(signal) + ".wav";
+
+        return juce::File(AURA_GOLDEN_DIR).getChildFile(juce::File::createLegalFileName(name));
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    ParameterHost host;
+    PresetManager presets { host.apvts };
+};
+
+TEST_P(GoldenRenderTest, MatchesReference)
+{
+    const auto [presetIndex, signal] = GetParam();
+    ASSERT_LT(presetIndex, presets.getNumFactoryPresets());
+
+    auto output = render(presetIndex, signal);
+    auto goldenFile = getGoldenFile(presetIndex, signal);
+
+    if (isEnvironmentFlagSet("AURA_UPDATE_GOLDEN", "1"))
+    {
+        ASSERT_TRUE(writeWav(goldenFile, output)) << goldenFile.getFullPathName();
+        GTEST_SKIP() << "Recorded " << goldenFile.getFileName();
+    }
+
+    // A reference that silently re-records itself would pass any change
+    ASSERT_TRUE(goldenFile.existsAsFile())
+        << "Missing reference " << goldenFile.getFullPathName() << "; run with AURA_UPDATE_GOLDEN=1 to record it";
+
+    juce::AudioBuffer<float> golden;
+    ASSERT_TRUE(readWav(goldenFile, golden)) << goldenFile.getFullPathName();
+    ASSERT_EQ(golden.getNumChannels(), output.getNumChannels());
+    ASSERT_EQ(golden.getNumSamples(), output.getNumSamples());
+
+    if (isEnvironmentFlagSet("AURA_GOLDEN_MODE", "exact"))
+    {
+        for (int ch = 0; ch < output.getNumChannels(); ++ch)
+        {
+            EXPECT_EQ(std::memcmp(output.getReadPointer(ch), golden.getReadPointer(ch),
+                                  sizeof(float) * static_cast<size_t>(output.getNumSamples())), 0)
+                << "channel " << ch << " differs from " << goldenFile.getFileName();
+        }
+        return;
+    }
+
+    for (int ch = 0; ch < output.getNumChannels(); ++ch)
+    {
+        const float* actual = output.getReadPointer(ch);
+        const float* expected = golden.getReadPointer(ch);
+
+        int worstSample = -1;
+        juce::int64 worstUlps = 0;
+
+        for (int i = 0; i < output.getNumSamples(); ++i)
+        {
+            if (std::abs(actual[i] - expected[i]) <= absoluteFloor)
+                continue;
+
+            auto ulps = ulpDistance(actual[i], expected[i]);
+            if (ulps > worstUlps)
+            {
+                worstUlps = ulps;
+                worstSample = i;
+            }
+        }
+
+        EXPECT_LE(worstUlps, maxUlps) << "channel " << ch << ", sample " << worstSample;
+
+        auto actualBands = getThirdOctaveBands(output, ch);
+        auto expectedBands = getThirdOctaveBands(golden, ch);
+
+        for (size_t band = 0; band < actualBands.size(); ++band)
+        {
+            // Bands far below the signal are all rounding noise
+            if (expectedBands[band] < -100.0f)
+                continue;
+
+            EXPECT_NEAR(actualBands[band], expectedBands[band], maxBandDifferenceDb)
+                << "channel " << ch << ", third-octave band " << band;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(FactoryPresets, GoldenRenderTest,
+                         ::testing::Combine(::testing::Range(0, FactoryPresets::numPresets),
+                                            ::testing::Values(Signal::Impulse, Signal::Sweep, Signal::Noise)),
+                         [](const ::testing::TestParamInfo<GoldenRenderTest::ParamType>& info)
+                         {
+                             return "Preset" + std::to_string(std::get<0>(info.param)) + "_"
+                                  + getSignalName(std::get<1>(info.param));
+                         });
+
+} // namespace Tests
+} // namespace Aura
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/InputDiffuser.h"
+#include <cmath>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class InputDiffuserTest : public ::testing::Test
+{
+protected:
+    static constexpr double sampleRate = 48000.0;
+
+    void SetUp() override
+    {
+        diffuser.prepare(sampleRate);
+    }
+
+    InputDiffuser diffuser;
+};
+
+// Test that the cascade is allpass: an impulse keeps its energy
+TEST_F(InputDiffuserTest, PreservesEnergy)
+{
+    double energy = 0.0;
+
+    for (int i = 0; i < static_cast<int>(sampleRate) * 2; ++i)
+    {
+        const float out = diffuser.process(i == 0 ? 1.0f : 0.0f);
+        energy += static_cast<double>(out) * out;
+    }
+
+    EXPECT_NEAR(energy, 1.0, 1.0e-3);
+}
+
+// Test that one impulse comes out as many echoes within the first 30 ms
+TEST_F(InputDiffuserTest, RaisesEchoDensity)
+{
+    int echoes = 0;
+
+    for (int i = 0; i < static_cast<int>(0.03 * sampleRate); ++i)
+    {
+        if (std::abs(diffuser.process(i == 0 ? 1.0f : 0.0f)) > 1.0e-3f)
+            ++echoes;
+    }
+
+    EXPECT_GT(echoes, 20);
+}
+
+// Test that the mono path matches the stereo path with the same input on both sides
+TEST_F(InputDiffuserTest, MonoMatchesStereo)
+{
+    InputDiffuser stereo;
+    stereo.prepare(sampleRate);
+
+    juce::Random random(3);
+    for (int i = 0; i < 4800; ++i)
+    {
+        const float input = random.nextFloat() - 0.5f;
+        float left = input, right = input;
+        stereo.process(left, right);
+
+        const float mono = diffuser.process(input);
+        ASSERT_FLOAT_EQ(mono, left);
+        ASSERT_FLOAT_EQ(mono, right);
+    }
+}
+
+// Test that the channels don't leak into each other
+TEST_F(InputDiffuserTest, ChannelsAreIndependent)
+{
+    for (int i = 0; i < 4800; ++i)
+    {
+        float left = i == 0 ? 1.0f : 0.0f;
+        float right = 0.0f;
+        diffuser.process(left, right);
+
+        ASSERT_FLOAT_EQ(right, 0.0f);
+    }
+}
+
+} // namespace Tests
+} // namespace Aura
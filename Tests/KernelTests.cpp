@@ -0,0 +1,306 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/EarlyReflections.h"
+#include "../Source/DSP/Kernels.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class KernelTest : public ::testing::Test
+{
+protected:
+    // Lengths around every vector width, including empty and tail-only
+    static constexpr int lengths[] = { 0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 33, 63, 512, 515 };
+
+    static std::vector<float> makeNoise(int numSamples, int seed)
+    {
+        std::vector<float> data(static_cast<size_t>(numSamples));
+        juce::Random random(seed);
+
+        for (auto& sample : data)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        return data;
+    }
+};
+
+// Test that the selected table is one this CPU can run
+TEST_F(KernelTest, SelectedTableIsAvailable)
+{
+    const auto available = Kernels::getAvailable();
+    ASSERT_FALSE(available.empty());
+    EXPECT_EQ(available.front(), &Kernels::getScalar());
+
+    // The widest supported table wins
+    const auto* selected = &Kernels::get();
+    EXPECT_EQ(selected, available.size() > 1 ? available[1] : available[0]);
+    RecordProperty("kernels", selected->name);
+}
+
+// Test every variant of the tap sum against the scalar reference
+TEST_F(KernelTest, AddWithMultiplyMatchesScalar)
+{
+    const auto& scalar = Kernels::getScalar();
+
+    for (const auto* table : Kernels::getAvailable())
+    {
+        for (int length : lengths)
+        {
+            const auto source = makeNoise(length, 1);
+            auto expected = makeNoise(length, 2);
+            auto actual = expected;
+
+            scalar.addWithMultiply(expected.data(), source.data(), 0.37f, length);
+            table->addWithMultiply(actual.data(), source.data(), 0.37f, length);
+
+            for (int i = 0; i < length; ++i)
+                ASSERT_EQ(actual[static_cast<size_t>(i)], expected[static_cast<size_t>(i)])
+                    << table->name << ", length " << length << ", sample " << i;
+        }
+    }
+}
+
+// Test every variant of the ramped dry/wet mix against the scalar reference
+TEST_F(KernelTest, MixRampMatchesScalar)
+{
+    const auto& scalar = Kernels::getScalar();
+
+    for (const auto* table : Kernels::getAvailable())
+    {
+        for (int length : lengths)
+        {
+            const auto wet = makeNoise(length, 3);
+            auto expected = makeNoise(length, 4);
+            auto actual = expected;
+
+            scalar.mixRamp(expected.data(), wet.data(), length, 0.9f, -0.001f, 0.1f, 0.0015f);
+            table->mixRamp(actual.data(), wet.data(), length, 0.9f, -0.001f, 0.1f, 0.0015f);
+
+            for (int i = 0; i < length; ++i)
+                ASSERT_EQ(actual[static_cast<size_t>(i)], expected[static_cast<size_t>(i)])
+                    << table->name << ", length " << length << ", sample " << i;
+        }
+    }
+}
+
+// Test that every half survives the trip through float, and that floats
+// round to the nearest half
+TEST_F(KernelTest, HalfFloatConversion)
+{
+    for (uint32_t bits = 0; bits <= 0xffffu; ++bits)
+    {
+        const auto half = static_cast<uint16_t>(bits);
+        const float value = HalfFloat::toFloat(half);
+
+        if (std::isnan(value))
+            EXPECT_TRUE(std::isnan(HalfFloat::toFloat(HalfFloat::fromFloat(value)))) << bits;
+        else
+            ASSERT_EQ(HalfFloat::fromFloat(value), half) << bits;
+    }
+
+    EXPECT_EQ(HalfFloat::toFloat(HalfFloat::fromFloat(1.0f)), 1.0f);
+    EXPECT_EQ(HalfFloat::toFloat(HalfFloat::fromFloat(1.0f + 1.0f / 2048.0f)), 1.0f);              // ties to even
+    EXPECT_EQ(HalfFloat::toFloat(HalfFloat::fromFloat(1.0f + 3.0f / 2048.0f)), 1.0f + 1.0f / 512.0f);
+    EXPECT_TRUE(std::isinf(HalfFloat::toFloat(HalfFloat::fromFloat(70000.0f))));
+    EXPECT_EQ(HalfFloat::toFloat(HalfFloat::fromFloat(1.0e-9f)), 0.0f);
+}
+
+// Test every variant of the half precision store against the scalar reference
+TEST_F(KernelTest, FloatToHalfMatchesScalar)
+{
+    const auto& scalar = Kernels::getScalar();
+
+    for (const auto* table : Kernels::getAvailable())
+    {
+        for (int length : lengths)
+        {
+            const auto source = makeNoise(length, 7);
+            std::vector<uint16_t> expected(static_cast<size_t>(length)), actual(expected.size());
+
+            scalar.floatToHalf(expected.data(), source.data(), length);
+            table->floatToHalf(actual.data(), source.data(), length);
+
+            for (int i = 0; i < length; ++i)
+                ASSERT_EQ(actual[static_cast<size_t>(i)], expected[static_cast<size_t>(i)])
+                    << table->name << ", length " << length << ", sample " << i;
+        }
+    }
+}
+
+// Test that every variant finds a NaN or Inf wherever it sits in the block
+TEST_F(KernelTest, IsFiniteFindsEveryNonFiniteSample)
+{
+    const float nonFinite[] = { std::numeric_limits<float>::quiet_NaN(),
+                                std::numeric_limits<float>::infinity(),
+                                -std::numeric_limits<float>::infinity() };
+
+    for (const auto* table : Kernels::getAvailable())
+    {
+        for (int length : lengths)
+        {
+            auto data = makeNoise(length, 12);
+
+            // The extremes of the finite range must pass
+            if (length > 1)
+            {
+                data.front() = std::numeric_limits<float>::max();
+                data.back() = -std::numeric_limits<float>::denorm_min();
+            }
+
+            ASSERT_TRUE(table->isFinite(data.data(), length)) << table->name << ", length " << length;
+
+            for (int i = 0; i < length; ++i)
+            {
+                for (float value : nonFinite)
+                {
+                    auto poisoned = data;
+                    poisoned[static_cast<size_t>(i)] = value;
+                    ASSERT_FALSE(table->isFinite(poisoned.data(), length))
+                        << table->name << ", length " << length << ", sample " << i;
+                }
+            }
+        }
+    }
+}
+
+// Test every variant of the half precision tap sum against the scalar reference
+TEST_F(KernelTest, AddHalfWithMultiplyMatchesScalar)
+{
+    const auto& scalar = Kernels::getScalar();
+
+    for (const auto* table : Kernels::getAvailable())
+    {
+        for (int length : lengths)
+        {
+            const auto noise = makeNoise(length, 8);
+            std::vector<uint16_t> source(noise.size());
+            scalar.floatToHalf(source.data(), noise.data(), length);
+
+            auto expected = makeNoise(length, 9);
+            auto actual = expected;
+
+            scalar.addHalfWithMultiply(expected.data(), source.data(), 0.37f, length);
+            table->addHalfWithMultiply(actual.data(), source.data(), 0.37f, length);
+
+            for (int i = 0; i < length; ++i)
+                ASSERT_EQ(actual[static_cast<size_t>(i)], expected[static_cast<size_t>(i)])
+                    << table->name << ", length " << length << ", sample " << i;
+        }
+    }
+}
+
+// Test that block-wise early reflections match a per-sample tap sum, across
+// block sizes that wrap the delay line at different points
+TEST_F(KernelTest, EarlyReflectionsMatchPerSampleTaps)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int totalSamples = 24000;
+    constexpr float size = 0.6f;
+    constexpr float level = 0.5f;
+
+    const std::array<float, EarlyReflections::NumTaps> gains = {
+        0.8f, 0.7f, 0.6f, 0.55f, 0.5f, 0.45f,
+        0.4f, 0.35f, 0.3f, 0.25f, 0.2f, 0.15f
+    };
+
+    const auto left = makeNoise(totalSamples, 5);
+    const auto right = makeNoise(totalSamples, 6);
+
+    // Per-sample reference, with taps alternating between the channels
+    juce::AudioBuffer<float> expected(2, totalSamples);
+    for (int i = 0; i < totalSamples; ++i)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            float sum = 0.0f;
+            for (int tap = 0; tap < EarlyReflections::NumTaps; ++tap)
+            {
+                const int read = i - EarlyReflections::getTapDelay(tap, size, sampleRate);
+                const auto& source = (tap + ch) % 2 == 0 ? left : right;
+                if (read >= 0)
+                    sum += source[static_cast<size_t>(read)] * gains[static_cast<size_t>(tap)];
+            }
+
+            const float dry = (ch == 0 ? left : right)[static_cast<size_t>(i)];
+            expected.setSample(ch, i, dry + sum * level);
+        }
+    }
+
+    for (int blockSize : { 1, 37, 512 })
+    {
+        EarlyReflections er;
+        er.prepare(sampleRate, 512);
+        er.setSize(size);
+        er.setLevel(level);
+
+        juce::AudioBuffer<float> actual(2, totalSamples);
+        std::copy(left.begin(), left.end(), actual.getWritePointer(0));
+        std::copy(right.begin(), right.end(), actual.getWritePointer(1));
+
+        for (int start = 0; start < totalSamples; start += blockSize)
+        {
+            juce::AudioBuffer<float> block(actual.getArrayOfWritePointers(), 2, start,
+                                           juce::jmin(blockSize, totalSamples - start));
+            er.process(block);
+        }
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < totalSamples; ++i)
+                ASSERT_NEAR(actual.getSample(ch, i), expected.getSample(ch, i), 1.0e-5f)
+                    << "block " << blockSize << ", channel " << ch << ", sample " << i;
+    }
+}
+
+// Test that early reflections read from half precision lines stay within
+// the rounding of the stored samples
+TEST_F(KernelTest, HalfPrecisionEarlyReflections)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int totalSamples = 24000;
+    constexpr int blockSize = 256;
+
+    std::array<EarlyReflections, 2> ers;
+    ers[1].setDelayPrecision(DelayPrecision::Half);
+
+    for (auto& er : ers)
+    {
+        er.prepare(sampleRate, blockSize);
+        er.setSize(0.6f);
+        er.setLevel(1.0f);
+    }
+
+    const auto lineSamples = static_cast<size_t>(EarlyReflections::getDelayCapacity(sampleRate, blockSize));
+    EXPECT_EQ(ers[0].getMemoryFootprint() - ers[1].getMemoryFootprint(), 2 * lineSamples * sizeof(uint16_t));
+
+    const auto left = makeNoise(totalSamples, 10);
+    const auto right = makeNoise(totalSamples, 11);
+    std::array<juce::AudioBuffer<float>, 2> outputs;
+
+    for (size_t e = 0; e < ers.size(); ++e)
+    {
+        outputs[e].setSize(2, totalSamples);
+        std::copy(left.begin(), left.end(), outputs[e].getWritePointer(0));
+        std::copy(right.begin(), right.end(), outputs[e].getWritePointer(1));
+
+        for (int start = 0; start < totalSamples; start += blockSize)
+        {
+            juce::AudioBuffer<float> block(outputs[e].getArrayOfWritePointers(), 2, start, blockSize);
+            ers[e].process(block);
+        }
+    }
+
+    // Each of the twelve taps rounds to 11 significant bits
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < totalSamples; ++i)
+            ASSERT_NEAR(outputs[1].getSample(ch, i), outputs[0].getSample(ch, i), 5.0e-3f)
+                << "channel " << ch << ", sample " << i;
+}
+
+} // namespace Tests
+} // namespace Aura
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/OutputStage.h"
+#include <cmath>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class OutputStageTest : public ::testing::Test
+{
+protected:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    void SetUp() override
+    {
+        stage.prepare(sampleRate, 1024);
+        dry.setSize(2, blockSize);
+        wet.setSize(2, blockSize);
+        fill(1.0f, 0.5f);
+    }
+
+    void fill(float dryValue, float wetValue)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            juce::FloatVectorOperations::fill(dry.getWritePointer(ch), dryValue, blockSize);
+            juce::FloatVectorOperations::fill(wet.getWritePointer(ch), wetValue, blockSize);
+        }
+    }
+
+    OutputStage stage;
+    juce::AudioBuffer<float> dry;
+    juce::AudioBuffer<float> wet;
+};
+
+// Test the linear mix law with output gain
+TEST_F(OutputStageTest, LinearMix)
+{
+    stage.process(dry, wet, 0.25f, 2.0f);
+
+    for (int i = 0; i < blockSize; ++i)
+        EXPECT_NEAR(dry.getSample(0, i), (0.75f * 1.0f + 0.25f * 0.5f) * 2.0f, 1.0e-6f);
+}
+
+// Test that the equal-power law keeps both paths at -3 dB in the middle
+TEST_F(OutputStageTest, EqualPowerMix)
+{
+    stage.setMixLaw(OutputStage::MixLaw::EqualPower);
+    stage.process(dry, wet, 0.5f, 1.0f);
+
+    const float halfPower = std::sqrt(0.5f);
+    EXPECT_NEAR(dry.getSample(1, 100), halfPower * 1.0f + halfPower * 0.5f, 1.0e-6f);
+}
+
+// Test that mix changes are ramped instead of jumping
+TEST_F(OutputStageTest, MixIsSmoothed)
+{
+    stage.process(dry, wet, 0.0f, 1.0f);
+    EXPECT_FLOAT_EQ(dry.getSample(0, blockSize - 1), 1.0f);
+
+    // Jump to fully wet: the first sample still continues from fully dry
+    fill(1.0f, 0.0f);
+    stage.process(dry, wet, 1.0f, 1.0f);
+    EXPECT_FLOAT_EQ(dry.getSample(0, 0), 1.0f);
+    EXPECT_LT(dry.getSample(0, blockSize - 1), 1.0f);
+    EXPECT_GT(dry.getSample(0, blockSize - 1), 0.5f);
+
+    // After the smoothing time the output is fully wet
+    const int blocksToSettle = static_cast<int>(OutputStage::smoothingSeconds * sampleRate) / blockSize + 2;
+    for (int b = 0; b < blocksToSettle; ++b)
+    {
+        fill(1.0f, 0.0f);
+        stage.process(dry, wet, 1.0f, 1.0f);
+    }
+
+    EXPECT_FLOAT_EQ(dry.getSample(0, blockSize - 1), 0.0f);
+}
+
+// Test that the dry path is delayed by the requested number of samples
+TEST_F(OutputStageTest, DryDelay)
+{
+    constexpr int delay = 37;
+    stage.setDryDelay(delay);
+    EXPECT_EQ(stage.getDryDelay(), delay);
+
+    dry.clear();
+    wet.clear();
+    dry.setSample(0, 10, 1.0f);
+
+    stage.process(dry, wet, 0.0f, 1.0f);
+
+    EXPECT_FLOAT_EQ(dry.getSample(0, 10), 0.0f);
+    EXPECT_FLOAT_EQ(dry.getSample(0, 10 + delay), 1.0f);
+}
+
+// Test that the dry delay carries over into the next block
+TEST_F(OutputStageTest, DryDelayAcrossBlocks)
+{
+    stage.setDryDelay(100);
+
+    dry.clear();
+    wet.clear();
+    dry.setSample(1, blockSize - 1, 1.0f);
+    stage.process(dry, wet, 0.0f, 1.0f);
+
+    dry.clear();
+    stage.process(dry, wet, 0.0f, 1.0f);
+
+    EXPECT_FLOAT_EQ(dry.getSample(1, 99), 1.0f);
+}
+
+} // namespace Tests
+} // namespace Aura
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../Source/Utils/Parameters.h"
+#include <juce_audio_processors/juce_audio_processors.h>
+
+namespace Aura
+{
+namespace Tests
+{
+
+//==============================================================================
+/**
+ * Minimal processor that owns an APVTS with Aura's parameter layout,
+ * for testing code that works on parameters without the full plugin.
+ */
+class ParameterHost : public juce::AudioProcessor
+{
+public:
+    ParameterHost()
+        : apvts(*this, nullptr, "PARAMETERS", createParameterLayout())
+    {
+    }
+
+    const juce::String getName() const override { return "ParameterHost"; }
+    void prepareToPlay(double, int) override {}
+    void releaseResources() override {}
+    void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+    double getTailLengthSeconds() const override { return 0.0; }
+    bool acceptsMidi() const override { return false; }
+    bool producesMidi() const override { return false; }
+    juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+    bool hasEditor() const override { return false; }
+    int getNumPrograms() override { return 1; }
+    int getCurrentProgram() override { return 0; }
+    void setCurrentProgram(int) override {}
+    const juce::String getProgramName(int) override { return {}; }
+    void changeProgramName(int, const juce::String&) override {}
+    void getStateInformation(juce::MemoryBlock&) override {}
+    void setStateInformation(const void*, int) override {}
+
+    void setParameter(const juce::String& id, float value)
+    {
+        auto* param = apvts.getParameter(id);
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    float getParameter(const juce::String& id) const
+    {
+        return apvts.getRawParameterValue(id)->load();
+    }
+
+    juce::AudioProcessorValueTreeState apvts;
+};
+
+} // namespace Tests
+} // namespace Aura
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include "../Source/Utils/PresetBank.h"
+#include <cmath>
+#include <cstring>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class PresetBankTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        bankFile = juce::File::createTempFile(".aurabank");
+        parameterIds = { "size", "decay", "mix" };
+    }
+
+    void TearDown() override
+    {
+        bank.close();
+        bankFile.deleteFile();
+    }
+
+    static PresetBank::Preset makePreset(const juce::String& name, float size, float decay, float mix)
+    {
+        PresetBank::Preset preset;
+        preset.name = name;
+        preset.category = "User";
+        preset.values = { size, decay, mix };
+        return preset;
+    }
+
+    juce::File bankFile;
+    juce::StringArray parameterIds;
+    PresetBank bank;
+};
+
+// Test that a written bank reads back identically
+TEST_F(PresetBankTest, RoundTrip)
+{
+    std::vector<PresetBank::Preset> presets;
+    presets.push_back(makePreset("Vocal Plate", 30.0f, 1.5f, 25.0f));
+    presets.push_back(makePreset("Big Hall", 90.0f, 4.0f, 40.0f));
+
+    ASSERT_TRUE(PresetBank::write(bankFile, parameterIds, presets));
+    ASSERT_TRUE(bank.open(bankFile));
+
+    EXPECT_EQ(bank.getNumPresets(), 2);
+    EXPECT_EQ(bank.getParameterIds(), parameterIds);
+
+    // Entries are stored sorted by name
+    EXPECT_EQ(bank.getName(0), "Big Hall");
+    EXPECT_EQ(bank.getName(1), "Vocal Plate");
+
+    PresetBank::Preset loaded;
+    ASSERT_TRUE(bank.getPreset(bank.indexOf("Vocal Plate"), loaded));
+    EXPECT_EQ(loaded.category, "User");
+    ASSERT_EQ(loaded.values.size(), 3u);
+    EXPECT_FLOAT_EQ(loaded.values[0], 30.0f);
+    EXPECT_FLOAT_EQ(loaded.values[1], 1.5f);
+    EXPECT_FLOAT_EQ(loaded.values[2], 25.0f);
+}
+
+// Test lookup by name across a large library
+TEST_F(PresetBankTest, LookupInLargeBank)
+{
+    std::vector<PresetBank::Preset> presets;
+    for (int i = 0; i < 5000; ++i)
+        presets.push_back(makePreset("Preset " + juce::String(i), static_cast<float>(i % 100), 2.0f, 30.0f));
+
+    ASSERT_TRUE(PresetBank::write(bankFile, parameterIds, presets));
+    ASSERT_TRUE(bank.open(bankFile));
+    EXPECT_EQ(bank.getNumPresets(), 5000);
+
+    for (int i = 0; i < 5000; i += 37)
+    {
+        auto name = "Preset " + juce::String(i);
+        int index = bank.indexOf(name);
+        ASSERT_GE(index, 0);
+        EXPECT_EQ(bank.getName(index), name);
+    }
+
+    EXPECT_EQ(bank.indexOf("Missing"), -1);
+    EXPECT_EQ(bank.indexOf("preset 1"), -1); // case sensitive, like file names were
+}
+
+// Test that duplicate names keep the most recently added preset
+TEST_F(PresetBankTest, DuplicateNamesKeepLatest)
+{
+    std::vector<PresetBank::Preset> presets;
+    presets.push_back(makePreset("Room", 10.0f, 1.0f, 20.0f));
+    presets.push_back(makePreset("Room", 60.0f, 2.0f, 30.0f));
+
+    ASSERT_TRUE(PresetBank::write(bankFile, parameterIds, presets));
+    ASSERT_TRUE(bank.open(bankFile));
+    EXPECT_EQ(bank.getNumPresets(), 1);
+
+    PresetBank::Preset loaded;
+    ASSERT_TRUE(bank.getPreset(0, loaded));
+    EXPECT_FLOAT_EQ(loaded.values[0], 60.0f);
+}
+
+// Test that values a preset does not store read back as NaN
+TEST_F(PresetBankTest, MissingValuesAreNaN)
+{
+    PresetBank::Preset partial;
+    partial.name = "Partial";
+    partial.values = { 42.0f };
+
+    ASSERT_TRUE(PresetBank::write(bankFile, parameterIds, { partial }));
+    ASSERT_TRUE(bank.open(bankFile));
+
+    PresetBank::Preset loaded;
+    ASSERT_TRUE(bank.getPreset(0, loaded));
+    EXPECT_FLOAT_EQ(loaded.values[0], 42.0f);
+    EXPECT_TRUE(std::isnan(loaded.values[1]));
+    EXPECT_TRUE(std::isnan(loaded.values[2]));
+}
+
+// Test that an empty bank is valid
+TEST_F(PresetBankTest, EmptyBank)
+{
+    ASSERT_TRUE(PresetBank::write(bankFile, parameterIds, {}));
+    ASSERT_TRUE(bank.open(bankFile));
+
+    EXPECT_EQ(bank.getNumPresets(), 0);
+    EXPECT_EQ(bank.indexOf("Anything"), -1);
+}
+
+// Test that corrupt or foreign files are rejected
+TEST_F(PresetBankTest, RejectsInvalidFiles)
+{
+    bankFile.replaceWithText("<PARAMETERS presetName=\"Not a bank\"/>");
+    EXPECT_FALSE(bank.open(bankFile));
+
+    // Valid bank cut short
+    std::vector<PresetBank::Preset> presets;
+    presets.push_back(makePreset("Room", 10.0f, 1.0f, 20.0f));
+    ASSERT_TRUE(PresetBank::write(bankFile, parameterIds, presets));
+
+    juce::MemoryBlock contents;
+    bankFile.loadFileAsData(contents);
+    bankFile.replaceWithData(contents.getData(), contents.getSize() - 8);
+
+    EXPECT_FALSE(bank.open(bankFile));
+    EXPECT_FALSE(bank.isOpen());
+}
+
+// Test that a lookup in a hash table with no empty slot gives up
+TEST_F(PresetBankTest, LookupInFullHashTableTerminates)
+{
+    std::vector<PresetBank::Preset> presets;
+    presets.push_back(makePreset("Room", 10.0f, 1.0f, 20.0f));
+    ASSERT_TRUE(PresetBank::write(bankFile, parameterIds, presets));
+
+    juce::MemoryBlock contents;
+    bankFile.loadFileAsData(contents);
+    auto* bytes = static_cast<char*>(contents.getData());
+    const auto hashTableSize = juce::ByteOrder::littleEndianInt(bytes + 16);
+    const auto hashTableOffset = juce::ByteOrder::littleEndianInt(bytes + 28);
+
+    // Every slot points at the one entry, as no valid writer would leave it
+    for (juce::uint32 slot = 0; slot < hashTableSize; ++slot)
+    {
+        const auto entry = juce::ByteOrder::swapIfBigEndian(juce::uint32 { 1 });
+        std::memcpy(bytes + hashTableOffset + slot * sizeof(juce::uint32), &entry, sizeof(entry));
+    }
+
+    bankFile.replaceWithData(contents.getData(), contents.getSize());
+    ASSERT_TRUE(bank.open(bankFile));
+
+    EXPECT_EQ(bank.indexOf("Room"), 0);
+    EXPECT_EQ(bank.indexOf("Missing"), -1);
+}
+
+} // namespace Tests
+} // namespace Aura
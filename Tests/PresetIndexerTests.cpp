@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "../Source/Utils/PresetIndexer.h"
+#include "../Source/Utils/PresetBank.h"
+#include <cmath>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class PresetIndexerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile("AuraIndexerTest", "");
+        directory.createDirectory();
+
+        PresetBank::Preset hall;
+        hall.name = "Big Hall";
+        hall.category = "Halls";
+        hall.values = { 2.0f, 90.0f, 4.0f };
+
+        PresetBank::Preset booth;
+        booth.name = "Tight Booth";
+        booth.category = "User";
+        booth.values = { 0.0f, 20.0f, 0.5f };
+
+        PresetBank::write(directory.getChildFile(bankName), { "roomType", "size", "decay" }, { hall, booth });
+    }
+
+    void TearDown() override
+    {
+        directory.deleteRecursively();
+    }
+
+    // Polls the lock-free snapshot until it reaches the wanted size
+    static bool waitForEntries(const PresetIndexer& indexer, size_t count)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            if (indexer.getSnapshot().generation > 0 && indexer.getSnapshot().entries.size() == count)
+                return true;
+
+            juce::Thread::sleep(10);
+        }
+        return false;
+    }
+
+    const juce::String bankName { "UserPresets.aurabank" };
+    juce::File directory;
+};
+
+// Test that the snapshot is usable before the first scan completes
+TEST_F(PresetIndexerTest, EmptyBeforeStart)
+{
+    PresetIndexer indexer(directory, bankName);
+    EXPECT_EQ(indexer.getSnapshot().generation, 0);
+    EXPECT_TRUE(indexer.getSnapshot().entries.empty());
+}
+
+// Test that bank presets are catalogued with their parameter summary
+TEST_F(PresetIndexerTest, IndexesBank)
+{
+    PresetIndexer indexer(directory, bankName);
+    indexer.start();
+
+    ASSERT_TRUE(waitForEntries(indexer, 2));
+
+    const auto& entries = indexer.getSnapshot().entries;
+    EXPECT_EQ(entries[0].name, "Big Hall");
+    EXPECT_EQ(entries[0].category, "Halls");
+    EXPECT_FLOAT_EQ(entries[0].size, 90.0f);
+    EXPECT_FLOAT_EQ(entries[0].decay, 4.0f);
+    EXPECT_TRUE(std::isnan(entries[0].mix));
+    EXPECT_FALSE(entries[0].isLooseFile);
+    EXPECT_EQ(entries[0].parameterIds, juce::StringArray({ "roomType", "size", "decay" }));
+    EXPECT_EQ(entries[0].values, std::vector<float>({ 2.0f, 90.0f, 4.0f }));
+    EXPECT_EQ(entries[1].name, "Tight Booth");
+}
+
+// Test that files added later are picked up without a restart
+TEST_F(PresetIndexerTest, PicksUpNewFiles)
+{
+    PresetIndexer indexer(directory, bankName);
+    indexer.start();
+    ASSERT_TRUE(waitForEntries(indexer, 2));
+
+    directory.getChildFile("Dropped In.xml")
+        .replaceWithText("<PARAMETERS><PARAM id=\"decay\" value=\"3.5\"/></PARAMETERS>");
+    indexer.requestRescan();
+
+    ASSERT_TRUE(waitForEntries(indexer, 3));
+
+    const auto& entries = indexer.getSnapshot().entries;
+    EXPECT_EQ(entries[1].name, "Dropped In");
+    EXPECT_TRUE(entries[1].isLooseFile);
+    EXPECT_FLOAT_EQ(entries[1].decay, 3.5f);
+}
+
+// Test that a file moved into the folder is seen without a rescan request
+TEST_F(PresetIndexerTest, SeesDroppedFile)
+{
+    PresetIndexer indexer(directory, bankName);
+    indexer.start();
+    ASSERT_TRUE(waitForEntries(indexer, 2));
+
+    auto source = juce::File::createTempFile(".xml");
+    source.replaceWithText("<PARAMETERS><PARAM id=\"size\" value=\"64\"/></PARAMETERS>");
+    ASSERT_TRUE(source.moveFileTo(directory.getChildFile("Moved Here.xml")));
+
+    ASSERT_TRUE(waitForEntries(indexer, 3));
+    EXPECT_EQ(indexer.getSnapshot().entries[1].name, "Moved Here");
+    EXPECT_FLOAT_EQ(indexer.getSnapshot().entries[1].size, 64.0f);
+}
+
+// Test that the folder is still watched after being deleted and recreated
+TEST_F(PresetIndexerTest, WatchesRecreatedDirectory)
+{
+    PresetIndexer indexer(directory, bankName);
+    indexer.start();
+    ASSERT_TRUE(waitForEntries(indexer, 2));
+
+    ASSERT_TRUE(directory.deleteRecursively());
+    ASSERT_TRUE(waitForEntries(indexer, 0));
+
+    directory.createDirectory();
+    directory.getChildFile("After.xml")
+        .replaceWithText("<PARAMETERS><PARAM id=\"decay\" value=\"1.5\"/></PARAMETERS>");
+
+    ASSERT_TRUE(waitForEntries(indexer, 1));
+    EXPECT_EQ(indexer.getSnapshot().entries[0].name, "After");
+}
+
+} // namespace Tests
+} // namespace Aura
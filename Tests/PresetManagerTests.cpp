@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include "../Source/Utils/PresetManager.h"
+#include "ParameterHost.h"
+#include <cmath>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class PresetManagerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                        .getNonexistentChildFile("AuraPresetManagerTest", "");
+    }
+
+    void TearDown() override
+    {
+        directory.deleteRecursively();
+    }
+
+    // User presets are listed from the indexer's catalogue, which fills in on its thread
+    static bool waitForUserPresets(const PresetManager& manager, const juce::StringArray& names)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            if (manager.getUserPresetNames() == names)
+                return true;
+
+            juce::Thread::sleep(10);
+        }
+        return false;
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::File directory;
+    ParameterHost hostA;
+    ParameterHost hostB;
+};
+
+// Test that two instances saving one after the other both keep their presets
+TEST_F(PresetManagerTest, InstancesDoNotOverwriteEachOther)
+{
+    PresetManager a(hostA.apvts, directory);
+    PresetManager b(hostB.apvts, directory);
+
+    // Both have catalogued the empty folder before either saves
+    EXPECT_EQ(a.getNumUserPresets(), 0);
+    EXPECT_EQ(b.getNumUserPresets(), 0);
+
+    ASSERT_TRUE(a.savePreset("From A"));
+    ASSERT_TRUE(b.savePreset("From B"));
+
+    PresetManager fresh(hostA.apvts, directory);
+    EXPECT_TRUE(waitForUserPresets(fresh, { "From A", "From B" }));
+    EXPECT_TRUE(waitForUserPresets(a, { "From A", "From B" }));
+}
+
+// Test that a preset saved by another instance loads
+TEST_F(PresetManagerTest, LoadsPresetSavedElsewhere)
+{
+    PresetManager a(hostA.apvts, directory);
+    PresetManager b(hostB.apvts, directory);
+    EXPECT_EQ(b.getNumUserPresets(), 0);
+
+    hostA.setParameter(ParamIDs::decay, 6.5f);
+    ASSERT_TRUE(a.savePreset("Long"));
+
+    b.loadPreset("Long");
+    EXPECT_EQ(b.getCurrentPresetName(), "Long");
+    EXPECT_FLOAT_EQ(hostB.getParameter(ParamIDs::decay), 6.5f);
+}
+
+// Test that the bank can be rewritten while another instance has it open,
+// which on Windows fails if anyone keeps the file mapped
+TEST_F(PresetManagerTest, WritesWhileAnotherInstanceHasBankOpen)
+{
+    PresetManager a(hostA.apvts, directory);
+    PresetManager b(hostB.apvts, directory);
+
+    ASSERT_TRUE(a.savePreset("First"));
+
+    // b's indexer reads the bank in the background
+    ASSERT_TRUE(waitForUserPresets(b, { "First" }));
+
+    EXPECT_TRUE(a.savePreset("Second"));
+    EXPECT_TRUE(a.deletePreset("First"));
+    EXPECT_TRUE(waitForUserPresets(b, { "Second" }));
+}
+
+// Test that a pre-bank XML library is folded into a bank off the message
+// thread, and that its presets load from the catalogue
+TEST_F(PresetManagerTest, BuildsBankFromXmlLibrary)
+{
+    ASSERT_TRUE(directory.createDirectory());
+    directory.getChildFile("Old Hall.xml")
+        .replaceWithText("<PARAMETERS><PARAM id=\"decay\" value=\"5.5\"/></PARAMETERS>");
+
+    PresetManager manager(hostA.apvts, directory);
+    ASSERT_TRUE(waitForUserPresets(manager, { "Old Hall" }));
+
+    // The loose file is catalogued too, so wait for the bank itself
+    for (int i = 0; i < 500 && !manager.getUserBankFile().existsAsFile(); ++i)
+        juce::Thread::sleep(10);
+
+    PresetBank bank;
+    ASSERT_TRUE(bank.open(manager.getUserBankFile()));
+    EXPECT_EQ(bank.getNames(), juce::StringArray({ "Old Hall" }));
+
+    juce::NamedValueSet values;
+    ASSERT_TRUE(manager.getPresetValues("Old Hall", values));
+    EXPECT_FLOAT_EQ(static_cast<float>(values[ParamIDs::decay]), 5.5f);
+
+    manager.loadPreset("Old Hall");
+    EXPECT_FLOAT_EQ(hostA.getParameter(ParamIDs::decay), 5.5f);
+}
+
+// Test that a factory preset's reported and exported values are the ones
+// loading it sets, whatever the state it is loaded over
+TEST_F(PresetManagerTest, FactoryPresetValuesMatchLoad)
+{
+    PresetManager manager(hostA.apvts, directory);
+    ASSERT_TRUE(directory.createDirectory());
+
+    for (const auto& name : manager.getFactoryPresetNames())
+    {
+        // Away from the defaults, including parameters no factory preset lists
+        for (const auto& id : { ParamIDs::modDepth, ParamIDs::lowDecay, ParamIDs::crossoverHigh, ParamIDs::outputGain })
+            hostA.apvts.getParameter(id)->setValueNotifyingHost(0.9f);
+
+        juce::NamedValueSet values;
+        ASSERT_TRUE(manager.getPresetValues(name, values)) << name;
+
+        auto exported = directory.getChildFile("Exported.xml");
+        ASSERT_TRUE(manager.exportPreset(name, exported)) << name;
+        auto xml = juce::XmlDocument::parse(exported);
+        ASSERT_NE(xml, nullptr);
+
+        manager.loadPreset(name);
+
+        for (const auto& value : values)
+        {
+            const auto id = value.name.toString();
+            const auto loaded = hostA.getParameter(id);
+            const auto tolerance = 1.0e-4f * juce::jmax(1.0f, std::abs(loaded));
+
+            EXPECT_NEAR(static_cast<float>(value.value), loaded, tolerance) << name << " " << id;
+
+            auto* param = xml->getChildByAttribute("id", id);
+            ASSERT_NE(param, nullptr) << name << " " << id;
+            EXPECT_NEAR(static_cast<float>(param->getDoubleAttribute("value")), loaded, tolerance) << name << " " << id;
+        }
+    }
+}
+
+// Test that a bank that can't be written is reported
+TEST_F(PresetManagerTest, ReportsFailedWrite)
+{
+    // A file where the presets directory should be
+    ASSERT_TRUE(directory.replaceWithText("not a directory"));
+
+    PresetManager manager(hostA.apvts, directory);
+    EXPECT_FALSE(manager.savePreset("Lost"));
+    EXPECT_NE(manager.getCurrentPresetName(), "Lost");
+}
+
+// Test that presets carry the sound but not the session settings
+TEST_F(PresetManagerTest, PresetsLeaveSessionSettingsAlone)
+{
+    PresetManager a(hostA.apvts, directory);
+    PresetManager b(hostB.apvts, directory);
+
+    hostA.setParameter(ParamIDs::decay, 6.5f);
+    hostA.setParameter(ParamIDs::sendMode, 1.0f);
+    hostA.setParameter(ParamIDs::quality, 1.0f);
+    hostA.setParameter(ParamIDs::morph, 75.0f);
+    ASSERT_TRUE(a.savePreset("Long"));
+
+    hostB.setParameter(ParamIDs::equalPowerMix, 1.0f);
+    hostB.setParameter(ParamIDs::adaptiveQuality, 1.0f);
+    b.loadPreset("Long");
+
+    EXPECT_FLOAT_EQ(hostB.getParameter(ParamIDs::decay), 6.5f);
+    EXPECT_FLOAT_EQ(hostB.getParameter(ParamIDs::sendMode), 0.0f);
+    EXPECT_FLOAT_EQ(hostB.getParameter(ParamIDs::quality), 0.0f);
+    EXPECT_FLOAT_EQ(hostB.getParameter(ParamIDs::morph), 0.0f);
+    EXPECT_FLOAT_EQ(hostB.getParameter(ParamIDs::equalPowerMix), 1.0f);
+    EXPECT_FLOAT_EQ(hostB.getParameter(ParamIDs::adaptiveQuality), 1.0f);
+}
+
+} // namespace Tests
+} // namespace Aura
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "../Source/DSP/PresetMorph.h"
+#include <cmath>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class PresetMorphTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        a.roomType = 0;
+        a.size = 20.0f;
+        a.decay = 0.5f;
+        a.highCut = 4000.0f;
+
+        b.roomType = 2;
+        b.size = 80.0f;
+        b.decay = 4.5f;
+        b.highCut = 12000.0f;
+
+        morph.setTargets(a, 10.0f, b, 50.0f, sampleRate);
+    }
+
+    static constexpr double sampleRate = 48000.0;
+
+    EngineSettings a, b;
+    PresetMorph morph;
+};
+
+// Test that the ends of the morph reproduce the presets exactly
+TEST_F(PresetMorphTest, EndpointsMatchPresets)
+{
+    auto atA = morph.interpolate(0.0f, morph.getRoomTypeA());
+    auto atB = morph.interpolate(1.0f, morph.getRoomTypeB());
+
+    EXPECT_EQ(atA.roomType, 0);
+    EXPECT_FLOAT_EQ(atA.size, a.size);
+    EXPECT_FLOAT_EQ(atA.highCut, a.highCut);
+    EXPECT_FLOAT_EQ(morph.interpolateMix(0.0f), 10.0f);
+
+    EXPECT_EQ(atB.roomType, 2);
+    EXPECT_FLOAT_EQ(atB.size, b.size);
+    EXPECT_FLOAT_EQ(atB.highCut, b.highCut);
+    EXPECT_FLOAT_EQ(morph.interpolateMix(1.0f), 50.0f);
+}
+
+// Test that continuous parameters are interpolated linearly
+TEST_F(PresetMorphTest, InterpolatesContinuousParameters)
+{
+    auto half = morph.interpolate(0.5f, morph.getRoomTypeA());
+
+    EXPECT_FLOAT_EQ(half.size, 50.0f);
+    EXPECT_FLOAT_EQ(half.decay, 2.5f);
+    EXPECT_FLOAT_EQ(half.highCut, 8000.0f);
+    EXPECT_FLOAT_EQ(half.damping, Defaults::damping);
+    EXPECT_FLOAT_EQ(morph.interpolateMix(0.25f), 20.0f);
+}
+
+// Test that only differing room types ask for a second engine
+TEST_F(PresetMorphTest, RoomCrossfadeOnlyWhenRoomsDiffer)
+{
+    EXPECT_TRUE(morph.isActive());
+    EXPECT_TRUE(morph.needsRoomCrossfade());
+
+    b.roomType = a.roomType;
+    morph.setTargets(a, 10.0f, b, 50.0f, sampleRate);
+    EXPECT_FALSE(morph.needsRoomCrossfade());
+
+    morph.clear();
+    EXPECT_FALSE(morph.isActive());
+}
+
+// Test that the designs at the ends are the ones applying each preset makes
+TEST_F(PresetMorphTest, DesignEndpointsMatchPresets)
+{
+    auto expectDesign = [](const RoomReverb::Design& actual, const RoomReverb::Design& expected)
+    {
+        EXPECT_FLOAT_EQ(actual.feedback, expected.feedback);
+        for (auto biquad : RoomReverb::Design::biquads)
+            for (size_t i = 0; i < (actual.*biquad).size(); ++i)
+                EXPECT_NEAR((actual.*biquad)[i], (expected.*biquad)[i], 1.0e-6f);
+    };
+
+    expectDesign(morph.interpolateDesign(0.0f, morph.getRoomTypeA()), ReverbEngine::makeDesign(a, sampleRate));
+    expectDesign(morph.interpolateDesign(1.0f, morph.getRoomTypeB()), ReverbEngine::makeDesign(b, sampleRate));
+
+    // Room B's engine starts from preset A's settings in room B
+    auto aInRoomB = a;
+    aInRoomB.roomType = b.roomType;
+    expectDesign(morph.interpolateDesign(0.0f, morph.getRoomTypeB()), ReverbEngine::makeDesign(aInRoomB, sampleRate));
+}
+
+// Test that every point between two stable filter designs is stable
+TEST_F(PresetMorphTest, InterpolatedFiltersStayStable)
+{
+    for (float position = 0.0f; position <= 1.0f; position += 0.05f)
+    {
+        auto design = morph.interpolateDesign(position, morph.getRoomTypeA());
+
+        for (auto biquad : RoomReverb::Design::biquads)
+        {
+            // Poles of 1 + a1 z^-1 + a2 z^-2 lie inside the unit circle
+            const float a1 = (design.*biquad)[4];
+            const float a2 = (design.*biquad)[5];
+            EXPECT_LT(std::abs(a2), 1.0f) << "position " << position;
+            EXPECT_LT(std::abs(a1), 1.0f + a2) << "position " << position;
+        }
+
+        EXPECT_GT(design.feedback, 0.0f);
+        EXPECT_LE(design.feedback, 0.98f);
+    }
+}
+
+// Test that settings built from preset values fall back to defaults
+TEST_F(PresetMorphTest, SettingsFromValues)
+{
+    juce::NamedValueSet values;
+    values.set(ParamIDs::roomType, 3.0f);
+    values.set(ParamIDs::decay, 7.0f);
+
+    auto settings = EngineSettings::fromValues(values);
+
+    EXPECT_EQ(settings.roomType, 3);
+    EXPECT_FLOAT_EQ(settings.decay, 7.0f);
+    EXPECT_FLOAT_EQ(settings.size, Defaults::size);
+    EXPECT_FLOAT_EQ(settings.crossoverHigh, Defaults::crossoverHigh);
+}
+
+} // namespace Tests
+} // namespace Aura
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include "../Source/PluginProcessor.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+//==============================================================================
+// Counts heap allocations made by the test thread while audio is processed
+namespace
+{
+    thread_local bool countAllocations = false;
+    std::atomic<int> allocationCount { 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations)
+        allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace Aura
+{
+namespace Tests
+{
+
+class ProcessorBlockSizeTest : public ::testing::Test
+{
+protected:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int totalSamples = 9600;
+
+    // Renders an impulse followed by noise, split into the given host block sizes
+    // (cycled until the whole signal is done)
+    juce::AudioBuffer<float> render(int announcedBlockSize, const std::vector<int>& blockSizes)
+    {
+        juce::AudioBuffer<float> signal(2, totalSamples);
+        juce::Random random(1234);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < totalSamples; ++i)
+                signal.setSample(ch, i, i == 0 ? 1.0f : random.nextFloat() * 0.2f - 0.1f);
+
+        AuraProcessor processor;
+        // Rendered like an offline bounce, so the CPU governor never steps in
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(sampleRate, announcedBlockSize);
+
+        juce::MidiBuffer midi;
+        size_t next = 0;
+
+        for (int start = 0; start < totalSamples;)
+        {
+            const int numSamples = juce::jmin(blockSizes[next++ % blockSizes.size()], totalSamples - start);
+            juce::AudioBuffer<float> block(signal.getArrayOfWritePointers(), 2, start, numSamples);
+
+            countAllocations = true;
+            processor.processBlock(block, midi);
+            countAllocations = false;
+
+            start += numSamples;
+        }
+
+        return signal;
+    }
+
+    void expectMatchesReference(const juce::AudioBuffer<float>& output)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < totalSamples; ++i)
+            {
+                ASSERT_FLOAT_EQ(output.getSample(ch, i), reference.getSample(ch, i))
+                    << "channel " << ch << ", sample " << i;
+            }
+        }
+    }
+
+    void SetUp() override
+    {
+        reference = render(256, { 256 });
+        allocationCount = 0;
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::AudioBuffer<float> reference;
+};
+
+// Test that blocks far larger than announced in prepareToPlay are processed
+TEST_F(ProcessorBlockSizeTest, LargerThanAnnounced)
+{
+    expectMatchesReference(render(64, { 4096 }));
+    EXPECT_EQ(allocationCount.load(), 0);
+}
+
+// Test odd block sizes that don't line up with the internal sub-blocks
+TEST_F(ProcessorBlockSizeTest, OddBlockSizes)
+{
+    expectMatchesReference(render(256, { 7, 333, 1023, 1, 513 }));
+    EXPECT_EQ(allocationCount.load(), 0);
+}
+
+// Test the degenerate case of a single sample per call
+TEST_F(ProcessorBlockSizeTest, SingleSampleBlocks)
+{
+    expectMatchesReference(render(256, { 1 }));
+    EXPECT_EQ(allocationCount.load(), 0);
+}
+
+// Test a host that changes the block size every call, including empty blocks
+TEST_F(ProcessorBlockSizeTest, VariableBlockSizes)
+{
+    juce::Random random(42);
+    std::vector<int> sizes;
+
+    for (int i = 0; i < 64; ++i)
+        sizes.push_back(random.nextInt(2048));
+
+    expectMatchesReference(render(512, sizes));
+    EXPECT_EQ(allocationCount.load(), 0);
+}
+
+} // namespace Tests
+} // namespace Aura
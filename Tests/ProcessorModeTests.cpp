@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "../Source/PluginProcessor.h"
+#include <cmath>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class ProcessorModeTest : public ::testing::Test
+{
+protected:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int numBlocks = 40;
+
+    static void setParameter(AuraProcessor& processor, const juce::String& id, float value)
+    {
+        auto* param = processor.getAPVTS().getParameter(id);
+        param->setValueNotifyingHost(param->convertTo0to1(value));
+    }
+
+    // Stereo test signal; with mono set, both channels carry the average of the two
+    static juce::AudioBuffer<float> makeSignal(bool mono)
+    {
+        juce::AudioBuffer<float> signal(2, blockSize * numBlocks);
+        juce::Random random(77);
+
+        for (int i = 0; i < signal.getNumSamples(); ++i)
+        {
+            const float left = random.nextFloat() - 0.5f;
+            const float right = random.nextFloat() - 0.5f;
+            signal.setSample(0, i, mono ? (left + right) * 0.5f : left);
+            signal.setSample(1, i, mono ? (left + right) * 0.5f : right);
+        }
+
+        return signal;
+    }
+
+    static void render(AuraProcessor& processor, juce::AudioBuffer<float>& signal)
+    {
+        // Rendered like an offline bounce, so the CPU governor never steps in
+        processor.setNonRealtime(true);
+        processor.prepareToPlay(sampleRate, blockSize);
+        juce::MidiBuffer midi;
+
+        for (int start = 0; start < signal.getNumSamples(); start += blockSize)
+        {
+            juce::AudioBuffer<float> block(signal.getArrayOfWritePointers(), 2, start, blockSize);
+            processor.processBlock(block, midi);
+        }
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInit;
+};
+
+// Test that send mode matches a fully wet insert fed with the mono sum
+TEST_F(ProcessorModeTest, SendModeMatchesFullyWetInsert)
+{
+    AuraProcessor insert;
+    setParameter(insert, ParamIDs::mix, 100.0f);
+    auto expected = makeSignal(true);
+    render(insert, expected);
+
+    AuraProcessor send;
+    setParameter(send, ParamIDs::sendMode, 1.0f);
+    setParameter(send, ParamIDs::mix, 30.0f);   // ignored in send mode
+    auto actual = makeSignal(false);
+    render(send, actual);
+
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < actual.getNumSamples(); ++i)
+            ASSERT_NEAR(actual.getSample(ch, i), expected.getSample(ch, i), 1.0e-6f)
+                << "channel " << ch << ", sample " << i;
+}
+
+// Test that the output gain still applies in send mode
+TEST_F(ProcessorModeTest, SendModeAppliesOutputGain)
+{
+    AuraProcessor unity;
+    setParameter(unity, ParamIDs::sendMode, 1.0f);
+    auto reference = makeSignal(false);
+    render(unity, reference);
+
+    AuraProcessor attenuated;
+    setParameter(attenuated, ParamIDs::sendMode, 1.0f);
+    setParameter(attenuated, ParamIDs::outputGain, -6.0f);
+    auto actual = makeSignal(false);
+    render(attenuated, actual);
+
+    const float gain = juce::Decibels::decibelsToGain(-6.0f);
+    for (int i = 0; i < actual.getNumSamples(); ++i)
+        ASSERT_NEAR(actual.getSample(0, i), reference.getSample(0, i) * gain, 1.0e-6f) << "sample " << i;
+}
+
+// Test that a mono source into a stereo output is an accepted layout
+TEST_F(ProcessorModeTest, SupportsMonoToStereo)
+{
+    AuraProcessor processor;
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(juce::AudioChannelSet::mono());
+    layout.outputBuses.add(juce::AudioChannelSet::stereo());
+    EXPECT_TRUE(processor.setBusesLayout(layout));
+    EXPECT_EQ(processor.getTotalNumInputChannels(), 1);
+    EXPECT_EQ(processor.getTotalNumOutputChannels(), 2);
+
+    layout.inputBuses.getReference(0) = juce::AudioChannelSet::stereo();
+    layout.outputBuses.getReference(0) = juce::AudioChannelSet::mono();
+    EXPECT_FALSE(processor.checkBusesLayoutSupported(layout));
+}
+
+// Test that the mono input path sounds like a stereo input carrying the same signal
+TEST_F(ProcessorModeTest, MonoInputMatchesDuplicatedStereo)
+{
+    AuraProcessor stereo;
+    auto expected = makeSignal(true);
+    render(stereo, expected);
+
+    AuraProcessor mono;
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(juce::AudioChannelSet::mono());
+    layout.outputBuses.add(juce::AudioChannelSet::stereo());
+    ASSERT_TRUE(mono.setBusesLayout(layout));
+
+    // The host only fills the first channel; the second holds whatever was there
+    auto actual = makeSignal(true);
+    juce::Random random(5);
+    for (int i = 0; i < actual.getNumSamples(); ++i)
+        actual.setSample(1, i, random.nextFloat());
+
+    render(mono, actual);
+
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < actual.getNumSamples(); ++i)
+            ASSERT_NEAR(actual.getSample(ch, i), expected.getSample(ch, i), 1.0e-6f)
+                << "channel " << ch << ", sample " << i;
+}
+
+// Test that bypass lets the tail ring out, then sleeps and passes the input through untouched
+TEST_F(ProcessorModeTest, BypassRingsOutThenSleeps)
+{
+    AuraProcessor processor;
+    ASSERT_EQ(processor.getBypassParameter(), processor.getAPVTS().getParameter(ParamIDs::bypass));
+
+    setParameter(processor, ParamIDs::decay, 0.1f);
+    processor.setNonRealtime(true);
+    processor.prepareToPlay(sampleRate, blockSize);
+
+    juce::MidiBuffer midi;
+    juce::Random random(3);
+    const int bypassBlock = 20;
+    double tailEnergy = 0.0;
+
+    for (int n = 0; n < static_cast<int>(2.0 * sampleRate) / blockSize; ++n)
+    {
+        if (n == bypassBlock)
+            setParameter(processor, ParamIDs::bypass, 1.0f);
+
+        juce::AudioBuffer<float> input(2, blockSize);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < blockSize; ++i)
+                input.setSample(ch, i, random.nextFloat() - 0.5f);
+
+        // Whether this block starts asleep; the block that falls asleep still carries the last of the tail
+        const bool asleep = processor.isAsleep();
+        juce::AudioBuffer<float> block(input);
+        processor.processBlock(block, midi);
+
+        // Well past the ramp, the tail is still audible on top of the input
+        if (n >= bypassBlock + 8 && n < bypassBlock + 12)
+            for (int i = 0; i < blockSize; ++i)
+                tailEnergy += std::abs(block.getSample(0, i) - input.getSample(0, i));
+
+        if (asleep)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    ASSERT_EQ(block.getSample(ch, i), input.getSample(ch, i)) << "block " << n;
+        }
+    }
+
+    EXPECT_GT(tailEnergy, 0.01);
+    EXPECT_TRUE(processor.isAsleep());
+}
+
+// Test that leaving bypass fades the reverb back in without a jump
+TEST_F(ProcessorModeTest, UnbypassFadesIn)
+{
+    AuraProcessor processor;
+    setParameter(processor, ParamIDs::bypass, 1.0f);
+    processor.setNonRealtime(true);
+    processor.prepareToPlay(sampleRate, blockSize);
+    EXPECT_TRUE(processor.isAsleep());
+
+    juce::MidiBuffer midi;
+    float previous = 0.5f;
+    float largestStep = 0.0f;
+
+    for (int n = 0; n < numBlocks; ++n)
+    {
+        if (n == 4)
+            setParameter(processor, ParamIDs::bypass, 0.0f);
+
+        juce::AudioBuffer<float> block(2, blockSize);
+        for (int ch = 0; ch < 2; ++ch)
+            juce::FloatVectorOperations::fill(block.getWritePointer(ch), 0.5f, blockSize);
+
+        processor.processBlock(block, midi);
+
+        for (int i = 0; i < blockSize; ++i)
+        {
+            largestStep = juce::jmax(largestStep, std::abs(block.getSample(0, i) - previous));
+            previous = block.getSample(0, i);
+        }
+    }
+
+    EXPECT_FALSE(processor.isAsleep());
+    EXPECT_LT(largestStep, 0.05f);
+}
+
+// Test that a room morph at position 0 sounds exactly like preset A
+TEST_F(ProcessorModeTest, RoomMorphAtStartMatchesPresetA)
+{
+    AuraProcessor plain;
+    plain.getPresetManager().loadPreset("Vocal Booth");
+    auto expected = makeSignal(false);
+    render(plain, expected);
+
+    // Booth and Hall differ in room type, so the spare engine runs room B
+    AuraProcessor morphing;
+    ASSERT_TRUE(morphing.setMorphPresets("Vocal Booth", "Concert Hall"));
+    setParameter(morphing, ParamIDs::morph, 0.0f);
+    auto actual = makeSignal(false);
+    render(morphing, actual);
+
+    EXPECT_TRUE(morphing.isMorphingRooms());
+
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < actual.getNumSamples(); ++i)
+            ASSERT_NEAR(actual.getSample(ch, i), expected.getSample(ch, i), 1.0e-6f)
+                << "channel " << ch << ", sample " << i;
+}
+
+// Test that the morph pair is saved with the session and runs again once restored
+TEST_F(ProcessorModeTest, MorphPresetsSurviveStateRoundTrip)
+{
+    AuraProcessor source;
+    ASSERT_TRUE(source.setMorphPresets("Vocal Booth", "Concert Hall"));
+    setParameter(source, ParamIDs::morph, 50.0f);
+
+    juce::MemoryBlock state;
+    source.getStateInformation(state);
+
+    AuraProcessor restored;
+    restored.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    EXPECT_EQ(restored.getMorphPresetA(), "Vocal Booth");
+    EXPECT_EQ(restored.getMorphPresetB(), "Concert Hall");
+
+    auto signal = makeSignal(false);
+    render(restored, signal);
+    EXPECT_TRUE(restored.isMorphingRooms());
+
+    // A session saved without a morph ends the restored one
+    source.clearMorphPresets();
+    source.getStateInformation(state);
+    restored.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+    EXPECT_TRUE(restored.getMorphPresetA().isEmpty());
+    EXPECT_TRUE(restored.getMorphPresetB().isEmpty());
+}
+
+// Test that the audio thread holds the spare engine until it sees the morph end
+TEST_F(ProcessorModeTest, ClearedMorphHandsBackSpare)
+{
+    AuraProcessor processor;
+    ASSERT_TRUE(processor.setMorphPresets("Vocal Booth", "Concert Hall"));
+    setParameter(processor, ParamIDs::morph, 50.0f);
+
+    auto signal = makeSignal(false);
+    render(processor, signal);
+    ASSERT_TRUE(processor.isMorphingRooms());
+
+    // Without a callback to release it, a preset load gives up on the
+    // crossfade instead of preparing an engine that is still running
+    processor.clearMorphPresets();
+    processor.getPresetManager().loadPreset("Cathedral");
+    EXPECT_TRUE(processor.isMorphingRooms());
+
+    juce::MidiBuffer midi;
+    juce::AudioBuffer<float> block(signal.getArrayOfWritePointers(), 2, 0, blockSize);
+    processor.processBlock(block, midi);
+    EXPECT_FALSE(processor.isMorphingRooms());
+
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < blockSize; ++i)
+            ASSERT_TRUE(std::isfinite(block.getSample(ch, i)));
+}
+
+} // namespace Tests
+} // namespace Aura
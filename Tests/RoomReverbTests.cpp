@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include "../Source/DSP/RoomReverb.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 namespace Aura
 {
@@ -270,5 +273,365 @@ TEST_F(RoomReverbTest, NoClippingWithReasonableInput)
     EXPECT_LT(maxLevel, 1.5f);
 }
 
+// Test the planned delay line lengths against hand-computed values
+TEST_F(RoomReverbTest, DelayCapacityPlan)
+{
+    // Longest right comb: (38.6 + 0.5) ms * 1.5 at size 1, plus 10 samples of
+    // modulation and the interpolation tap
+    EXPECT_EQ(RoomReverb::getCombCapacity(1, RoomReverb::NumComb - 1, 44100.0), 2586 + 12);
+    EXPECT_EQ(RoomReverb::getCombCapacity(1, RoomReverb::NumComb - 1, 192000.0), 11260 + 12);
+
+    // 200 ms of pre-delay, inclusive
+    EXPECT_EQ(RoomReverb::getPreDelayCapacity(44100.0), 8821);
+    EXPECT_EQ(RoomReverb::getAllpassCapacity(0, 0, 48000.0), 241);
+
+    // Last ER tap: 121 ms * 1.7 at size 1, plus the block written ahead of it
+    EXPECT_EQ(EarlyReflections::getDelayCapacity(44100.0, 512), 9071 + 512);
+}
+
+// Test that the largest size gets the delay it asks for instead of a clamped one
+TEST_F(RoomReverbTest, MaxSizeIsNotClamped)
+{
+    reverb.setSize(1.0f);
+
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < RoomReverb::NumComb; ++i)
+            EXPECT_EQ(reverb.getCurrentCombDelay(ch, i), RoomReverb::getCombDelay(ch, i, 1.0f, 44100.0));
+}
+
+// Test that exactly the planned memory is allocated, and that it scales with the rate
+TEST_F(RoomReverbTest, MemoryFootprintMatchesPlan)
+{
+    for (double sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        reverb.prepare(sampleRate, 512);
+
+        size_t expected = 2 * static_cast<size_t>(RoomReverb::getPreDelayCapacity(sampleRate));
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < RoomReverb::NumComb; ++i)
+                expected += static_cast<size_t>(RoomReverb::getCombCapacity(ch, i, sampleRate));
+            for (int i = 0; i < RoomReverb::NumAllpass; ++i)
+                expected += static_cast<size_t>(RoomReverb::getAllpassCapacity(ch, i, sampleRate));
+        }
+
+        // Input diffuser: 4.77 + 3.60 + 12.73 + 9.31 ms, interleaved stereo
+        for (float ms : { 4.77f, 3.60f, 12.73f, 9.31f })
+            expected += 2 * static_cast<size_t>(ms * sampleRate / 1000.0);
+
+        EXPECT_EQ(reverb.getMemoryFootprint(), expected * sizeof(float)) << sampleRate;
+    }
+
+    // Going back down releases the memory again
+    reverb.prepare(192000.0, 512);
+    const auto high = reverb.getMemoryFootprint();
+    reverb.prepare(48000.0, 512);
+    EXPECT_NEAR(static_cast<double>(high) / static_cast<double>(reverb.getMemoryFootprint()), 4.0, 0.05);
+}
+
+// Test that half precision storage halves the comb and pre-delay memory
+TEST_F(RoomReverbTest, HalfPrecisionHalvesDelayMemory)
+{
+    constexpr double sampleRate = 192000.0;
+
+    size_t delayBytes = 2 * static_cast<size_t>(RoomReverb::getPreDelayCapacity(sampleRate));
+    for (int ch = 0; ch < 2; ++ch)
+        for (int i = 0; i < RoomReverb::NumComb; ++i)
+            delayBytes += static_cast<size_t>(RoomReverb::getCombCapacity(ch, i, sampleRate));
+    delayBytes *= sizeof(float);
+
+    reverb.prepare(sampleRate, 512);
+    const auto full = reverb.getMemoryFootprint();
+
+    reverb.setDelayPrecision(DelayPrecision::Half);
+    reverb.prepare(sampleRate, 512);
+    EXPECT_EQ(reverb.getMemoryFootprint(), full - delayBytes / 2);
+
+    // And back again
+    reverb.setDelayPrecision(DelayPrecision::Full);
+    reverb.prepare(sampleRate, 512);
+    EXPECT_EQ(reverb.getMemoryFootprint(), full);
+}
+
+// Measures the noise half precision storage adds to a long tail against the
+// full precision render, and what is left once the input stops
+TEST_F(RoomReverbTest, HalfPrecisionNoiseFloor)
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int burstBlocks = 40;                                     // ~0.4 s of noise
+    constexpr int tailBlocks = static_cast<int>(3.0 * sampleRate / blockSize);
+    constexpr int silenceBlocks = static_cast<int>(20.0 * sampleRate / blockSize);
+
+    RoomReverb full, half;
+    half.setDelayPrecision(DelayPrecision::Half);
+
+    for (auto* r : { &full, &half })
+    {
+        r->prepare(sampleRate, blockSize);
+        r->setSize(0.8f);
+        r->setDecay(8.0f);
+        r->setDamping(0.3f);
+    }
+
+    juce::Random random(21);
+    juce::AudioBuffer<float> a(2, blockSize), b(2, blockSize);
+    double signalEnergy = 0.0, errorEnergy = 0.0;
+
+    for (int block = 0; block < burstBlocks + tailBlocks; ++block)
+    {
+        a.clear();
+        if (block < burstBlocks)
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    a.setSample(ch, i, random.nextFloat() - 0.5f);
+        b.makeCopyOf(a, true);
+
+        full.process(a);
+        half.process(b);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int i = 0; i < blockSize; ++i)
+            {
+                const double reference = a.getSample(ch, i);
+                const double error = b.getSample(ch, i) - reference;
+                signalEnergy += reference * reference;
+                errorEnergy += error * error;
+            }
+        }
+    }
+
+    const double snr = 10.0 * std::log10(signalEnergy / juce::jmax(errorEnergy, 1.0e-30));
+    RecordProperty("HalfPrecisionSnrDb", std::to_string(snr));
+    EXPECT_GT(snr, 60.0);
+
+    // Rounding in the feedback loops may leave a small limit cycle, but it
+    // has to stay far below anything audible
+    float residual = 0.0f;
+    for (int block = 0; block < silenceBlocks; ++block)
+    {
+        b.clear();
+        half.process(b);
+
+        if (block >= silenceBlocks - 100)
+            for (int ch = 0; ch < 2; ++ch)
+                residual = juce::jmax(residual, b.getMagnitude(ch, 0, blockSize));
+    }
+
+    RecordProperty("HalfPrecisionResidualDb", std::to_string(juce::Decibels::gainToDecibels(residual, -200.0f)));
+    EXPECT_LT(juce::Decibels::gainToDecibels(residual, -200.0f), -90.0f);
+}
+
+// Test that without modulation the tail reads exactly the taps a zero-depth
+// modulated tail reads
+TEST_F(RoomReverbTest, NoModulationMatchesZeroDepth)
+{
+    RoomReverb unmodulated;
+    unmodulated.prepare(44100.0, 512);
+    unmodulated.setProcessingLevel(RoomReverb::ProcessingLevel::NoModulation);
+
+    reverb.setModulationDepth(0.0f);
+    unmodulated.setModulationDepth(0.0f);
+
+    juce::Random random(3);
+    juce::AudioBuffer<float> expected(2, 512), actual(2, 512);
+
+    for (int block = 0; block < 40; ++block)
+    {
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 512; ++i)
+                expected.setSample(ch, i, block < 10 ? random.nextFloat() - 0.5f : 0.0f);
+        actual.makeCopyOf(expected, true);
+
+        reverb.process(expected);
+        unmodulated.process(actual);
+
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < 512; ++i)
+                ASSERT_EQ(actual.getSample(ch, i), expected.getSample(ch, i)) << "block " << block << ", sample " << i;
+    }
+}
+
+// Test that the reduced levels keep the loudness of the full tail, and that
+// switching level ramps instead of jumping
+TEST_F(RoomReverbTest, ProcessingLevelsAreRamped)
+{
+    constexpr int blockSize = 512;
+    constexpr int numBlocks = 200;
+    constexpr int switchBlock = 100;
+    constexpr int rampSamples = 44;   // 1 ms
+
+    auto render = [](RoomReverb::ProcessingLevel level)
+    {
+        RoomReverb r;
+        r.prepare(44100.0, blockSize);
+        r.setDecay(3.0f);
+
+        juce::Random random(8);
+        juce::AudioBuffer<float> output(2, blockSize * numBlocks);
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            if (block == switchBlock)
+                r.setProcessingLevel(level);
+
+            juce::AudioBuffer<float> slice(output.getArrayOfWritePointers(), 2, block * blockSize, blockSize);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    slice.setSample(ch, i, random.nextFloat() - 0.5f);
+            r.process(slice);
+        }
+
+        return output;
+    };
+
+    const auto full = render(RoomReverb::ProcessingLevel::Full);
+    const int switchSample = switchBlock * blockSize;
+    const int steadyStart = switchSample + blockSize * 20;
+    const int steadyLength = full.getNumSamples() - steadyStart;
+    const float fullRms = full.getRMSLevel(0, steadyStart, steadyLength);
+    const float peak = full.getMagnitude(0, 0, full.getNumSamples());
+
+    for (auto level : { RoomReverb::ProcessingLevel::NoModulation,
+                        RoomReverb::ProcessingLevel::FewerLines,
+                        RoomReverb::ProcessingLevel::MinimalLines })
+    {
+        const auto reduced = render(level);
+
+        // Identical up to the switch, then drifting away only gradually
+        for (int i = 0; i < switchSample; ++i)
+            ASSERT_EQ(reduced.getSample(0, i), full.getSample(0, i)) << "sample " << i;
+
+        for (int i = switchSample; i < switchSample + rampSamples; ++i)
+            ASSERT_NEAR(reduced.getSample(0, i), full.getSample(0, i), 0.1f * peak)
+                << "level " << static_cast<int>(level) << ", sample " << i;
+
+        const float ratioDb = juce::Decibels::gainToDecibels(reduced.getRMSLevel(0, steadyStart, steadyLength) / fullRms);
+        EXPECT_NEAR(ratioDb, 0.0f, 3.0f) << "level " << static_cast<int>(level);
+    }
+}
+
+// Test that a tail decaying into silence never turns subnormal or slows down,
+// without the FTZ/DAZ flags a host would normally set
+TEST_F(RoomReverbTest, SilentTailStaysOutOfSubnormals)
+{
+    reverb.setDecay(0.5f);
+
+    juce::AudioBuffer<float> buffer(2, 512);
+    buffer.clear();
+    buffer.setSample(0, 0, 1.0f);
+    buffer.setSample(1, 0, 1.0f);
+    reverb.process(buffer);
+
+    // Long enough for an undamped loop state to fall well below 1e-38
+    const int numBlocks = static_cast<int>(15.0 * 44100.0 / 512.0);
+    std::vector<double> blockSeconds;
+    int subnormals = 0;
+
+    for (int b = 0; b < numBlocks; ++b)
+    {
+        buffer.clear();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        reverb.process(buffer);
+        blockSeconds.push_back(juce::Time::highResolutionTicksToSeconds(
+            juce::Time::getHighResolutionTicks() - start));
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                if (std::fpclassify(buffer.getSample(ch, i)) == FP_SUBNORMAL)
+                    ++subnormals;
+    }
+
+    EXPECT_EQ(subnormals, 0);
+    EXPECT_LT(std::abs(reverb.getDecayEnvelope()), 0.0001f);
+
+    // Median per-sample cost at the start of the tail against the end of it
+    auto medianNanosPerSample = [&blockSeconds](size_t first, size_t count)
+    {
+        std::vector<double> times(blockSeconds.begin() + static_cast<std::ptrdiff_t>(first),
+                                  blockSeconds.begin() + static_cast<std::ptrdiff_t>(first + count));
+        std::nth_element(times.begin(), times.begin() + static_cast<std::ptrdiff_t>(count / 2), times.end());
+        return times[count / 2] * 1.0e9 / 512.0;
+    };
+
+    const size_t window = 100;
+    const double early = medianNanosPerSample(0, window);
+    const double late = medianNanosPerSample(blockSeconds.size() - window, window);
+
+    RecordProperty("EarlyTailNsPerSample", std::to_string(early));
+    RecordProperty("LateTailNsPerSample", std::to_string(late));
+    EXPECT_LT(late, early * 3.0);
+}
+
+// Test that a NaN reaching the tail is contained: the block is muted, the
+// output fades back in, and the tail never turns non-finite again
+TEST_F(RoomReverbTest, RecoversFromNonFiniteInput)
+{
+    for (auto precision : { DelayPrecision::Full, DelayPrecision::Half })
+    {
+        RoomReverb guarded;
+        guarded.setDelayPrecision(precision);
+        guarded.prepare(44100.0, 512);
+        guarded.setDecay(10.0f);
+
+        juce::Random random(9);
+        juce::AudioBuffer<float> buffer(2, 512);
+
+        auto fillNoise = [&]()
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 512; ++i)
+                    buffer.setSample(ch, i, random.nextFloat() * 0.5f - 0.25f);
+        };
+
+        for (int block = 0; block < 20; ++block)
+        {
+            fillNoise();
+            guarded.process(buffer);
+        }
+        ASSERT_EQ(guarded.getNumRecoveries(), 0);
+
+        fillNoise();
+        buffer.setSample(0, 100, std::numeric_limits<float>::quiet_NaN());
+        buffer.setSample(1, 200, std::numeric_limits<float>::infinity());
+
+        // Caught once the combs read it back, within their longest delay,
+        // and that block is muted
+        for (int block = 0; block < 10 && guarded.getNumRecoveries() == 0; ++block)
+        {
+            guarded.process(buffer);
+            if (guarded.getNumRecoveries() == 0)
+                fillNoise();
+        }
+
+        ASSERT_EQ(guarded.getNumRecoveries(), 1);
+        EXPECT_EQ(buffer.getMagnitude(0, 512), 0.0f);
+
+        // The next block starts from silence and ramps up
+        fillNoise();
+        guarded.process(buffer);
+        EXPECT_LT(std::abs(buffer.getSample(0, 0)), 0.01f);
+
+        // Long enough for every comb to have recirculated many times
+        float peak = 0.0f;
+        for (int block = 0; block < 200; ++block)
+        {
+            fillNoise();
+            guarded.process(buffer);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 512; ++i)
+                    ASSERT_TRUE(std::isfinite(buffer.getSample(ch, i))) << "block " << block;
+
+            peak = juce::jmax(peak, buffer.getMagnitude(0, 512));
+        }
+
+        EXPECT_EQ(guarded.getNumRecoveries(), 1);
+        EXPECT_GT(peak, 0.01f);
+    }
+}
+
 } // namespace Tests
 } // namespace Aura
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "../Source/Utils/StateSerializer.h"
+#include "ParameterHost.h"
+
+namespace Aura
+{
+namespace Tests
+{
+
+class StateSerializerTest : public ::testing::Test
+{
+protected:
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    ParameterHost source;
+    ParameterHost target;
+};
+
+// Test that every parameter survives a binary round trip
+TEST_F(StateSerializerTest, RoundTrip)
+{
+    source.setParameter(ParamIDs::roomType, 4.0f);
+    source.setParameter(ParamIDs::size, 73.0f);
+    source.setParameter(ParamIDs::decay, 6.5f);
+    source.setParameter(ParamIDs::mix, 42.0f);
+    source.setParameter(ParamIDs::highCut, 9000.0f);
+
+    juce::MemoryBlock state;
+    StateSerializer(source.apvts).save(state);
+
+    EXPECT_TRUE(StateSerializer::isBinaryState(state.getData(), static_cast<int>(state.getSize())));
+    ASSERT_TRUE(StateSerializer(target.apvts).load(state.getData(), static_cast<int>(state.getSize())));
+
+    for (const auto& id : ParamIDs::stateOrder)
+        EXPECT_FLOAT_EQ(target.getParameter(id), source.getParameter(id)) << id;
+}
+
+// Test that the binary state is a fraction of the XML one
+TEST_F(StateSerializerTest, SmallerThanXml)
+{
+    juce::MemoryBlock binary;
+    StateSerializer(source.apvts).save(binary);
+
+    juce::MemoryBlock xml;
+    juce::AudioProcessor::copyXmlToBinary(*source.apvts.copyState().createXml(), xml);
+
+    EXPECT_LT(binary.getSize() * 4, xml.getSize());
+}
+
+// Test that states saved by older versions still load
+TEST_F(StateSerializerTest, LoadsLegacyXml)
+{
+    source.setParameter(ParamIDs::decay, 3.25f);
+    source.setParameter(ParamIDs::width, 55.0f);
+
+    juce::MemoryBlock xml;
+    juce::AudioProcessor::copyXmlToBinary(*source.apvts.copyState().createXml(), xml);
+
+    EXPECT_FALSE(StateSerializer::isBinaryState(xml.getData(), static_cast<int>(xml.getSize())));
+    ASSERT_TRUE(StateSerializer(target.apvts).load(xml.getData(), static_cast<int>(xml.getSize())));
+
+    EXPECT_FLOAT_EQ(target.getParameter(ParamIDs::decay), 3.25f);
+    EXPECT_FLOAT_EQ(target.getParameter(ParamIDs::width), 55.0f);
+}
+
+// Test that non-parameter properties of the state are kept
+TEST_F(StateSerializerTest, KeepsStateProperties)
+{
+    source.apvts.state.setProperty("editorScale", 1.5, nullptr);
+
+    juce::MemoryBlock state;
+    StateSerializer(source.apvts).save(state);
+    StateSerializer(target.apvts).load(state.getData(), static_cast<int>(state.getSize()));
+
+    EXPECT_DOUBLE_EQ(static_cast<double>(target.apvts.state["editorScale"]), 1.5);
+}
+
+// Test that properties missing from a loaded state are removed, not kept
+TEST_F(StateSerializerTest, ReplacesStateProperties)
+{
+    target.apvts.state.setProperty("morphPresetA", "Vocal Booth", nullptr);
+    target.apvts.state.setProperty("morphPresetB", "Cathedral", nullptr);
+    source.apvts.state.setProperty("editorScale", 1.5, nullptr);
+
+    juce::MemoryBlock state;
+    StateSerializer(source.apvts).save(state);
+    ASSERT_TRUE(StateSerializer(target.apvts).load(state.getData(), static_cast<int>(state.getSize())));
+
+    EXPECT_FALSE(target.apvts.state.hasProperty("morphPresetA"));
+    EXPECT_FALSE(target.apvts.state.hasProperty("morphPresetB"));
+    EXPECT_DOUBLE_EQ(static_cast<double>(target.apvts.state["editorScale"]), 1.5);
+
+    // A state with no properties at all clears them too
+    ParameterHost blank;
+    juce::MemoryBlock empty;
+    StateSerializer(blank.apvts).save(empty);
+    ASSERT_TRUE(StateSerializer(target.apvts).load(empty.getData(), static_cast<int>(empty.getSize())));
+    EXPECT_EQ(target.apvts.state.getNumProperties(), 0);
+}
+
+// Test that garbage and truncated data are rejected without touching the state
+TEST_F(StateSerializerTest, RejectsInvalidData)
+{
+    const char garbage[] = "not a plugin state";
+    EXPECT_FALSE(StateSerializer(target.apvts).load(garbage, sizeof(garbage)));
+
+    juce::MemoryBlock state;
+    StateSerializer(source.apvts).save(state);
+    EXPECT_FALSE(StateSerializer(target.apvts).load(state.getData(), 12));
+}
+
+} // namespace Tests
+} // namespace Aura
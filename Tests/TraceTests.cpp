@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "../Source/Utils/Trace.h"
+#include <thread>
+
+namespace Aura
+{
+namespace Tests
+{
+
+class TraceTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        file = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                   .getNonexistentChildFile("AuraTraceTest", ".json");
+    }
+
+    void TearDown() override
+    {
+        while (Trace::isRunning())
+            Trace::stop();
+
+        file.deleteFile();
+    }
+
+    juce::Array<juce::var> readEvents() const
+    {
+        const auto parsed = juce::JSON::parse(file);
+        EXPECT_TRUE(parsed.isArray()) << file.loadFileAsString();
+
+        if (const auto* events = parsed.getArray())
+            return *events;
+
+        return {};
+    }
+
+    static juce::Array<juce::var> withName(const juce::Array<juce::var>& events, const juce::String& name)
+    {
+        juce::Array<juce::var> matching;
+        for (const auto& event : events)
+            if (event["name"].toString() == name)
+                matching.add(event);
+        return matching;
+    }
+
+    juce::File file;
+};
+
+TEST_F(TraceTest, RecordsNestedScopesPerThread)
+{
+    ASSERT_TRUE(Trace::start(file));
+
+    {
+        const Trace::Scope outer("outer");
+        const Trace::Scope inner("inner");
+    }
+
+    std::thread worker([]
+    {
+        Trace::setThreadName("Worker");
+        const Trace::Scope scope("work");
+    });
+    worker.join();
+
+    Trace::stop();
+
+    const auto events = readEvents();
+    const auto outer = withName(events, "outer");
+    const auto inner = withName(events, "inner");
+    const auto work = withName(events, "work");
+
+    ASSERT_EQ(outer.size(), 1);
+    ASSERT_EQ(inner.size(), 1);
+    ASSERT_EQ(work.size(), 1);
+
+    // Complete events, with the inner scope inside the outer one
+    EXPECT_EQ(outer[0]["ph"].toString(), "X");
+    EXPECT_GE(static_cast<double>(inner[0]["ts"]), static_cast<double>(outer[0]["ts"]));
+    EXPECT_LE(static_cast<double>(inner[0]["dur"]), static_cast<double>(outer[0]["dur"]));
+    EXPECT_EQ(static_cast<int>(inner[0]["tid"]), static_cast<int>(outer[0]["tid"]));
+
+    // The worker has its own track, under its own name
+    EXPECT_NE(static_cast<int>(work[0]["tid"]), static_cast<int>(outer[0]["tid"]));
+
+    bool named = false;
+    for (const auto& event : withName(events, "thread_name"))
+        named = named || (static_cast<int>(event["tid"]) == static_cast<int>(work[0]["tid"])
+                          && event["args"]["name"].toString() == "Worker");
+    EXPECT_TRUE(named);
+}
+
+TEST_F(TraceTest, NothingIsRecordedOutsideASession)
+{
+    {
+        const Trace::Scope scope("before");
+    }
+
+    ASSERT_TRUE(Trace::start(file));
+    Trace::stop();
+
+    {
+        const Trace::Scope scope("after");
+    }
+
+    const auto events = readEvents();
+    EXPECT_TRUE(withName(events, "before").isEmpty());
+    EXPECT_TRUE(withName(events, "after").isEmpty());
+}
+
+TEST_F(TraceTest, FullRingDropsAndCountsEvents)
+{
+    ASSERT_TRUE(Trace::start(file));
+
+    constexpr int numEvents = Trace::eventsPerThread * 2;
+
+    // A fresh thread starts with an empty ring, and fills it long before
+    // the writer's first flush
+    std::thread burst([]
+    {
+        for (int i = 0; i < numEvents; ++i)
+            Trace::record("burst", Trace::now(), Trace::now());
+    });
+    burst.join();
+
+    const int dropped = Trace::getNumDropped();
+    Trace::stop();
+
+    EXPECT_GT(dropped, 0);
+    EXPECT_EQ(withName(readEvents(), "burst").size() + dropped, numEvents);
+}
+
+TEST_F(TraceTest, ExitedThreadsHandBackTheirRings)
+{
+    ASSERT_TRUE(Trace::start(file));
+
+    // Far more threads than rings, but never more than one alive at a time
+    constexpr int numThreads = Trace::maxThreads * 4;
+
+    for (int i = 0; i < numThreads; ++i)
+    {
+        std::thread shortLived([] { const Trace::Scope scope("short"); });
+        shortLived.join();
+    }
+
+    const int dropped = Trace::getNumDropped();
+    Trace::stop();
+
+    EXPECT_EQ(dropped, 0);
+    EXPECT_EQ(withName(readEvents(), "short").size(), numThreads);
+}
+
+TEST_F(TraceTest, SessionsAreShared)
+{
+    ASSERT_TRUE(Trace::start(file));
+    ASSERT_TRUE(Trace::start(file));
+
+    Trace::stop();
+    EXPECT_TRUE(Trace::isRunning());
+
+    Trace::stop();
+    EXPECT_FALSE(Trace::isRunning());
+}
+
+} // namespace Tests
+} // namespace Aura